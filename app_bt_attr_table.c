@@ -0,0 +1,216 @@
+/******************************************************************************
+* File Name:   app_bt_attr_table.c
+*
+* Description: This file contains the handle indexed lookup of the GATT
+*              attributes held by the application and the per-handle write
+*              handlers.
+*
+* Related Document: See README.md
+*
+********************************************************************************
+* Copyright 2021-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/******************************************************************************
+ *                                INCLUDES
+ ******************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include "cy_utils.h"
+#include "app_bt_attr_table.h"
+
+/******************************************************************************
+ *                                Constants
+ ******************************************************************************/
+/* Index value of a handle without an entry in app_gatt_db_ext_attr_tbl */
+#define APP_BT_ATTR_NO_ENTRY                    (0xFFFFu)
+
+/******************************************************************************
+ *                                Variable Definitions
+ ******************************************************************************/
+/* Index into app_gatt_db_ext_attr_tbl, by attribute handle */
+static uint16_t *attr_index;
+static uint16_t attr_max_handle;
+
+/* Write handling of each app_gatt_db_ext_attr_tbl entry */
+static app_bt_attr_write_t *attr_write;
+
+/****************************************************************************
+ *                              FUNCTION DEFINITIONS
+ ***************************************************************************/
+
+/**
+ * Function Name:
+ * app_bt_attr_table_init
+ *
+ * Function Description:
+ * @brief  Builds the handle index of app_gatt_db_ext_attr_tbl. The index is
+ *         sized by the largest handle in the table, so the memory used grows
+ *         with the GATT database and the lookup cost does not.
+ *
+ * @param void
+ *
+ * @return void
+ */
+void app_bt_attr_table_init(void)
+{
+    uint16_t i;
+
+    if (NULL != attr_index)
+    {
+        return;
+    }
+
+    attr_max_handle = 0;
+    for (i = 0; i < app_gatt_db_ext_attr_tbl_size; i++)
+    {
+        if (app_gatt_db_ext_attr_tbl[i].handle > attr_max_handle)
+        {
+            attr_max_handle = app_gatt_db_ext_attr_tbl[i].handle;
+        }
+    }
+
+    attr_index = (uint16_t *)malloc(((uint32_t)attr_max_handle + 1u) * sizeof(uint16_t));
+    attr_write = (app_bt_attr_write_t *)calloc(app_gatt_db_ext_attr_tbl_size,
+                                               sizeof(app_bt_attr_write_t));
+    if ((NULL == attr_index) || (NULL == attr_write))
+    {
+        printf("Attribute table allocation failed\n");
+        CY_ASSERT(0);
+        return;
+    }
+
+    for (i = 0; i <= attr_max_handle; i++)
+    {
+        attr_index[i] = APP_BT_ATTR_NO_ENTRY;
+    }
+    for (i = 0; i < app_gatt_db_ext_attr_tbl_size; i++)
+    {
+        attr_index[app_gatt_db_ext_attr_tbl[i].handle] = i;
+    }
+}
+
+/**
+ * Function Name:
+ * app_bt_attr_index
+ *
+ * Function Description:
+ * @brief  Returns the app_gatt_db_ext_attr_tbl index of a handle
+ *
+ * @param handle    handle to look up
+ *
+ * @return uint16_t  table index, APP_BT_ATTR_NO_ENTRY if not found
+ */
+static uint16_t app_bt_attr_index(uint16_t handle)
+{
+    if ((NULL == attr_index) || (handle > attr_max_handle))
+    {
+        return APP_BT_ATTR_NO_ENTRY;
+    }
+    return attr_index[handle];
+}
+
+/**
+ * Function Name:
+ * app_bt_attr_find
+ *
+ * Function Description:
+ * @brief  Find attribute description by handle
+ *
+ * @param handle    handle to look up
+ *
+ * @return gatt_db_lookup_table_t   pointer containing handle data, NULL if not found
+ */
+gatt_db_lookup_table_t *app_bt_attr_find(uint16_t handle)
+{
+    uint16_t index = app_bt_attr_index(handle);
+
+    if (APP_BT_ATTR_NO_ENTRY == index)
+    {
+        return NULL;
+    }
+    return &app_gatt_db_ext_attr_tbl[index];
+}
+
+/**
+ * Function Name:
+ * app_bt_attr_register_write
+ *
+ * Function Description:
+ * @brief  Registers the handler of the side effects of writes to a handle.
+ *         With APP_BT_ATTR_WRITE_SINK the value is only passed to the
+ *         handler and is not staged in the attribute table. Must be called
+ *         after app_bt_attr_table_init().
+ *
+ * @param handle    attribute handle
+ * @param p_cb      write handler, NULL to remove it
+ * @param flags     APP_BT_ATTR_WRITE_* flags
+ *
+ * @return wiced_result_t  WICED_BADARG if the handle is not in the table
+ */
+wiced_result_t app_bt_attr_register_write(uint16_t handle, app_bt_attr_write_cb_t p_cb, uint8_t flags)
+{
+    uint16_t index = app_bt_attr_index(handle);
+
+    if (APP_BT_ATTR_NO_ENTRY == index)
+    {
+        return WICED_BADARG;
+    }
+    attr_write[index].p_cb = p_cb;
+    attr_write[index].flags = flags;
+    return WICED_SUCCESS;
+}
+
+/**
+ * Function Name:
+ * app_bt_attr_get_write
+ *
+ * Function Description:
+ * @brief  Returns the write handling registered for a handle
+ *
+ * @param handle    attribute handle
+ *
+ * @return app_bt_attr_write_t  write handling, NULL if the handle is not in the table
+ */
+const app_bt_attr_write_t *app_bt_attr_get_write(uint16_t handle)
+{
+    uint16_t index = app_bt_attr_index(handle);
+
+    if (APP_BT_ATTR_NO_ENTRY == index)
+    {
+        return NULL;
+    }
+    return &attr_write[index];
+}
+
+
+/* [] END OF FILE */
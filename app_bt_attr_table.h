@@ -0,0 +1,86 @@
+/******************************************************************************
+* File Name:   app_bt_attr_table.h
+*
+* Description: This file contains the handle indexed lookup of the GATT
+*              attributes held by the application and the per-handle write
+*              handlers.
+*
+* Related Document: See README.md
+*
+********************************************************************************
+* Copyright 2021-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef __APP_BT_ATTR_TABLE_H__
+#define __APP_BT_ATTR_TABLE_H__
+
+/******************************************************************************
+ *                                INCLUDES
+ ******************************************************************************/
+#include <stdint.h>
+#include "wiced_bt_gatt.h"
+#include "GeneratedSource/cycfg_gatt_db.h"
+
+/******************************************************************************
+ *                                Constants
+ ******************************************************************************/
+/* Write handler flags */
+#define APP_BT_ATTR_WRITE_SINK                  (0x01u)   /* consume p_val, do not copy to the table */
+
+/******************************************************************************
+ *                                Structures
+ ******************************************************************************/
+/* Side effect of a write, called after the value has been validated. p_val
+ * points to the written value, which may not have been copied to p_attr */
+typedef wiced_bt_gatt_status_t (*app_bt_attr_write_cb_t)(uint16_t conn_id,
+                                                        gatt_db_lookup_table_t *p_attr,
+                                                        uint8_t *p_val, uint16_t len);
+
+/* Write handling registered for an attribute */
+typedef struct
+{
+    app_bt_attr_write_cb_t  p_cb;       /* write handler, NULL if none */
+    uint8_t                 flags;      /* APP_BT_ATTR_WRITE_* */
+} app_bt_attr_write_t;
+
+/****************************************************************************
+ *                              FUNCTION DECLARATIONS
+ ***************************************************************************/
+void app_bt_attr_table_init(void);
+gatt_db_lookup_table_t *app_bt_attr_find(uint16_t handle);
+wiced_result_t app_bt_attr_register_write(uint16_t handle, app_bt_attr_write_cb_t p_cb, uint8_t flags);
+const app_bt_attr_write_t *app_bt_attr_get_write(uint16_t handle);
+
+#endif      /* __APP_BT_ATTR_TABLE_H__ */
+
+
+/* [] END OF FILE */
@@ -0,0 +1,263 @@
+/******************************************************************************
+* File Name:   app_bt_buffer_pool.c
+*
+* Description: This file contains the fixed-block buffer pool used for GATT
+*              response buffers. Each size class keeps its free blocks in a
+*              32-bit bitmap that is claimed and released with atomic
+*              compare-and-swap, so the pool can be used from the stack
+*              thread, application tasks and interrupts without a lock.
+*
+* Related Document: See README.md
+*
+********************************************************************************
+* Copyright 2021-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/******************************************************************************
+ *                                INCLUDES
+ ******************************************************************************/
+#include <stdbool.h>
+#include <stdlib.h>
+#include "app_bt_buffer_pool.h"
+
+/******************************************************************************
+ *                                Constants
+ ******************************************************************************/
+#define APP_BT_POOL_CLASS_COUNT          (3)
+
+/* Number of 32-bit words needed to hold a block of size bytes */
+#define APP_BT_POOL_WORDS(size)          (((size) + sizeof(uint32_t) - 1) / sizeof(uint32_t))
+
+/* Bitmap with one bit set for each of count blocks */
+#define APP_BT_POOL_FULL_MAP(count)      ((count) >= 32 ? 0xFFFFFFFFu : ((1u << (count)) - 1u))
+
+/* The free blocks of a class are tracked in a 32-bit map */
+_Static_assert((APP_BT_POOL_SMALL_BLOCK_COUNT >= 1) && (APP_BT_POOL_SMALL_BLOCK_COUNT <= 32),
+               "APP_BT_POOL_SMALL_BLOCK_COUNT must be between 1 and 32");
+_Static_assert((APP_BT_POOL_MTU_BLOCK_COUNT >= 1) && (APP_BT_POOL_MTU_BLOCK_COUNT <= 32),
+               "APP_BT_POOL_MTU_BLOCK_COUNT must be between 1 and 32");
+_Static_assert((APP_BT_POOL_LARGE_BLOCK_COUNT >= 1) && (APP_BT_POOL_LARGE_BLOCK_COUNT <= 32),
+               "APP_BT_POOL_LARGE_BLOCK_COUNT must be between 1 and 32");
+
+/******************************************************************************
+ *                                Structures
+ ******************************************************************************/
+typedef struct
+{
+    uint16_t          block_size;   /* usable bytes per block */
+    uint16_t          block_count;  /* number of blocks in the class */
+    uint8_t          *p_base;       /* first block of the class */
+    volatile uint32_t free_map;     /* bit n set when block n is free */
+} app_bt_pool_class_t;
+
+/******************************************************************************
+ *                                Variable Definitions
+ ******************************************************************************/
+static uint32_t pool_small[APP_BT_POOL_SMALL_BLOCK_COUNT][APP_BT_POOL_WORDS(APP_BT_POOL_SMALL_BLOCK_SIZE)];
+static uint32_t pool_mtu[APP_BT_POOL_MTU_BLOCK_COUNT][APP_BT_POOL_WORDS(APP_BT_POOL_MTU_BLOCK_SIZE)];
+static uint32_t pool_large[APP_BT_POOL_LARGE_BLOCK_COUNT][APP_BT_POOL_WORDS(APP_BT_POOL_LARGE_BLOCK_SIZE)];
+
+/* Size classes ordered by increasing block size */
+static app_bt_pool_class_t pool_class[APP_BT_POOL_CLASS_COUNT] =
+{
+    {
+        .block_size  = sizeof(pool_small[0]),
+        .block_count = APP_BT_POOL_SMALL_BLOCK_COUNT,
+        .p_base      = (uint8_t *)pool_small,
+        .free_map    = APP_BT_POOL_FULL_MAP(APP_BT_POOL_SMALL_BLOCK_COUNT)
+    },
+    {
+        .block_size  = sizeof(pool_mtu[0]),
+        .block_count = APP_BT_POOL_MTU_BLOCK_COUNT,
+        .p_base      = (uint8_t *)pool_mtu,
+        .free_map    = APP_BT_POOL_FULL_MAP(APP_BT_POOL_MTU_BLOCK_COUNT)
+    },
+    {
+        .block_size  = sizeof(pool_large[0]),
+        .block_count = APP_BT_POOL_LARGE_BLOCK_COUNT,
+        .p_base      = (uint8_t *)pool_large,
+        .free_map    = APP_BT_POOL_FULL_MAP(APP_BT_POOL_LARGE_BLOCK_COUNT)
+    }
+};
+
+static app_bt_buffer_pool_stats_t pool_stats;
+
+/****************************************************************************
+ *                              FUNCTION DEFINITIONS
+ ***************************************************************************/
+
+/**
+ * Function Name:
+ * app_bt_pool_class_take
+ *
+ * Function Description:
+ * @brief  Claims a free block of a size class
+ *
+ * @param p_class    size class to take the block from
+ *
+ * @return uint8_t*  pointer to the block, NULL if the class is empty
+ */
+static uint8_t *app_bt_pool_class_take(app_bt_pool_class_t *p_class)
+{
+    uint32_t map = __atomic_load_n(&p_class->free_map, __ATOMIC_ACQUIRE);
+    uint32_t index;
+
+    while (0 != map)
+    {
+        index = (uint32_t)__builtin_ctz(map);
+        if (__atomic_compare_exchange_n(&p_class->free_map, &map, map & ~(1u << index),
+                                        false, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE))
+        {
+            return p_class->p_base + (index * p_class->block_size);
+        }
+        /* map was reloaded by the failed compare-and-swap, retry */
+    }
+    return NULL;
+}
+
+/**
+ * Function Name:
+ * app_bt_buffer_pool_alloc
+ *
+ * Function Description:
+ * @brief  Allocates a buffer of at least len bytes from the smallest size class
+ *         that has a free block. When every fitting class is empty or len is
+ *         larger than the largest class, the allocation is counted as a miss
+ *         and falls back to the heap if APP_BT_POOL_HEAP_FALLBACK is 1.
+ *
+ * @param len        Length of the buffer
+ *
+ * @return uint8_t*  pointer to allocated buffer, NULL on a miss without a
+ *                   heap fallback or when the heap is exhausted too
+ */
+uint8_t *app_bt_buffer_pool_alloc(uint16_t len)
+{
+    uint8_t *p_buf;
+    uint32_t in_use, high_water;
+
+    for (uint8_t i = 0; i < APP_BT_POOL_CLASS_COUNT; i++)
+    {
+        if (pool_class[i].block_size < len)
+        {
+            continue;
+        }
+        p_buf = app_bt_pool_class_take(&pool_class[i]);
+        if (NULL != p_buf)
+        {
+            __atomic_fetch_add(&pool_stats.hits, 1, __ATOMIC_RELAXED);
+            in_use = __atomic_add_fetch(&pool_stats.in_use, 1, __ATOMIC_RELAXED);
+            high_water = __atomic_load_n(&pool_stats.high_water, __ATOMIC_RELAXED);
+            while ((in_use > high_water) &&
+                   !__atomic_compare_exchange_n(&pool_stats.high_water, &high_water, in_use,
+                                                false, __ATOMIC_RELAXED, __ATOMIC_RELAXED))
+            {
+            }
+            return p_buf;
+        }
+    }
+
+    __atomic_fetch_add(&pool_stats.misses, 1, __ATOMIC_RELAXED);
+#if APP_BT_POOL_HEAP_FALLBACK
+    p_buf = (uint8_t *)malloc(len);
+    if (NULL != p_buf)
+    {
+        __atomic_fetch_add(&pool_stats.fallbacks, 1, __ATOMIC_RELAXED);
+    }
+    return p_buf;
+#else
+    return NULL;
+#endif
+}
+
+/**
+ * Function Name:
+ * app_bt_buffer_pool_free
+ *
+ * Function Description:
+ * @brief  Returns a buffer obtained from app_bt_buffer_pool_alloc, either to its
+ *         size class or to the heap
+ *
+ * @param p_buf      pointer to the buffer to be freed
+ *
+ * @return void
+ */
+void app_bt_buffer_pool_free(uint8_t *p_buf)
+{
+    app_bt_pool_class_t *p_class;
+    uint32_t index;
+
+    if (NULL == p_buf)
+    {
+        return;
+    }
+
+    for (uint8_t i = 0; i < APP_BT_POOL_CLASS_COUNT; i++)
+    {
+        p_class = &pool_class[i];
+        if ((p_buf >= p_class->p_base) &&
+            (p_buf < p_class->p_base + (p_class->block_count * p_class->block_size)))
+        {
+            index = (uint32_t)(p_buf - p_class->p_base) / p_class->block_size;
+            __atomic_fetch_or(&p_class->free_map, 1u << index, __ATOMIC_RELEASE);
+            __atomic_fetch_sub(&pool_stats.in_use, 1, __ATOMIC_RELAXED);
+            return;
+        }
+    }
+
+#if APP_BT_POOL_HEAP_FALLBACK
+    /* Not a pool block, it came from the heap fallback */
+    free(p_buf);
+#endif
+}
+
+/**
+ * Function Name:
+ * app_bt_buffer_pool_get_stats
+ *
+ * Function Description:
+ * @brief  Copies the pool counters
+ *
+ * @param p_stats    destination of the counters
+ *
+ * @return void
+ */
+void app_bt_buffer_pool_get_stats(app_bt_buffer_pool_stats_t *p_stats)
+{
+    p_stats->hits       = __atomic_load_n(&pool_stats.hits, __ATOMIC_RELAXED);
+    p_stats->misses     = __atomic_load_n(&pool_stats.misses, __ATOMIC_RELAXED);
+    p_stats->fallbacks  = __atomic_load_n(&pool_stats.fallbacks, __ATOMIC_RELAXED);
+    p_stats->in_use     = __atomic_load_n(&pool_stats.in_use, __ATOMIC_RELAXED);
+    p_stats->high_water = __atomic_load_n(&pool_stats.high_water, __ATOMIC_RELAXED);
+}
+
+
+/* [] END OF FILE */
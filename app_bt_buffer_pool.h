@@ -0,0 +1,113 @@
+/******************************************************************************
+* File Name:   app_bt_buffer_pool.h
+*
+* Description: This file contains the fixed-block buffer pool used for GATT
+*              response buffers. Blocks are taken from size classes derived
+*              from the MTU and RX PDU size configured in design.cybt, so
+*              response buffering does not touch the heap in steady state.
+*
+* Related Document: See README.md
+*
+********************************************************************************
+* Copyright 2021-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef __APP_BT_BUFFER_POOL_H__
+#define __APP_BT_BUFFER_POOL_H__
+
+/******************************************************************************
+ *                                INCLUDES
+ ******************************************************************************/
+#include <stdint.h>
+#include "cycfg_bt_settings.h"
+
+/******************************************************************************
+ *                                Constants
+ ******************************************************************************/
+/* Block size of the small class, used for short attribute values */
+#ifndef APP_BT_POOL_SMALL_BLOCK_SIZE
+#define APP_BT_POOL_SMALL_BLOCK_SIZE            (64)
+#endif
+
+/* Block size of the MTU class, one ATT PDU of the default MTU */
+#ifndef APP_BT_POOL_MTU_BLOCK_SIZE
+#define APP_BT_POOL_MTU_BLOCK_SIZE              (CY_BT_MTU_SIZE)
+#endif
+
+/* Block size of the large class, one ATT PDU of the largest MTU accepted */
+#ifndef APP_BT_POOL_LARGE_BLOCK_SIZE
+#define APP_BT_POOL_LARGE_BLOCK_SIZE            (CY_BT_RX_PDU_SIZE)
+#endif
+
+/* Number of blocks of each class, at most 32 per class */
+#ifndef APP_BT_POOL_SMALL_BLOCK_COUNT
+#define APP_BT_POOL_SMALL_BLOCK_COUNT           (8)
+#endif
+
+#ifndef APP_BT_POOL_MTU_BLOCK_COUNT
+#define APP_BT_POOL_MTU_BLOCK_COUNT             (8)
+#endif
+
+#ifndef APP_BT_POOL_LARGE_BLOCK_COUNT
+#define APP_BT_POOL_LARGE_BLOCK_COUNT           (4)
+#endif
+
+/* 1: serve allocations from the heap when every fitting class is empty.
+ * 0: fail them, so that the pool never touches the heap */
+#ifndef APP_BT_POOL_HEAP_FALLBACK
+#define APP_BT_POOL_HEAP_FALLBACK               (0)
+#endif
+
+/******************************************************************************
+ *                                Structures
+ ******************************************************************************/
+typedef struct
+{
+    uint32_t hits;          /* allocations served from the pool */
+    uint32_t misses;        /* allocations that found every fitting class empty */
+    uint32_t fallbacks;     /* allocations served from the heap after a miss,
+                             * 0 unless APP_BT_POOL_HEAP_FALLBACK is 1 */
+    uint32_t in_use;        /* pool blocks currently allocated */
+    uint32_t high_water;    /* largest number of pool blocks allocated at once */
+} app_bt_buffer_pool_stats_t;
+
+/****************************************************************************
+ *                              FUNCTION DECLARATIONS
+ ***************************************************************************/
+uint8_t *app_bt_buffer_pool_alloc(uint16_t len);
+void     app_bt_buffer_pool_free(uint8_t *p_buf);
+void     app_bt_buffer_pool_get_stats(app_bt_buffer_pool_stats_t *p_stats);
+
+#endif      /* __APP_BT_BUFFER_POOL_H__ */
+
+
+/* [] END OF FILE */
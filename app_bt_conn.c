@@ -0,0 +1,296 @@
+/******************************************************************************
+* File Name:   app_bt_conn.c
+*
+* Description: This file contains the per-connection state table used by the
+*              throughput server to serve several GATT clients at the
+*              same time.
+*
+* Related Document: See README.md
+*
+********************************************************************************
+* Copyright 2021-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/******************************************************************************
+ *                                INCLUDES
+ ******************************************************************************/
+#include <string.h>
+#include "app_bt_conn.h"
+
+/******************************************************************************
+ *                                Macros
+ ******************************************************************************/
+/* Slot in use, its content initialized by app_bt_conn_alloc is visible */
+#define APP_BT_CONN_IN_USE(p_conn)      (__atomic_load_n(&(p_conn)->in_use, __ATOMIC_ACQUIRE))
+
+/******************************************************************************
+ *                                Variable Definitions
+ ******************************************************************************/
+
+/* Variable to store connection state information of every client */
+static conn_state_info_t conn_state_info[APP_BT_MAX_CONNECTIONS];
+
+/* Slots released by app_bt_conn_free and not yet reset by notify_task, one bit per slot */
+static uint32_t conn_retired_map;
+_Static_assert(APP_BT_MAX_CONNECTIONS <= 32, "conn_retired_map holds 32 slots");
+
+/****************************************************************************
+ *                              FUNCTION DEFINITIONS
+ ***************************************************************************/
+
+/**
+ * Function Name:
+ * app_bt_conn_alloc
+ *
+ * Function Description:
+ * @brief  Claims a free slot of the connection table for a new connection
+ *
+ * @param conn_id    connection ID referenced by the stack
+ * @param bda        remote peer device address
+ *
+ * @return conn_state_info_t*  pointer to the claimed slot, NULL if the table is full
+ */
+conn_state_info_t *app_bt_conn_alloc(uint16_t conn_id, wiced_bt_device_address_t bda)
+{
+    for (uint8_t i = 0; i < APP_BT_MAX_CONNECTIONS; i++)
+    {
+        if ((!APP_BT_CONN_IN_USE(&conn_state_info[i])) &&
+            (0 == (__atomic_load_n(&conn_retired_map, __ATOMIC_ACQUIRE) & (1u << i))))
+        {
+            memset(&conn_state_info[i], 0u, sizeof(conn_state_info_t));
+            conn_state_info[i].conn_id = conn_id;
+            memcpy(conn_state_info[i].remote_addr, bda, BD_ADDR_LEN);
+            conn_state_info[i].mtu = APP_BT_ATT_DEFAULT_MTU;
+            conn_state_info[i].tx_octets = APP_BT_LL_DEFAULT_TX_OCTETS;
+            app_tput_ctrl_init(&conn_state_info[i].ctrl);
+            app_tput_indication_init(&conn_state_info[i].ind);
+            app_tput_link_init(&conn_state_info[i].link, conn_state_info[i].ctrl.phy);
+            app_bt_conn_update_payload_size(&conn_state_info[i]);
+            /* Publish the slot once initialized */
+            __atomic_store_n(&conn_state_info[i].in_use, WICED_TRUE, __ATOMIC_RELEASE);
+            return &conn_state_info[i];
+        }
+    }
+    return NULL;
+}
+
+/**
+ * Function Name:
+ * app_bt_conn_free
+ *
+ * Function Description:
+ * @brief  Releases a slot of the connection table in two phases. The slot
+ *         stops being returned by the lookups here, but notify_task may be
+ *         sending on it, so its content is kept until notify_task resets it
+ *         with app_bt_conn_reclaim on NOTIFY_EVT_CONN_DOWN. The slot is not
+ *         reused before then.
+ *
+ * @param p_conn     slot returned by app_bt_conn_alloc
+ *
+ * @return void
+ */
+void app_bt_conn_free(conn_state_info_t *p_conn)
+{
+    if (NULL != p_conn)
+    {
+        __atomic_fetch_or(&conn_retired_map, 1u << (p_conn - conn_state_info), __ATOMIC_RELAXED);
+        __atomic_store_n(&p_conn->in_use, WICED_FALSE, __ATOMIC_RELEASE);
+    }
+}
+
+/**
+ * Function Name:
+ * app_bt_conn_reclaim
+ *
+ * Function Description:
+ * @brief  Resets the slots released by app_bt_conn_free so that they can be
+ *         allocated again. Called by notify_task, which holds no slot
+ *         pointer across this call.
+ *
+ * @return void
+ */
+void app_bt_conn_reclaim(void)
+{
+    for (uint8_t i = 0; i < APP_BT_MAX_CONNECTIONS; i++)
+    {
+        if (0 != (__atomic_load_n(&conn_retired_map, __ATOMIC_ACQUIRE) & (1u << i)))
+        {
+            memset(&conn_state_info[i], 0u, sizeof(conn_state_info_t));
+            /* The slot can be allocated once its reset is complete */
+            __atomic_fetch_and(&conn_retired_map, ~(1u << i), __ATOMIC_RELEASE);
+        }
+    }
+}
+
+/**
+ * Function Name:
+ * app_bt_conn_find
+ *
+ * Function Description:
+ * @brief  Finds the connection state of a connection ID
+ *
+ * @param conn_id    connection ID referenced by the stack
+ *
+ * @return conn_state_info_t*  pointer to the connection state, NULL if not connected
+ */
+conn_state_info_t *app_bt_conn_find(uint16_t conn_id)
+{
+    for (uint8_t i = 0; i < APP_BT_MAX_CONNECTIONS; i++)
+    {
+        if (APP_BT_CONN_IN_USE(&conn_state_info[i]) && (conn_state_info[i].conn_id == conn_id))
+        {
+            return &conn_state_info[i];
+        }
+    }
+    return NULL;
+}
+
+/**
+ * Function Name:
+ * app_bt_conn_find_by_bda
+ *
+ * Function Description:
+ * @brief  Finds the connection state of a remote peer device address
+ *
+ * @param bda        remote peer device address
+ *
+ * @return conn_state_info_t*  pointer to the connection state, NULL if not connected
+ */
+conn_state_info_t *app_bt_conn_find_by_bda(wiced_bt_device_address_t bda)
+{
+    for (uint8_t i = 0; i < APP_BT_MAX_CONNECTIONS; i++)
+    {
+        if (APP_BT_CONN_IN_USE(&conn_state_info[i]) &&
+            (0 == memcmp(conn_state_info[i].remote_addr, bda, BD_ADDR_LEN)))
+        {
+            return &conn_state_info[i];
+        }
+    }
+    return NULL;
+}
+
+/**
+ * Function Name:
+ * app_bt_conn_get
+ *
+ * Function Description:
+ * @brief  Returns the slot at index of the connection table if it is in use.
+ *         Used to iterate over all the active connections.
+ *
+ * @param index      slot index, 0 to APP_BT_MAX_CONNECTIONS - 1
+ *
+ * @return conn_state_info_t*  pointer to the connection state, NULL if the slot is free
+ */
+conn_state_info_t *app_bt_conn_get(uint8_t index)
+{
+    if ((index < APP_BT_MAX_CONNECTIONS) && APP_BT_CONN_IN_USE(&conn_state_info[index]))
+    {
+        return &conn_state_info[index];
+    }
+    return NULL;
+}
+
+/**
+ * Function Name:
+ * app_bt_conn_count
+ *
+ * Function Description:
+ * @brief  Returns the number of active connections
+ *
+ * @return uint8_t   number of slots in use
+ */
+uint8_t app_bt_conn_count(void)
+{
+    uint8_t count = 0;
+
+    for (uint8_t i = 0; i < APP_BT_MAX_CONNECTIONS; i++)
+    {
+        if (APP_BT_CONN_IN_USE(&conn_state_info[i]))
+        {
+            count++;
+        }
+    }
+    return count;
+}
+
+/**
+ * Function Name:
+ * app_bt_conn_update_payload_size
+ *
+ * Function Description:
+ * @brief  Sizes the notification payload of a connection from its ATT MTU and
+ *         LL TX payload length. The ATT and L2CAP headers are added to the
+ *         payload, and the payload is chosen so that the resulting L2CAP PDU
+ *         fills an integral number of LL PDUs, capped at the length of the
+ *         Notify value in the GATT database. A payload size set through the
+ *         Control characteristic is used as is when it fits the MTU. Call
+ *         after the MTU, the data length or the payload limit changed.
+ *
+ * @param p_conn     connection state
+ *
+ * @return void
+ */
+void app_bt_conn_update_payload_size(conn_state_info_t *p_conn)
+{
+    uint16_t max_payload = 0;
+    uint16_t overhead = APP_BT_ATT_NOTIFY_HDR_LEN + APP_BT_L2CAP_HDR_LEN;
+    uint16_t ll_pdus;
+
+    if (p_conn->mtu > APP_BT_ATT_NOTIFY_HDR_LEN)
+    {
+        max_payload = p_conn->mtu - APP_BT_ATT_NOTIFY_HDR_LEN;
+    }
+    if (max_payload > APP_TPUT_NOTIFY_MAX_LEN)
+    {
+        max_payload = APP_TPUT_NOTIFY_MAX_LEN;
+    }
+    if ((0 != p_conn->ctrl.payload_limit) && (max_payload >= p_conn->ctrl.payload_limit))
+    {
+        /* Payload size set by the client, sent as is */
+        p_conn->payload_size = p_conn->ctrl.payload_limit;
+        return;
+    }
+
+    ll_pdus = (max_payload + overhead) / p_conn->tx_octets;
+    if (0 == ll_pdus)
+    {
+        /* The largest payload already fits in a single LL PDU */
+        p_conn->payload_size = max_payload;
+    }
+    else
+    {
+        p_conn->payload_size = (ll_pdus * p_conn->tx_octets) - overhead;
+    }
+}
+
+
+/* [] END OF FILE */
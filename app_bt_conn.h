@@ -0,0 +1,130 @@
+/******************************************************************************
+* File Name:   app_bt_conn.h
+*
+* Description: This file contains the per-connection state table used by the
+*              throughput server to serve several GATT clients at the
+*              same time.
+*
+* Related Document: See README.md
+*
+********************************************************************************
+* Copyright 2021-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef __APP_BT_CONN_H__
+#define __APP_BT_CONN_H__
+
+/******************************************************************************
+ *                                INCLUDES
+ ******************************************************************************/
+#include "wiced_bt_dev.h"
+#include "wiced_bt_ble.h"
+#include "app_tput_config.h"
+#include "app_tput_pacer.h"
+#include "app_tput_ctrl.h"
+#include "app_tput_stats.h"
+#include "app_tput_counters.h"
+#include "app_tput_frame.h"
+#include "app_tput_telemetry.h"
+#include "app_tput_autotune.h"
+#include "app_tput_link.h"
+#include "app_tput_indication.h"
+#include "app_tput_coc.h"
+#include "app_tput_ping.h"
+#include "app_tput_congestion.h"
+#include "app_bt_prep_write.h"
+
+/******************************************************************************
+ *                                Structures
+ ******************************************************************************/
+typedef struct
+{
+    wiced_bool_t                          in_use;        /* slot holds an active connection */
+    wiced_bt_device_address_t             remote_addr;   /* remote peer device address */
+    uint16_t                              conn_id;       /* connection ID referenced by the stack */
+    uint16_t                              mtu;           /* MTU exchanged after connection */
+    uint16_t                              tx_octets;     /* LL TX payload octets after data length update */
+    uint16_t                              payload_size;  /* notification payload sized from mtu and tx_octets */
+    double                                conn_interval; /* connection interval negotiated */
+    wiced_bt_ble_host_phy_preferences_t   rx_phy;        /* RX PHY selected */
+    wiced_bt_ble_host_phy_preferences_t   tx_phy;        /* TX PHY selected */
+    uint16_t                              cccd;          /* client characteristic configuration of this client */
+    volatile wiced_bool_t                 congested;     /* stack reported congestion on this link */
+    uint32_t                              congestion_events; /* congestion reported by the stack */
+    uint32_t                              send_failures; /* notifications not accepted by the stack */
+    uint32_t                              deficit;       /* notification scheduler deficit in bytes */
+    app_tput_pacer_t                      pacer;         /* adaptive notification burst pacing */
+    app_tput_ctrl_t                       ctrl;          /* test run configured through the Control characteristic */
+    app_tput_counter_t                    tx_ctr;        /* GATT notifications sent, written by notify_task */
+    volatile uint32_t                     tx_packets;    /* notifications sent, written by notify_task, read
+                                                            without a retry by the congestion callback */
+    app_tput_counter_t                    rx_ctr;        /* GATT writes received, written by the stack thread */
+    app_tput_counter_t                    rd_ctr;        /* GATT read responses sent, written by the stack thread */
+    app_tput_frame_tx_t                   tx_frame;      /* framed notification sequence and goodput */
+    app_tput_frame_rx_t                   rx_frame;      /* framed write checks and goodput */
+    app_tput_stats_t                      tx_stats;      /* notification throughput statistics */
+    app_tput_stats_t                      rx_stats;      /* write throughput statistics */
+    app_tput_stats_t                      rd_stats;      /* read throughput statistics */
+    app_tput_telemetry_t                  telemetry;     /* Telemetry notifications */
+    app_tput_autotune_t                   autotune;      /* parameter sweep */
+    app_tput_link_t                       link;          /* PHY fallback monitor */
+    app_tput_indication_t                 ind;           /* indication confirmations */
+    app_tput_coc_t                        coc;           /* L2CAP credit based channel */
+    app_tput_ping_t                       ping;          /* Ping probes */
+    app_tput_congestion_t                 congestion;    /* congestion episodes */
+    app_bt_prep_write_t                   prep_write;    /* prepared (long) write queue */
+} conn_state_info_t;
+
+/******************************************************************************
+ *                                Constants
+ ******************************************************************************/
+#define APP_BT_ATT_DEFAULT_MTU                  (23)    /* ATT MTU before the MTU exchange */
+#define APP_BT_LL_DEFAULT_TX_OCTETS             (27)    /* LL payload before data length update */
+#define APP_BT_ATT_NOTIFY_HDR_LEN               (3)     /* ATT opcode and handle */
+#define APP_BT_L2CAP_HDR_LEN                    (4)     /* L2CAP length and channel ID */
+
+/****************************************************************************
+ *                              FUNCTION DECLARATIONS
+ ***************************************************************************/
+conn_state_info_t *app_bt_conn_alloc(uint16_t conn_id, wiced_bt_device_address_t bda);
+void               app_bt_conn_free(conn_state_info_t *p_conn);
+void               app_bt_conn_reclaim(void);
+conn_state_info_t *app_bt_conn_find(uint16_t conn_id);
+conn_state_info_t *app_bt_conn_find_by_bda(wiced_bt_device_address_t bda);
+conn_state_info_t *app_bt_conn_get(uint8_t index);
+uint8_t            app_bt_conn_count(void);
+void               app_bt_conn_update_payload_size(conn_state_info_t *p_conn);
+
+#endif      /* __APP_BT_CONN_H__ */
+
+
+/* [] END OF FILE */
@@ -0,0 +1,158 @@
+/******************************************************************************
+* File Name:   app_bt_prep_write.c
+*
+* Description: This file contains the prepared (long) write queue. A client
+*              queues the segments of one attribute at a time; the arena is
+*              bounded, so no segment is allocated or kept in a list.
+*
+* Related Document: See README.md
+*
+********************************************************************************
+* Copyright 2021-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/******************************************************************************
+ *                                INCLUDES
+ ******************************************************************************/
+#include <string.h>
+#include "app_bt_prep_write.h"
+
+/****************************************************************************
+ *                              FUNCTION DEFINITIONS
+ ***************************************************************************/
+
+/**
+ * Function Name:
+ * app_bt_prep_write_queue
+ *
+ * Function Description:
+ * @brief  Copies a prepared write segment to its offset in the arena. Segments
+ *         may overwrite bytes already queued but must not leave a gap, and all
+ *         segments of a queue must be for the same attribute.
+ *
+ * @param p_prep      prepared write queue of the client
+ * @param handle      attribute handle of the segment
+ * @param offset      offset of the segment in the value
+ * @param p_val       segment data
+ * @param len         segment length
+ * @param max_len     longest value the attribute accepts
+ * @param pp_segment  set to the segment in the arena, for the response echo
+ *
+ * @return wiced_bt_gatt_status_t  WICED_BT_GATT_SUCCESS if the segment was queued
+ */
+wiced_bt_gatt_status_t app_bt_prep_write_queue(app_bt_prep_write_t *p_prep, uint16_t handle, uint16_t offset,
+                                               const uint8_t *p_val, uint16_t len, uint16_t max_len,
+                                               uint8_t **pp_segment)
+{
+    uint8_t *p_arena = (uint8_t *)p_prep->arena;
+    wiced_bt_gatt_status_t status = WICED_BT_GATT_SUCCESS;
+
+    if ((0 != p_prep->handle) && (handle != p_prep->handle))
+    {
+        /* The arena holds the value of one attribute */
+        status = WICED_BT_GATT_PREPARE_Q_FULL;
+    }
+    else if (offset > p_prep->len)
+    {
+        status = WICED_BT_GATT_INVALID_OFFSET;
+    }
+    else if (((uint32_t)offset + len > max_len) || ((uint32_t)offset + len > APP_BT_PREP_WRITE_ARENA_SIZE))
+    {
+        status = WICED_BT_GATT_INVALID_ATTR_LEN;
+    }
+
+    if (WICED_BT_GATT_SUCCESS != status)
+    {
+        p_prep->rejected++;
+        return status;
+    }
+
+    memcpy(&p_arena[offset], p_val, len);
+    if (offset + len > p_prep->len)
+    {
+        p_prep->len = offset + len;
+    }
+    p_prep->handle = handle;
+    p_prep->queued++;
+    p_prep->segments++;
+    *pp_segment = &p_arena[offset];
+    return WICED_BT_GATT_SUCCESS;
+}
+
+/**
+ * Function Name:
+ * app_bt_prep_write_value
+ *
+ * Function Description:
+ * @brief  Returns the value assembled from the queued segments, p_prep->len
+ *         bytes long, for the attribute p_prep->handle
+ *
+ * @param p_prep      prepared write queue of the client
+ *
+ * @return uint8_t*   assembled value, valid until app_bt_prep_write_finish
+ */
+uint8_t *app_bt_prep_write_value(app_bt_prep_write_t *p_prep)
+{
+    return (uint8_t *)p_prep->arena;
+}
+
+/**
+ * Function Name:
+ * app_bt_prep_write_finish
+ *
+ * Function Description:
+ * @brief  Empties the queue after an execute write request and counts the
+ *         value as written or the queue as cancelled
+ *
+ * @param p_prep      prepared write queue of the client
+ * @param written     WICED_TRUE if the assembled value was written
+ *
+ * @return void
+ */
+void app_bt_prep_write_finish(app_bt_prep_write_t *p_prep, wiced_bool_t written)
+{
+    if (written)
+    {
+        app_tput_counter_add(&p_prep->value_ctr, p_prep->len);
+    }
+    else if (0 != p_prep->queued)
+    {
+        p_prep->cancelled++;
+    }
+
+    p_prep->handle = 0;
+    p_prep->len    = 0;
+    p_prep->queued = 0;
+}
+
+
+/* [] END OF FILE */
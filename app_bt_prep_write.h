@@ -0,0 +1,92 @@
+/******************************************************************************
+* File Name:   app_bt_prep_write.h
+*
+* Description: This file contains the prepared (long) write queue. Segments of
+*              a queued write are assembled in place in a per-connection
+*              arena and the complete value is written on execute.
+*
+* Related Document: See README.md
+*
+********************************************************************************
+* Copyright 2021-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef __APP_BT_PREP_WRITE_H__
+#define __APP_BT_PREP_WRITE_H__
+
+/******************************************************************************
+ *                                INCLUDES
+ ******************************************************************************/
+#include <stdint.h>
+#include "wiced_bt_gatt.h"
+#include "app_tput_counters.h"
+
+/******************************************************************************
+ *                                Constants
+ ******************************************************************************/
+/* Longest value assembled from queued segments, the largest attribute value
+ * ATT allows */
+#ifndef APP_BT_PREP_WRITE_ARENA_SIZE
+#define APP_BT_PREP_WRITE_ARENA_SIZE            (512)
+#endif
+
+/******************************************************************************
+ *                                Structures
+ ******************************************************************************/
+/* Prepared write queue of one client, only used by the Bluetooth stack thread
+ * apart from the counters */
+typedef struct
+{
+    uint16_t           handle;          /* attribute of the queued segments, 0 when empty */
+    uint16_t           len;             /* bytes assembled from offset 0 */
+    uint16_t           queued;          /* segments queued since the last execute or cancel */
+    volatile uint32_t  segments;        /* segments accepted */
+    volatile uint32_t  rejected;        /* segments rejected */
+    volatile uint32_t  cancelled;       /* queues cancelled or failing on execute */
+    app_tput_counter_t value_ctr;       /* executed values, written by the stack thread */
+    uint64_t           reported_bytes;  /* value_ctr bytes at the previous report */
+    uint32_t           arena[(APP_BT_PREP_WRITE_ARENA_SIZE + sizeof(uint32_t) - 1) / sizeof(uint32_t)];
+} app_bt_prep_write_t;
+
+/****************************************************************************
+ *                              FUNCTION DECLARATIONS
+ ***************************************************************************/
+wiced_bt_gatt_status_t app_bt_prep_write_queue(app_bt_prep_write_t *p_prep, uint16_t handle, uint16_t offset,
+                                               const uint8_t *p_val, uint16_t len, uint16_t max_len,
+                                               uint8_t **pp_segment);
+uint8_t               *app_bt_prep_write_value(app_bt_prep_write_t *p_prep);
+void                   app_bt_prep_write_finish(app_bt_prep_write_t *p_prep, wiced_bool_t written);
+
+#endif      /* __APP_BT_PREP_WRITE_H__ */
+
+
+/* [] END OF FILE */
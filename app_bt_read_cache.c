@@ -0,0 +1,353 @@
+/******************************************************************************
+* File Name:   app_bt_read_cache.c
+*
+* Description: This file contains the read-by-type response cache. The Bluetooth
+*              stack thread is the only one that builds, sends, releases or
+*              invalidates responses, so the slots need no locking.
+*
+* Related Document: See README.md
+*
+********************************************************************************
+* Copyright 2021-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/******************************************************************************
+ *                                INCLUDES
+ ******************************************************************************/
+#include <stdbool.h>
+#include <string.h>
+#include "app_bt_read_cache.h"
+
+/******************************************************************************
+ *                                Variable Definitions
+ ******************************************************************************/
+static app_bt_read_cache_entry_t read_cache[APP_BT_READ_CACHE_ENTRIES];
+
+/* Next slot to consider for replacement */
+static uint8_t read_cache_cursor;
+
+static app_bt_read_cache_stats_t read_cache_stats;
+
+/* Attributes whose value depends on the client, never cached */
+static uint16_t read_cache_excluded[APP_BT_READ_CACHE_MAX_EXCLUDED];
+static uint8_t read_cache_excluded_count;
+
+/****************************************************************************
+ *                              FUNCTION DEFINITIONS
+ ***************************************************************************/
+
+/**
+ * Function Name:
+ * app_bt_read_cache_matches
+ *
+ * Function Description:
+ * @brief  Checks whether a slot was built for a request
+ *
+ * @param p_entry        slot to check
+ * @param p_req          read-by-type request
+ * @param len_requested  largest response the client accepts
+ *
+ * @return bool  true when the key of the slot equals the request
+ */
+static bool app_bt_read_cache_matches(const app_bt_read_cache_entry_t *p_entry,
+                                      const wiced_bt_gatt_read_by_type_t *p_req,
+                                      uint16_t len_requested)
+{
+    return (p_entry->s_handle == p_req->s_handle) &&
+           (p_entry->e_handle == p_req->e_handle) &&
+           (p_entry->len_requested == len_requested) &&
+           (p_entry->uuid.len == p_req->uuid.len) &&
+           (p_req->uuid.len <= sizeof(p_req->uuid.uu)) &&
+           (0 == memcmp(&p_entry->uuid.uu, &p_req->uuid.uu, p_req->uuid.len));
+}
+
+/**
+ * Function Name:
+ * app_bt_read_cache_has_excluded
+ *
+ * Function Description:
+ * @brief  Checks whether the response to a request would hold an excluded
+ *         attribute, searching the GATT database for the attributes of the
+ *         requested type in the range
+ *
+ * @param p_req          read-by-type request
+ *
+ * @return bool  true when an excluded attribute matches the request
+ */
+static bool app_bt_read_cache_has_excluded(const wiced_bt_gatt_read_by_type_t *p_req)
+{
+    wiced_bt_uuid_t uuid = p_req->uuid;
+    uint16_t handle;
+
+    for (uint8_t i = 0; i < read_cache_excluded_count; i++)
+    {
+        handle = read_cache_excluded[i];
+        if ((handle >= p_req->s_handle) && (handle <= p_req->e_handle) &&
+            (handle == wiced_bt_gatt_find_handle_by_type(handle, handle, &uuid)))
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * Function Name:
+ * app_bt_read_cache_lookup
+ *
+ * Function Description:
+ * @brief  Finds the cached response to a read-by-type request. A successful
+ *         response returned here is counted as in flight until
+ *         app_bt_read_cache_release is called with its data.
+ *
+ * @param p_req          read-by-type request
+ * @param len_requested  largest response the client accepts
+ *
+ * @return app_bt_read_cache_entry_t*  cached response, NULL on a miss
+ */
+app_bt_read_cache_entry_t *app_bt_read_cache_lookup(const wiced_bt_gatt_read_by_type_t *p_req,
+                                                    uint16_t len_requested)
+{
+    app_bt_read_cache_entry_t *p_entry;
+
+    for (uint8_t i = 0; i < APP_BT_READ_CACHE_ENTRIES; i++)
+    {
+        p_entry = &read_cache[i];
+        if (p_entry->valid && app_bt_read_cache_matches(p_entry, p_req, len_requested))
+        {
+            if (WICED_BT_GATT_SUCCESS == p_entry->status)
+            {
+                p_entry->in_flight++;
+            }
+            __atomic_fetch_add(&read_cache_stats.hits, 1, __ATOMIC_RELAXED);
+            return p_entry;
+        }
+    }
+
+    __atomic_fetch_add(&read_cache_stats.misses, 1, __ATOMIC_RELAXED);
+    return NULL;
+}
+
+/**
+ * Function Name:
+ * app_bt_read_cache_claim
+ *
+ * Function Description:
+ * @brief  Takes a slot to build the response to a request into. Empty slots
+ *         are used first, then valid ones in turn; slots whose response the
+ *         stack still holds are never taken. A response that would hold an
+ *         attribute excluded with app_bt_read_cache_exclude is not cached.
+ *
+ * @param p_req          read-by-type request
+ * @param len_requested  largest response the client accepts
+ *
+ * @return app_bt_read_cache_entry_t*  slot keyed to the request, NULL if the
+ *                                     response does not fit, holds an excluded
+ *                                     attribute or every slot is busy
+ */
+app_bt_read_cache_entry_t *app_bt_read_cache_claim(const wiced_bt_gatt_read_by_type_t *p_req,
+                                                   uint16_t len_requested)
+{
+    app_bt_read_cache_entry_t *p_entry = NULL;
+    uint8_t index;
+
+    if ((APP_BT_READ_CACHE_MAX_LEN >= len_requested) && (sizeof(p_req->uuid.uu) >= p_req->uuid.len) &&
+        !app_bt_read_cache_has_excluded(p_req))
+    {
+        for (uint8_t i = 0; (i < APP_BT_READ_CACHE_ENTRIES) && (NULL == p_entry); i++)
+        {
+            if (!read_cache[i].valid && (0 == read_cache[i].in_flight))
+            {
+                p_entry = &read_cache[i];
+            }
+        }
+        for (uint8_t i = 0; (i < APP_BT_READ_CACHE_ENTRIES) && (NULL == p_entry); i++)
+        {
+            index = read_cache_cursor;
+            read_cache_cursor = (read_cache_cursor + 1) % APP_BT_READ_CACHE_ENTRIES;
+            if (0 == read_cache[index].in_flight)
+            {
+                p_entry = &read_cache[index];
+            }
+        }
+    }
+
+    if (NULL == p_entry)
+    {
+        __atomic_fetch_add(&read_cache_stats.uncached, 1, __ATOMIC_RELAXED);
+        return NULL;
+    }
+
+    p_entry->valid         = 0;
+    p_entry->s_handle      = p_req->s_handle;
+    p_entry->e_handle      = p_req->e_handle;
+    p_entry->uuid          = p_req->uuid;
+    p_entry->len_requested = len_requested;
+    p_entry->len           = 0;
+    return p_entry;
+}
+
+/**
+ * Function Name:
+ * app_bt_read_cache_commit
+ *
+ * Function Description:
+ * @brief  Marks the response built into a claimed slot valid. A successful
+ *         response is counted as in flight, the caller sends it next.
+ *
+ * @param p_entry   slot returned by app_bt_read_cache_claim
+ * @param status    WICED_BT_GATT_SUCCESS or the error to return for the request
+ * @param pair_len  length of each handle-value pair
+ * @param len       bytes of response data built into the slot
+ *
+ * @return void
+ */
+void app_bt_read_cache_commit(app_bt_read_cache_entry_t *p_entry, wiced_bt_gatt_status_t status,
+                              uint8_t pair_len, uint16_t len)
+{
+    p_entry->status   = status;
+    p_entry->pair_len = pair_len;
+    p_entry->len      = len;
+    p_entry->valid    = 1;
+    if (WICED_BT_GATT_SUCCESS == status)
+    {
+        p_entry->in_flight++;
+    }
+}
+
+/**
+ * Function Name:
+ * app_bt_read_cache_release
+ *
+ * Function Description:
+ * @brief  Called once the stack has transmitted, or failed to send, a cached
+ *         response. Matches pfn_free_buffer_t so it can be passed as the
+ *         context of the send.
+ *
+ * @param p_data    data of the cached response
+ *
+ * @return void
+ */
+void app_bt_read_cache_release(uint8_t *p_data)
+{
+    for (uint8_t i = 0; i < APP_BT_READ_CACHE_ENTRIES; i++)
+    {
+        if (((uint8_t *)read_cache[i].data == p_data) && (0 != read_cache[i].in_flight))
+        {
+            read_cache[i].in_flight--;
+            return;
+        }
+    }
+}
+
+/**
+ * Function Name:
+ * app_bt_read_cache_invalidate
+ *
+ * Function Description:
+ * @brief  Drops every cached response whose handle range covers an attribute
+ *         whose value changed. A response still in flight keeps its data
+ *         until released but is not served again. Excluded attributes are
+ *         in no cached response and drop nothing.
+ *
+ * @param handle    attribute handle written
+ *
+ * @return void
+ */
+void app_bt_read_cache_invalidate(uint16_t handle)
+{
+    for (uint8_t i = 0; i < read_cache_excluded_count; i++)
+    {
+        if (read_cache_excluded[i] == handle)
+        {
+            return;
+        }
+    }
+    for (uint8_t i = 0; i < APP_BT_READ_CACHE_ENTRIES; i++)
+    {
+        if (read_cache[i].valid && (read_cache[i].s_handle <= handle) && (read_cache[i].e_handle >= handle))
+        {
+            read_cache[i].valid = 0;
+            __atomic_fetch_add(&read_cache_stats.invalidations, 1, __ATOMIC_RELAXED);
+        }
+    }
+}
+
+/**
+ * Function Name:
+ * app_bt_read_cache_exclude
+ *
+ * Function Description:
+ * @brief  Keeps the responses holding an attribute out of the cache, for
+ *         values kept per client that one client's response must not serve
+ *         to another. Must be called before the stack is initialized or
+ *         from the Bluetooth stack thread.
+ *
+ * @param handle    attribute handle
+ *
+ * @return wiced_result_t  WICED_NO_MEMORY if APP_BT_READ_CACHE_MAX_EXCLUDED
+ *                         attributes are excluded already
+ */
+wiced_result_t app_bt_read_cache_exclude(uint16_t handle)
+{
+    if (read_cache_excluded_count >= APP_BT_READ_CACHE_MAX_EXCLUDED)
+    {
+        return WICED_NO_MEMORY;
+    }
+
+    /* Drop the responses built before the exclusion */
+    app_bt_read_cache_invalidate(handle);
+    read_cache_excluded[read_cache_excluded_count++] = handle;
+    return WICED_SUCCESS;
+}
+
+/**
+ * Function Name:
+ * app_bt_read_cache_get_stats
+ *
+ * Function Description:
+ * @brief  Copies the cache counters
+ *
+ * @param p_stats    destination of the counters
+ *
+ * @return void
+ */
+void app_bt_read_cache_get_stats(app_bt_read_cache_stats_t *p_stats)
+{
+    p_stats->hits          = __atomic_load_n(&read_cache_stats.hits, __ATOMIC_RELAXED);
+    p_stats->misses        = __atomic_load_n(&read_cache_stats.misses, __ATOMIC_RELAXED);
+    p_stats->uncached      = __atomic_load_n(&read_cache_stats.uncached, __ATOMIC_RELAXED);
+    p_stats->invalidations = __atomic_load_n(&read_cache_stats.invalidations, __ATOMIC_RELAXED);
+}
+
+
+/* [] END OF FILE */
@@ -0,0 +1,116 @@
+/******************************************************************************
+* File Name:   app_bt_read_cache.h
+*
+* Description: This file contains the read-by-type response cache. Responses
+*              to attribute discovery are built once into static slots and
+*              sent from there until a value in their handle range changes.
+*
+* Related Document: See README.md
+*
+********************************************************************************
+* Copyright 2021-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef __APP_BT_READ_CACHE_H__
+#define __APP_BT_READ_CACHE_H__
+
+/******************************************************************************
+ *                                INCLUDES
+ ******************************************************************************/
+#include <stdint.h>
+#include "wiced_bt_gatt.h"
+#include "cycfg_bt_settings.h"
+
+/******************************************************************************
+ *                                Constants
+ ******************************************************************************/
+/* Number of cached responses */
+#ifndef APP_BT_READ_CACHE_ENTRIES
+#define APP_BT_READ_CACHE_ENTRIES               (6)
+#endif
+
+/* Largest response held by a slot, one ATT PDU of the largest MTU accepted */
+#ifndef APP_BT_READ_CACHE_MAX_LEN
+#define APP_BT_READ_CACHE_MAX_LEN               (CY_BT_RX_PDU_SIZE)
+#endif
+
+/* Number of attributes that can be excluded from the cache */
+#ifndef APP_BT_READ_CACHE_MAX_EXCLUDED
+#define APP_BT_READ_CACHE_MAX_EXCLUDED          (8)
+#endif
+
+/******************************************************************************
+ *                                Structures
+ ******************************************************************************/
+typedef struct
+{
+    /* Key: the request parameters the response was built for */
+    uint16_t               s_handle;
+    uint16_t               e_handle;
+    wiced_bt_uuid_t        uuid;
+    uint16_t               len_requested;
+
+    /* Response */
+    wiced_bt_gatt_status_t status;      /* WICED_BT_GATT_SUCCESS or the error returned */
+    uint8_t                pair_len;    /* length of each handle-value pair */
+    uint16_t               len;         /* bytes of data in use */
+    uint8_t                valid;       /* response matches the GATT DB */
+    uint8_t                in_flight;   /* responses handed to the stack, not transmitted yet */
+    uint32_t               data[(APP_BT_READ_CACHE_MAX_LEN + sizeof(uint32_t) - 1) / sizeof(uint32_t)];
+} app_bt_read_cache_entry_t;
+
+typedef struct
+{
+    uint32_t hits;          /* requests served from a cached response */
+    uint32_t misses;        /* requests that built a response */
+    uint32_t uncached;      /* misses not cached: no free slot or an excluded attribute */
+    uint32_t invalidations; /* cached responses dropped after a value change */
+} app_bt_read_cache_stats_t;
+
+/****************************************************************************
+ *                              FUNCTION DECLARATIONS
+ ***************************************************************************/
+app_bt_read_cache_entry_t *app_bt_read_cache_lookup(const wiced_bt_gatt_read_by_type_t *p_req,
+                                                    uint16_t len_requested);
+app_bt_read_cache_entry_t *app_bt_read_cache_claim(const wiced_bt_gatt_read_by_type_t *p_req,
+                                                   uint16_t len_requested);
+void app_bt_read_cache_commit(app_bt_read_cache_entry_t *p_entry, wiced_bt_gatt_status_t status,
+                              uint8_t pair_len, uint16_t len);
+void app_bt_read_cache_release(uint8_t *p_data);
+void app_bt_read_cache_invalidate(uint16_t handle);
+wiced_result_t app_bt_read_cache_exclude(uint16_t handle);
+void app_bt_read_cache_get_stats(app_bt_read_cache_stats_t *p_stats);
+
+#endif      /* __APP_BT_READ_CACHE_H__ */
+
+
+/* [] END OF FILE */
@@ -0,0 +1,406 @@
+/******************************************************************************
+* File Name:   app_bt_sink.c
+*
+* Description: This file contains the streaming sink of the WriteMe
+*              characteristic. Written values are passed straight from the
+*              stack buffer to the registered consumers without being
+*              staged in the GATT attribute table.
+*
+* Related Document: See README.md
+*
+********************************************************************************
+* Copyright 2021-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/******************************************************************************
+ *                                INCLUDES
+ ******************************************************************************/
+#include <stdio.h>
+#include <string.h>
+#include "app_bt_sink.h"
+#include "app_bt_conn.h"
+#include "app_bt_buffer_pool.h"
+
+/******************************************************************************
+ *                                Structures
+ ******************************************************************************/
+typedef struct
+{
+    app_bt_sink_consumer_t  p_consumer;
+    void                   *p_ctx;
+} app_bt_sink_entry_t;
+
+/******************************************************************************
+ *                                Variable Definitions
+ ******************************************************************************/
+/* Registered consumers. Registration and consumption both run in the
+ * Bluetooth stack thread, so no locking is needed */
+static app_bt_sink_entry_t sink_consumers[APP_BT_SINK_MAX_CONSUMERS];
+static uint8_t sink_consumer_count;
+
+#if APP_TPUT_SINK_VALIDATOR
+/* Reference of the built-in validator, 0 to 255 */
+static uint8_t sink_validator_ref[256];
+static app_bt_sink_validator_t sink_validator;
+#endif
+
+#if APP_TPUT_SINK_FORWARDER
+_Static_assert((APP_TPUT_SINK_FORWARDER_QUEUE_LENGTH >= 1) &&
+               (APP_TPUT_SINK_FORWARDER_QUEUE_LENGTH <= APP_BT_POOL_MTU_BLOCK_COUNT / 2),
+               "Forwarder queue must leave MTU-class blocks to the GATT responses");
+
+/* Queue of the built-in forwarder and the values drained from it */
+static cy_queue_t sink_forwarder_queue;
+static app_bt_sink_forwarder_t sink_forwarder;
+static volatile uint32_t sink_drained;
+#endif
+
+/****************************************************************************
+ *                              FUNCTION DEFINITIONS
+ ***************************************************************************/
+
+/**
+ * Function Name:
+ * app_bt_sink_init
+ *
+ * Function Description:
+ * @brief  Registers the byte counter, the frame checker and the validator
+ *         and forwarder enabled by APP_TPUT_SINK_VALIDATOR and
+ *         APP_TPUT_SINK_FORWARDER. Must be called from the Bluetooth stack
+ *         thread or before the stack is initialized.
+ *
+ * @return void
+ */
+void app_bt_sink_init(void)
+{
+    app_bt_sink_register(app_bt_sink_counter, NULL);
+    app_bt_sink_register(app_bt_sink_frame_checker, NULL);
+
+#if APP_TPUT_SINK_VALIDATOR
+    for (uint16_t i = 0; i < sizeof(sink_validator_ref); i++)
+    {
+        sink_validator_ref[i] = (uint8_t)i;
+    }
+    sink_validator.p_ref = sink_validator_ref;
+    sink_validator.ref_len = sizeof(sink_validator_ref);
+    app_bt_sink_register(app_bt_sink_validator, &sink_validator);
+#endif
+
+#if APP_TPUT_SINK_FORWARDER
+    if (CY_RSLT_SUCCESS != cy_rtos_queue_init(&sink_forwarder_queue, APP_TPUT_SINK_FORWARDER_QUEUE_LENGTH,
+                                              sizeof(app_bt_sink_item_t)))
+    {
+        printf("Sink forwarder queue initialization failed\n");
+        return;
+    }
+    sink_forwarder.p_queue = &sink_forwarder_queue;
+    app_bt_sink_register(app_bt_sink_forwarder, &sink_forwarder);
+#endif
+}
+
+/**
+ * Function Name:
+ * app_bt_sink_drain
+ *
+ * Function Description:
+ * @brief  Receiver of the built-in forwarder: releases the values queued
+ *         since the previous call. Does nothing unless
+ *         APP_TPUT_SINK_FORWARDER is 1.
+ *
+ * @return void
+ */
+void app_bt_sink_drain(void)
+{
+#if APP_TPUT_SINK_FORWARDER
+    app_bt_sink_item_t item;
+
+    if (NULL == sink_forwarder.p_queue)
+    {
+        return;
+    }
+    while (CY_RSLT_SUCCESS == cy_rtos_queue_get(&sink_forwarder_queue, &item, 0))
+    {
+        app_bt_buffer_pool_free(item.p_buf);
+        sink_drained++;
+    }
+#endif
+}
+
+/**
+ * Function Name:
+ * app_bt_sink_get_stats
+ *
+ * Function Description:
+ * @brief  Returns the counters of the built-in validator and forwarder. The
+ *         counters of a consumer that is not enabled read 0.
+ *
+ * @param p_stats    counters, filled in
+ *
+ * @return void
+ */
+void app_bt_sink_get_stats(app_bt_sink_stats_t *p_stats)
+{
+    memset(p_stats, 0, sizeof(*p_stats));
+#if APP_TPUT_SINK_VALIDATOR
+    p_stats->checked = sink_validator.checked;
+    p_stats->mismatches = sink_validator.mismatches;
+#endif
+#if APP_TPUT_SINK_FORWARDER
+    p_stats->forwarded = sink_forwarder.forwarded;
+    p_stats->dropped = sink_forwarder.dropped;
+    p_stats->drained = sink_drained;
+#endif
+}
+
+/**
+ * Function Name:
+ * app_bt_sink_register
+ *
+ * Function Description:
+ * @brief  Registers a consumer of the written values. Registering the same
+ *         consumer and context again has no effect. Must be called from the
+ *         Bluetooth stack thread or before the stack is initialized.
+ *
+ * @param p_consumer    consumer function
+ * @param p_ctx         context passed to the consumer
+ *
+ * @return wiced_result_t  WICED_NO_MEMORY if all consumer slots are used
+ */
+wiced_result_t app_bt_sink_register(app_bt_sink_consumer_t p_consumer, void *p_ctx)
+{
+    if (NULL == p_consumer)
+    {
+        return WICED_BADARG;
+    }
+    for (uint8_t i = 0; i < sink_consumer_count; i++)
+    {
+        if ((sink_consumers[i].p_consumer == p_consumer) && (sink_consumers[i].p_ctx == p_ctx))
+        {
+            /* Already registered */
+            return WICED_SUCCESS;
+        }
+    }
+    if (sink_consumer_count >= APP_BT_SINK_MAX_CONSUMERS)
+    {
+        return WICED_NO_MEMORY;
+    }
+    sink_consumers[sink_consumer_count].p_consumer = p_consumer;
+    sink_consumers[sink_consumer_count].p_ctx = p_ctx;
+    sink_consumer_count++;
+    return WICED_SUCCESS;
+}
+
+/**
+ * Function Name:
+ * app_bt_sink_unregister
+ *
+ * Function Description:
+ * @brief  Removes a consumer registered with app_bt_sink_register(). Must be
+ *         called from the Bluetooth stack thread.
+ *
+ * @param p_consumer    consumer function
+ * @param p_ctx         context it was registered with
+ *
+ * @return void
+ */
+void app_bt_sink_unregister(app_bt_sink_consumer_t p_consumer, void *p_ctx)
+{
+    for (uint8_t i = 0; i < sink_consumer_count; i++)
+    {
+        if ((sink_consumers[i].p_consumer == p_consumer) && (sink_consumers[i].p_ctx == p_ctx))
+        {
+            sink_consumer_count--;
+            sink_consumers[i] = sink_consumers[sink_consumer_count];
+            return;
+        }
+    }
+}
+
+/**
+ * Function Name:
+ * app_bt_sink_consume
+ *
+ * Function Description:
+ * @brief  Passes a written value to every registered consumer
+ *
+ * @param conn_id    Connection ID of the client writing the value
+ * @param p_data     written value, in the stack buffer
+ * @param len        length of the value
+ *
+ * @return void
+ */
+void app_bt_sink_consume(uint16_t conn_id, const uint8_t *p_data, uint16_t len)
+{
+    for (uint8_t i = 0; i < sink_consumer_count; i++)
+    {
+        sink_consumers[i].p_consumer(conn_id, p_data, len, sink_consumers[i].p_ctx);
+    }
+}
+
+/**
+ * Function Name:
+ * app_bt_sink_counter
+ *
+ * Function Description:
+ * @brief  Consumer counting the received bytes and packets of each client
+ *
+ * @param conn_id    Connection ID of the client writing the value
+ * @param p_data     written value
+ * @param len        length of the value
+ * @param p_ctx      unused
+ *
+ * @return void
+ */
+void app_bt_sink_counter(uint16_t conn_id, const uint8_t *p_data, uint16_t len, void *p_ctx)
+{
+    conn_state_info_t *p_conn = app_bt_conn_find(conn_id);
+
+    if (NULL != p_conn)
+    {
+        app_tput_counter_add(&p_conn->rx_ctr, len);
+    }
+}
+
+/**
+ * Function Name:
+ * app_bt_sink_frame_checker
+ *
+ * Function Description:
+ * @brief  Consumer checking the sequence number and CRC of framed values
+ *         while framed payloads are enabled
+ *
+ * @param conn_id    Connection ID of the client writing the value
+ * @param p_data     written value
+ * @param len        length of the value
+ * @param p_ctx      unused
+ *
+ * @return void
+ */
+void app_bt_sink_frame_checker(uint16_t conn_id, const uint8_t *p_data, uint16_t len, void *p_ctx)
+{
+    conn_state_info_t *p_conn;
+
+    if (!app_tput_frame_is_enabled())
+    {
+        return;
+    }
+    p_conn = app_bt_conn_find(conn_id);
+    if (NULL != p_conn)
+    {
+        app_tput_frame_receive(&p_conn->rx_frame, p_data, len);
+    }
+}
+
+/**
+ * Function Name:
+ * app_bt_sink_validator
+ *
+ * Function Description:
+ * @brief  Consumer comparing every value against a reference pattern
+ *
+ * @param conn_id    Connection ID of the client writing the value
+ * @param p_data     written value
+ * @param len        length of the value
+ * @param p_ctx      app_bt_sink_validator_t
+ *
+ * @return void
+ */
+void app_bt_sink_validator(uint16_t conn_id, const uint8_t *p_data, uint16_t len, void *p_ctx)
+{
+    app_bt_sink_validator_t *p_validator = (app_bt_sink_validator_t *)p_ctx;
+    uint16_t offset = 0;
+    uint16_t chunk;
+
+    if ((NULL == p_validator->p_ref) || (0 == p_validator->ref_len))
+    {
+        return;
+    }
+
+    p_validator->checked++;
+    while (offset < len)
+    {
+        chunk = len - offset;
+        if (chunk > p_validator->ref_len)
+        {
+            chunk = p_validator->ref_len;
+        }
+        if (0 != memcmp(&p_data[offset], p_validator->p_ref, chunk))
+        {
+            p_validator->mismatches++;
+            return;
+        }
+        offset += chunk;
+    }
+}
+
+/**
+ * Function Name:
+ * app_bt_sink_forwarder
+ *
+ * Function Description:
+ * @brief  Consumer copying every value to a buffer pool block and queueing
+ *         it for another task. Values are dropped rather than blocking the
+ *         stack thread when the queue or the pool is full.
+ *
+ * @param conn_id    Connection ID of the client writing the value
+ * @param p_data     written value
+ * @param len        length of the value
+ * @param p_ctx      app_bt_sink_forwarder_t
+ *
+ * @return void
+ */
+void app_bt_sink_forwarder(uint16_t conn_id, const uint8_t *p_data, uint16_t len, void *p_ctx)
+{
+    app_bt_sink_forwarder_t *p_forwarder = (app_bt_sink_forwarder_t *)p_ctx;
+    app_bt_sink_item_t item;
+
+    item.p_buf = app_bt_buffer_pool_alloc(len);
+    if (NULL == item.p_buf)
+    {
+        p_forwarder->dropped++;
+        return;
+    }
+    memcpy(item.p_buf, p_data, len);
+    item.len = len;
+    item.conn_id = conn_id;
+
+    if (CY_RSLT_SUCCESS != cy_rtos_queue_put(p_forwarder->p_queue, &item, 0))
+    {
+        app_bt_buffer_pool_free(item.p_buf);
+        p_forwarder->dropped++;
+        return;
+    }
+    p_forwarder->forwarded++;
+}
+
+
+/* [] END OF FILE */
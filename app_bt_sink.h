@@ -0,0 +1,126 @@
+/******************************************************************************
+* File Name:   app_bt_sink.h
+*
+* Description: This file contains the streaming sink of the WriteMe
+*              characteristic. Written values are passed straight from the
+*              stack buffer to the registered consumers without being
+*              staged in the GATT attribute table.
+*
+* Related Document: See README.md
+*
+********************************************************************************
+* Copyright 2021-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef __APP_BT_SINK_H__
+#define __APP_BT_SINK_H__
+
+/******************************************************************************
+ *                                INCLUDES
+ ******************************************************************************/
+#include <stdint.h>
+#include "wiced_bt_dev.h"
+#include "cyabs_rtos.h"
+
+/******************************************************************************
+ *                                Constants
+ ******************************************************************************/
+/* Maximum number of consumers registered at the same time */
+#ifndef APP_BT_SINK_MAX_CONSUMERS
+#define APP_BT_SINK_MAX_CONSUMERS               (4)
+#endif
+
+/******************************************************************************
+ *                                Structures
+ ******************************************************************************/
+/* Consumer of written values. p_data is only valid during the call */
+typedef void (*app_bt_sink_consumer_t)(uint16_t conn_id, const uint8_t *p_data,
+                                       uint16_t len, void *p_ctx);
+
+/* Context of app_bt_sink_validator: compares every value against a reference
+ * pattern, repeated when the value is longer than the pattern */
+typedef struct
+{
+    const uint8_t    *p_ref;        /* expected pattern */
+    uint16_t          ref_len;      /* length of the pattern */
+    volatile uint32_t checked;      /* values compared */
+    volatile uint32_t mismatches;   /* values that differ from the pattern */
+} app_bt_sink_validator_t;
+
+/* Item queued by app_bt_sink_forwarder. The receiver releases p_buf with
+ * app_bt_buffer_pool_free() */
+typedef struct
+{
+    uint8_t          *p_buf;
+    uint16_t          len;
+    uint16_t          conn_id;
+} app_bt_sink_item_t;
+
+/* Context of app_bt_sink_forwarder: copies values to a queue of
+ * app_bt_sink_item_t for processing in another task */
+typedef struct
+{
+    cy_queue_t       *p_queue;      /* destination queue */
+    volatile uint32_t forwarded;    /* values queued */
+    volatile uint32_t dropped;      /* values dropped, queue full or no buffer */
+} app_bt_sink_forwarder_t;
+
+/* Counters of the built-in consumers enabled in app_tput_config.h */
+typedef struct
+{
+    uint32_t checked;       /* values compared by the validator */
+    uint32_t mismatches;    /* values that differ from the pattern */
+    uint32_t forwarded;     /* values queued by the forwarder */
+    uint32_t dropped;       /* values dropped by the forwarder */
+    uint32_t drained;       /* values released by app_bt_sink_drain() */
+} app_bt_sink_stats_t;
+
+/****************************************************************************
+ *                              FUNCTION DECLARATIONS
+ ***************************************************************************/
+void app_bt_sink_init(void);
+void app_bt_sink_drain(void);
+void app_bt_sink_get_stats(app_bt_sink_stats_t *p_stats);
+wiced_result_t app_bt_sink_register(app_bt_sink_consumer_t p_consumer, void *p_ctx);
+void app_bt_sink_unregister(app_bt_sink_consumer_t p_consumer, void *p_ctx);
+void app_bt_sink_consume(uint16_t conn_id, const uint8_t *p_data, uint16_t len);
+
+/* Built-in consumers */
+void app_bt_sink_counter(uint16_t conn_id, const uint8_t *p_data, uint16_t len, void *p_ctx);
+void app_bt_sink_frame_checker(uint16_t conn_id, const uint8_t *p_data, uint16_t len, void *p_ctx);
+void app_bt_sink_validator(uint16_t conn_id, const uint8_t *p_data, uint16_t len, void *p_ctx);
+void app_bt_sink_forwarder(uint16_t conn_id, const uint8_t *p_data, uint16_t len, void *p_ctx);
+
+#endif      /* __APP_BT_SINK_H__ */
+
+
+/* [] END OF FILE */
@@ -0,0 +1,251 @@
+/******************************************************************************
+* File Name:   app_log.c
+*
+* Description: This file contains the deferred logging ring. Records are
+*              claimed with a compare-and-swap on the write index and
+*              published with a per-slot sequence number, so any number of
+*              producers, including interrupts, can log without a lock while
+*              the single drain task formats the records with printf.
+*
+* Related Document: See README.md
+*
+********************************************************************************
+* Copyright 2021-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/******************************************************************************
+ *                                INCLUDES
+ ******************************************************************************/
+#include <stdbool.h>
+#include <stdio.h>
+#include "cyabs_rtos.h"
+#include "app_log.h"
+
+/******************************************************************************
+ *                                Constants
+ ******************************************************************************/
+#define APP_LOG_RING_MASK                (APP_LOG_RING_SIZE - 1u)
+
+#if (APP_LOG_RING_SIZE & APP_LOG_RING_MASK) != 0
+#error "APP_LOG_RING_SIZE must be a power of two"
+#endif
+
+/******************************************************************************
+ *                                Structures
+ ******************************************************************************/
+typedef struct
+{
+    volatile uint32_t seq;          /* slot sequence, equals the write index when free */
+    uint32_t          timestamp;    /* RTOS time in milliseconds */
+    uint32_t          id;           /* app_log_id_t */
+    uint32_t          args[3];      /* event arguments */
+} app_log_record_t;
+
+/******************************************************************************
+ *                                Variable Definitions
+ ******************************************************************************/
+static app_log_record_t app_log_ring[APP_LOG_RING_SIZE];
+static volatile uint32_t app_log_write_idx;
+static uint32_t app_log_read_idx;
+static volatile uint32_t app_log_dropped;
+
+static cy_thread_t app_log_task_handle;
+static uint64_t app_log_task_stack[APP_LOG_TASK_STACK_SIZE / sizeof(uint64_t)];
+
+/* Format strings of the log events */
+static const char *const app_log_fmt[APP_LOG_ID_MAX] =
+{
+    [APP_LOG_CCCD_ENABLED]            = "Notifications Enabled [conn_id %lu]\n",
+    [APP_LOG_CCCD_DISABLED]           = "Notifications Disabled [conn_id %lu]\n",
+    [APP_LOG_CCCD_INDICATIONS]        = "Indications Enabled [conn_id %lu]\n",
+    [APP_LOG_SET_VALUE_FAILED]        = "app_bt_set_value() FAILED %lu handle 0x%lx\n",
+    [APP_LOG_READ_BY_TYPE_NO_MEM]     = "No memory, len_requested: %lu!!\n",
+    [APP_LOG_READ_BY_TYPE_NO_ATTR]    = "found type but no attribute for %lu\n",
+    [APP_LOG_READ_BY_TYPE_NOT_FOUND]  = "attr not found  start_handle: 0x%04lx  end_handle: 0x%04lx  Type: 0x%04lx\n",
+    [APP_LOG_CLIENT_MTU]              = "Client MTU: %lu [conn_id %lu]\n",
+    [APP_LOG_TPUT_NOTIFY_FAILED]      = "Throughput task notification failed 0x%lx\n",
+};
+
+/****************************************************************************
+ *                              FUNCTION DEFINITIONS
+ ***************************************************************************/
+
+/**
+ * Function Name:
+ * app_log_write
+ *
+ * Function Description:
+ * @brief  Records a log event. Safe to call from any task or interrupt; when
+ *         the ring is full the record is dropped and counted.
+ *
+ * @param id         log event identifier
+ * @param arg0       first argument of the event format string
+ * @param arg1       second argument of the event format string
+ * @param arg2       third argument of the event format string
+ *
+ * @return void
+ */
+void app_log_write(app_log_id_t id, uint32_t arg0, uint32_t arg1, uint32_t arg2)
+{
+    app_log_record_t *p_rec;
+    uint32_t pos = __atomic_load_n(&app_log_write_idx, __ATOMIC_RELAXED);
+    int32_t diff;
+    cy_time_t now = 0;
+
+    while (true)
+    {
+        p_rec = &app_log_ring[pos & APP_LOG_RING_MASK];
+        diff = (int32_t)(__atomic_load_n(&p_rec->seq, __ATOMIC_ACQUIRE) - pos);
+        if (0 == diff)
+        {
+            /* Slot is free, try to claim it */
+            if (__atomic_compare_exchange_n(&app_log_write_idx, &pos, pos + 1u,
+                                            false, __ATOMIC_RELAXED, __ATOMIC_RELAXED))
+            {
+                break;
+            }
+        }
+        else if (diff < 0)
+        {
+            /* Slot still holds a record the drain task has not consumed */
+            __atomic_fetch_add(&app_log_dropped, 1u, __ATOMIC_RELAXED);
+            return;
+        }
+        else
+        {
+            pos = __atomic_load_n(&app_log_write_idx, __ATOMIC_RELAXED);
+        }
+    }
+
+    cy_rtos_get_time(&now);
+    p_rec->timestamp = now;
+    p_rec->id = id;
+    p_rec->args[0] = arg0;
+    p_rec->args[1] = arg1;
+    p_rec->args[2] = arg2;
+
+    /* Publish the record to the drain task */
+    __atomic_store_n(&p_rec->seq, pos + 1u, __ATOMIC_RELEASE);
+}
+
+/**
+ * Function Name:
+ * app_log_get_dropped
+ *
+ * Function Description:
+ * @brief  Returns the number of records dropped because the ring was full
+ *
+ * @return uint32_t  dropped record count
+ */
+uint32_t app_log_get_dropped(void)
+{
+    return __atomic_load_n(&app_log_dropped, __ATOMIC_RELAXED);
+}
+
+/**
+ * Function Name:
+ * app_log_task
+ *
+ * Function Description:
+ * @brief  Low priority task that formats the logged records to the debug UART
+ *
+ * @param  cy_thread_arg_t: unused
+ *
+ * @return void
+ */
+static void app_log_task(cy_thread_arg_t arg)
+{
+    app_log_record_t *p_rec;
+    uint32_t dropped, reported_dropped = 0;
+
+    while (true)
+    {
+        p_rec = &app_log_ring[app_log_read_idx & APP_LOG_RING_MASK];
+        if (__atomic_load_n(&p_rec->seq, __ATOMIC_ACQUIRE) != (app_log_read_idx + 1u))
+        {
+            dropped = app_log_get_dropped();
+            if (dropped != reported_dropped)
+            {
+                printf("[log] %lu records dropped\n", (unsigned long)(dropped - reported_dropped));
+                reported_dropped = dropped;
+            }
+            cy_rtos_delay_milliseconds(APP_LOG_DRAIN_PERIOD_MS);
+            continue;
+        }
+
+        if (p_rec->id < APP_LOG_ID_MAX)
+        {
+            printf("[%8lu] ", (unsigned long)p_rec->timestamp);
+            printf(app_log_fmt[p_rec->id], (unsigned long)p_rec->args[0],
+                   (unsigned long)p_rec->args[1], (unsigned long)p_rec->args[2]);
+        }
+
+        /* Hand the slot back to the producers for the next lap of the ring */
+        __atomic_store_n(&p_rec->seq, app_log_read_idx + APP_LOG_RING_SIZE, __ATOMIC_RELEASE);
+        app_log_read_idx++;
+    }
+}
+
+/**
+ * Function Name:
+ * app_log_init
+ *
+ * Function Description:
+ * @brief  Prepares the log ring and creates the drain task. Records written
+ *         before the task runs are kept in the ring.
+ *
+ * @return void
+ */
+void app_log_init(void)
+{
+    cy_rslt_t result;
+
+    for (uint32_t i = 0; i < APP_LOG_RING_SIZE; i++)
+    {
+        app_log_ring[i].seq = i;
+    }
+
+    result = cy_rtos_thread_create(&app_log_task_handle,
+                                   &app_log_task,
+                                   APP_LOG_TASK_NAME,
+                                   &app_log_task_stack,
+                                   sizeof(app_log_task_stack),
+                                   CY_RTOS_PRIORITY_LOW,
+                                   0);
+    if (result != CY_RSLT_SUCCESS)
+    {
+        printf("Log task creation failed 0x%lX\n", (unsigned long)result);
+    }
+}
+
+
+/* [] END OF FILE */
@@ -0,0 +1,97 @@
+/******************************************************************************
+* File Name:   app_log.h
+*
+* Description: This file contains the deferred logging interface. Hot paths
+*              (Bluetooth stack callbacks, timer interrupts, the notification
+*              task) record compact binary events into a lock-free ring; a
+*              low priority task formats them to the debug UART later.
+*
+* Related Document: See README.md
+*
+********************************************************************************
+* Copyright 2021-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef __APP_LOG_H__
+#define __APP_LOG_H__
+
+/******************************************************************************
+ *                                INCLUDES
+ ******************************************************************************/
+#include <stdint.h>
+
+/******************************************************************************
+ *                                Constants
+ ******************************************************************************/
+/* Number of records held by the ring, must be a power of two */
+#ifndef APP_LOG_RING_SIZE
+#define APP_LOG_RING_SIZE                       (64)
+#endif
+
+/* Period at which the drain task polls the ring when it is empty */
+#ifndef APP_LOG_DRAIN_PERIOD_MS
+#define APP_LOG_DRAIN_PERIOD_MS                 (20)
+#endif
+
+#define APP_LOG_TASK_NAME                       "Log Task"
+#define APP_LOG_TASK_STACK_SIZE                 (2048)
+
+/******************************************************************************
+ *                                Enumerations
+ ******************************************************************************/
+/* Log event identifiers. The format string of each event is defined in
+ * app_log.c and receives the three record arguments as unsigned long. */
+typedef enum
+{
+    APP_LOG_CCCD_ENABLED,
+    APP_LOG_CCCD_DISABLED,
+    APP_LOG_CCCD_INDICATIONS,
+    APP_LOG_SET_VALUE_FAILED,
+    APP_LOG_READ_BY_TYPE_NO_MEM,
+    APP_LOG_READ_BY_TYPE_NO_ATTR,
+    APP_LOG_READ_BY_TYPE_NOT_FOUND,
+    APP_LOG_CLIENT_MTU,
+    APP_LOG_TPUT_NOTIFY_FAILED,
+    APP_LOG_ID_MAX
+} app_log_id_t;
+
+/****************************************************************************
+ *                              FUNCTION DECLARATIONS
+ ***************************************************************************/
+void app_log_init(void);
+void app_log_write(app_log_id_t id, uint32_t arg0, uint32_t arg1, uint32_t arg2);
+uint32_t app_log_get_dropped(void);
+
+#endif      /* __APP_LOG_H__ */
+
+
+/* [] END OF FILE */
@@ -0,0 +1,382 @@
+/******************************************************************************
+* File Name:   app_tput_autotune.c
+*
+* Description: This file contains the automatic tuning of a connection.
+*              The PHY, the connection interval and the notification burst
+*              are swept one after the other, keeping the best value of
+*              each, and the measured throughput of every step is logged.
+*
+* Related Document: See README.md
+*
+********************************************************************************
+* Copyright 2021-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/******************************************************************************
+ *                                INCLUDES
+ ******************************************************************************/
+#include <stdio.h>
+#include "app_tput_autotune.h"
+#include "app_tput_ctrl.h"
+#include "app_bt_conn.h"
+
+/******************************************************************************
+ *                                Constants
+ ******************************************************************************/
+/* Parameters swept, in order */
+#define APP_TPUT_AUTOTUNE_STAGE_PHY             (0)
+#define APP_TPUT_AUTOTUNE_STAGE_INTERVAL        (1)
+#define APP_TPUT_AUTOTUNE_STAGE_BURST           (2)
+#define APP_TPUT_AUTOTUNE_STAGES                (3)
+
+/* Longest Control command sequence built for a step: PHY, interval, burst */
+#define APP_TPUT_AUTOTUNE_CMD_LEN               (2 + 3 + 2)
+
+/******************************************************************************
+ *                                Variable Definitions
+ ******************************************************************************/
+static const uint8_t autotune_phys[APP_TPUT_AUTOTUNE_PHY_STEPS] =
+{
+    BTM_BLE_PREFER_2M_PHY, BTM_BLE_PREFER_1M_PHY
+};
+
+/* 15, 30, 35, 50 and 100 ms */
+static const uint16_t autotune_intervals[APP_TPUT_AUTOTUNE_INTERVAL_STEPS] =
+{
+    12, 24, 28, 40, 80
+};
+
+/* Adaptive pacing, then fixed bursts */
+static const uint8_t autotune_bursts[APP_TPUT_AUTOTUNE_BURST_STEPS] =
+{
+    0, 4, 8, 16
+};
+
+static const uint8_t autotune_stage_steps[APP_TPUT_AUTOTUNE_STAGES] =
+{
+    APP_TPUT_AUTOTUNE_PHY_STEPS, APP_TPUT_AUTOTUNE_INTERVAL_STEPS, APP_TPUT_AUTOTUNE_BURST_STEPS
+};
+
+/****************************************************************************
+ *                              FUNCTION DEFINITIONS
+ ***************************************************************************/
+
+/**
+ * Function Name:
+ * app_tput_autotune_set_step
+ *
+ * Function Description:
+ * @brief  Sets the parameter of the current stage to the value of a step,
+ *         keeping the best values found for the other parameters
+ *
+ * @param p_at       auto-tune state of the client
+ * @param step       step within the stage
+ *
+ * @return void
+ */
+static void app_tput_autotune_set_step(app_tput_autotune_t *p_at, uint8_t step)
+{
+    switch (p_at->stage)
+    {
+    case APP_TPUT_AUTOTUNE_STAGE_PHY:
+        p_at->current.phy = autotune_phys[step];
+        break;
+    case APP_TPUT_AUTOTUNE_STAGE_INTERVAL:
+        p_at->current.conn_interval = autotune_intervals[step];
+        break;
+    default:
+        p_at->current.burst = autotune_bursts[step];
+        break;
+    }
+}
+
+/**
+ * Function Name:
+ * app_tput_autotune_apply
+ *
+ * Function Description:
+ * @brief  Requests the parameters of the current configuration that differ
+ *         from the ones last requested, through the Control commands. They
+ *         are queued for notify_task like a Control write, so tput_task
+ *         neither changes the connection state nor calls the stack.
+ *
+ * @param p_conn     client
+ *
+ * @return void
+ */
+static void app_tput_autotune_apply(conn_state_info_t *p_conn)
+{
+    app_tput_autotune_t *p_at = &p_conn->autotune;
+    uint8_t cmd[APP_TPUT_AUTOTUNE_CMD_LEN];
+    uint16_t len = 0;
+
+    if (p_at->current.phy != p_at->applied.phy)
+    {
+        cmd[len++] = APP_TPUT_CTRL_CMD_PHY;
+        cmd[len++] = p_at->current.phy;
+    }
+    if (p_at->current.conn_interval != p_at->applied.conn_interval)
+    {
+        cmd[len++] = APP_TPUT_CTRL_CMD_CONN_INTERVAL;
+        cmd[len++] = (uint8_t)(p_at->current.conn_interval & 0xFF);
+        cmd[len++] = (uint8_t)(p_at->current.conn_interval >> 8);
+    }
+    if (p_at->current.burst != p_at->applied.burst)
+    {
+        cmd[len++] = APP_TPUT_CTRL_CMD_BURST;
+        cmd[len++] = p_at->current.burst;
+    }
+    if ((0 != len) && (WICED_BT_GATT_SUCCESS != app_tput_ctrl_submit(p_conn->conn_id, cmd, len)))
+    {
+        printf("Auto-tune: configuration rejected [conn_id %d]\n", p_conn->conn_id);
+    }
+    p_at->applied = p_at->current;
+}
+
+/**
+ * Function Name:
+ * app_tput_autotune_bytes
+ *
+ * Function Description:
+ * @brief  Returns the bytes transferred in both directions since connection
+ *
+ * @param p_conn     client
+ *
+ * @return uint64_t  TX + RX bytes
+ */
+static uint64_t app_tput_autotune_bytes(conn_state_info_t *p_conn)
+{
+    app_tput_counter_snapshot_t tx_snap, rx_snap;
+
+    app_tput_counter_snapshot(&p_conn->tx_ctr, &tx_snap);
+    app_tput_counter_snapshot(&p_conn->rx_ctr, &rx_snap);
+    return tx_snap.bytes + rx_snap.bytes;
+}
+
+/**
+ * Function Name:
+ * app_tput_autotune_start
+ *
+ * Function Description:
+ * @brief  Starts a sweep from the current configuration of the client
+ *
+ * @param p_conn     client
+ * @param now        current time in ms
+ *
+ * @return void
+ */
+static void app_tput_autotune_start(conn_state_info_t *p_conn, cy_time_t now)
+{
+    app_tput_autotune_t *p_at = &p_conn->autotune;
+
+    p_at->initial.phy = p_conn->ctrl.phy;
+    p_at->initial.conn_interval = p_conn->ctrl.conn_interval;
+    p_at->initial.burst = (uint8_t)p_conn->pacer.fixed_burst;
+    p_at->applied = p_at->initial;
+    p_at->current = p_at->initial;
+    p_at->stage = APP_TPUT_AUTOTUNE_STAGE_PHY;
+    p_at->step = 0;
+    p_at->best = 0;
+    p_at->best_kbps = 0;
+    p_at->results_count = 0;
+
+    printf("Auto-tune: started [conn_id %d]\n", p_conn->conn_id);
+    app_tput_autotune_set_step(p_at, 0);
+    app_tput_autotune_apply(p_conn);
+    p_at->state = APP_TPUT_AUTOTUNE_SETTLE;
+    p_at->step_time = now;
+}
+
+/**
+ * Function Name:
+ * app_tput_autotune_finish
+ *
+ * Function Description:
+ * @brief  Logs the measured configurations and the one kept
+ *
+ * @param p_conn     client
+ *
+ * @return void
+ */
+static void app_tput_autotune_finish(conn_state_info_t *p_conn)
+{
+    app_tput_autotune_t *p_at = &p_conn->autotune;
+    app_tput_autotune_result_t *p_res;
+
+    printf("Auto-tune: results [conn_id %d]\n", p_conn->conn_id);
+    printf("  PHY  interval  burst      kbps\n");
+    for (uint8_t i = 0; i < p_at->results_count; i++)
+    {
+        p_res = &p_at->results[i];
+        printf("  %3d  %8d  %5d  %8lu\n", p_res->cfg.phy, p_res->cfg.conn_interval,
+               p_res->cfg.burst, (unsigned long)p_res->kbps);
+    }
+    printf("Auto-tune: selected PHY %d, interval %d (%.2f ms), burst %d%s\n",
+           p_at->current.phy, p_at->current.conn_interval,
+           (double)(p_at->current.conn_interval * CONN_INTERVAL_MULTIPLIER),
+           p_at->current.burst, (0 == p_at->current.burst) ? " (adaptive)" : "");
+}
+
+/**
+ * Function Name:
+ * app_tput_autotune_measured
+ *
+ * Function Description:
+ * @brief  Records the throughput of the current step and moves to the next
+ *         step, the next stage with the best value of the stage kept, or
+ *         the end of the sweep
+ *
+ * @param p_conn     client
+ * @param now        current time in ms
+ *
+ * @return void
+ */
+static void app_tput_autotune_measured(conn_state_info_t *p_conn, cy_time_t now)
+{
+    app_tput_autotune_t *p_at = &p_conn->autotune;
+    uint32_t elapsed_ms = (uint32_t)(now - p_at->step_time);
+    uint64_t bytes = app_tput_autotune_bytes(p_conn) - p_at->step_bytes;
+    uint32_t kbps;
+
+    /* bytes * 8 bits / period in ms = kbps */
+    kbps = (uint32_t)((bytes * 8u) / ((0 != elapsed_ms) ? elapsed_ms : 1u));
+    if (p_at->results_count < APP_TPUT_AUTOTUNE_MAX_STEPS)
+    {
+        p_at->results[p_at->results_count].cfg = p_at->current;
+        p_at->results[p_at->results_count].kbps = kbps;
+        p_at->results_count++;
+    }
+    printf("Auto-tune: PHY %d interval %d burst %d: %lu kbps [conn_id %d]\n",
+           p_at->current.phy, p_at->current.conn_interval, p_at->current.burst,
+           (unsigned long)kbps, p_conn->conn_id);
+
+    if ((0 == p_at->step) || (kbps > p_at->best_kbps))
+    {
+        p_at->best = p_at->step;
+        p_at->best_kbps = kbps;
+    }
+
+    p_at->step++;
+    if (p_at->step >= autotune_stage_steps[p_at->stage])
+    {
+        /* Keep the best value of the stage and sweep the next parameter */
+        app_tput_autotune_set_step(p_at, p_at->best);
+        p_at->stage++;
+        p_at->step = 0;
+        p_at->best = 0;
+        p_at->best_kbps = 0;
+        if (p_at->stage >= APP_TPUT_AUTOTUNE_STAGES)
+        {
+            app_tput_autotune_apply(p_conn);
+            app_tput_autotune_finish(p_conn);
+            p_at->state = APP_TPUT_AUTOTUNE_DONE;
+            return;
+        }
+    }
+    app_tput_autotune_set_step(p_at, p_at->step);
+    app_tput_autotune_apply(p_conn);
+    p_at->state = APP_TPUT_AUTOTUNE_SETTLE;
+    p_at->step_time = now;
+}
+
+/**
+ * Function Name:
+ * app_tput_autotune_poll
+ *
+ * Function Description:
+ * @brief  Advances the sweep of every client. Called by tput_task every
+ *         statistics bucket.
+ *
+ * @param void
+ *
+ * @return void
+ */
+void app_tput_autotune_poll(void)
+{
+    conn_state_info_t *p_conn;
+    app_tput_autotune_t *p_at;
+    cy_time_t now = 0;
+    uint8_t request;
+
+    cy_rtos_get_time(&now);
+    for (uint8_t index = 0; index < APP_BT_MAX_CONNECTIONS; index++)
+    {
+        p_conn = app_bt_conn_get(index);
+        if (NULL == p_conn)
+        {
+            continue;
+        }
+        p_at = &p_conn->autotune;
+
+        request = __atomic_exchange_n(&p_at->request, APP_TPUT_AUTOTUNE_REQ_NONE, __ATOMIC_ACQUIRE);
+        if (APP_TPUT_AUTOTUNE_REQ_START == request)
+        {
+            app_tput_autotune_start(p_conn, now);
+            continue;
+        }
+        if ((APP_TPUT_AUTOTUNE_REQ_ABORT == request) &&
+            ((APP_TPUT_AUTOTUNE_SETTLE == p_at->state) || (APP_TPUT_AUTOTUNE_MEASURE == p_at->state)))
+        {
+            /* Return to the configuration the sweep started from */
+            p_at->current = p_at->initial;
+            app_tput_autotune_apply(p_conn);
+            p_at->state = APP_TPUT_AUTOTUNE_IDLE;
+            printf("Auto-tune: aborted [conn_id %d]\n", p_conn->conn_id);
+            continue;
+        }
+
+        switch (p_at->state)
+        {
+        case APP_TPUT_AUTOTUNE_SETTLE:
+            if ((uint32_t)(now - p_at->step_time) >= APP_TPUT_AUTOTUNE_SETTLE_MS)
+            {
+                p_at->step_bytes = app_tput_autotune_bytes(p_conn);
+                p_at->step_time = now;
+                p_at->state = APP_TPUT_AUTOTUNE_MEASURE;
+            }
+            break;
+
+        case APP_TPUT_AUTOTUNE_MEASURE:
+            if ((uint32_t)(now - p_at->step_time) >= APP_TPUT_AUTOTUNE_MEASURE_MS)
+            {
+                app_tput_autotune_measured(p_conn, now);
+            }
+            break;
+
+        default:
+            break;
+        }
+    }
+}
+
+
+/* [] END OF FILE */
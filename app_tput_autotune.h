@@ -0,0 +1,143 @@
+/******************************************************************************
+* File Name:   app_tput_autotune.h
+*
+* Description: This file contains the automatic tuning of a connection.
+*              The PHY, the connection interval and the notification burst
+*              are swept one after the other, keeping the best value of
+*              each, and the measured throughput of every step is logged.
+*
+* Related Document: See README.md
+*
+********************************************************************************
+* Copyright 2021-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef __APP_TPUT_AUTOTUNE_H__
+#define __APP_TPUT_AUTOTUNE_H__
+
+/******************************************************************************
+ *                                INCLUDES
+ ******************************************************************************/
+#include <stdint.h>
+#include "wiced_bt_dev.h"
+#include "cyabs_rtos.h"
+#include "app_tput_config.h"
+
+/******************************************************************************
+ *                                Constants
+ ******************************************************************************/
+/* Time given to a new configuration to take effect before it is measured */
+#ifndef APP_TPUT_AUTOTUNE_SETTLE_MS
+#define APP_TPUT_AUTOTUNE_SETTLE_MS             (1500)
+#endif
+
+/* Time over which the throughput of a configuration is measured */
+#ifndef APP_TPUT_AUTOTUNE_MEASURE_MS
+#define APP_TPUT_AUTOTUNE_MEASURE_MS            (3000)
+#endif
+
+/* Start auto-tuning when a client enables notifications */
+#ifndef APP_TPUT_AUTOTUNE_ON_CONNECT
+#define APP_TPUT_AUTOTUNE_ON_CONNECT            (0)
+#endif
+
+/* Steps of a sweep: PHYs, then connection intervals, then bursts */
+#define APP_TPUT_AUTOTUNE_PHY_STEPS             (2)
+#define APP_TPUT_AUTOTUNE_INTERVAL_STEPS        (5)
+#define APP_TPUT_AUTOTUNE_BURST_STEPS           (4)
+#define APP_TPUT_AUTOTUNE_MAX_STEPS             (APP_TPUT_AUTOTUNE_PHY_STEPS + \
+                                                 APP_TPUT_AUTOTUNE_INTERVAL_STEPS + \
+                                                 APP_TPUT_AUTOTUNE_BURST_STEPS)
+
+/******************************************************************************
+ *                                Enumerations
+ ******************************************************************************/
+typedef enum
+{
+    APP_TPUT_AUTOTUNE_REQ_NONE,
+    APP_TPUT_AUTOTUNE_REQ_START,
+    APP_TPUT_AUTOTUNE_REQ_ABORT,
+} app_tput_autotune_req_t;
+
+typedef enum
+{
+    APP_TPUT_AUTOTUNE_IDLE,             /* not started */
+    APP_TPUT_AUTOTUNE_SETTLE,           /* waiting for a configuration to take effect */
+    APP_TPUT_AUTOTUNE_MEASURE,          /* measuring a configuration */
+    APP_TPUT_AUTOTUNE_DONE,             /* best configuration applied */
+} app_tput_autotune_state_t;
+
+/******************************************************************************
+ *                                Structures
+ ******************************************************************************/
+/* One configuration of the sweep */
+typedef struct
+{
+    uint8_t  phy;                   /* BTM_BLE_PREFER_*_PHY */
+    uint8_t  burst;                 /* notifications per round, 0 for adaptive */
+    uint16_t conn_interval;         /* connection interval in 1.25 ms units */
+} app_tput_autotune_cfg_t;
+
+/* Measured configuration */
+typedef struct
+{
+    app_tput_autotune_cfg_t cfg;
+    uint32_t                kbps;   /* TX + RX throughput */
+} app_tput_autotune_result_t;
+
+/* Auto-tune state of one client, driven by tput_task */
+typedef struct
+{
+    volatile uint8_t           request;    /* app_tput_autotune_req_t, set by the Control characteristic */
+    uint8_t                    state;      /* app_tput_autotune_state_t */
+    uint8_t                    stage;      /* parameter being swept */
+    uint8_t                    step;       /* step within the stage */
+    uint8_t                    best;       /* best step of the stage */
+    uint8_t                    results_count;
+    app_tput_autotune_cfg_t    initial;    /* configuration before the sweep */
+    app_tput_autotune_cfg_t    current;    /* configuration of the step */
+    app_tput_autotune_cfg_t    applied;    /* configuration requested from the stack */
+    cy_time_t                  step_time;  /* start of the settle or measure period */
+    uint64_t                   step_bytes; /* TX + RX bytes at the start of the measure period */
+    uint32_t                   best_kbps;  /* throughput of the best step of the stage */
+    app_tput_autotune_result_t results[APP_TPUT_AUTOTUNE_MAX_STEPS];
+} app_tput_autotune_t;
+
+/****************************************************************************
+ *                              FUNCTION DECLARATIONS
+ ***************************************************************************/
+void app_tput_autotune_poll(void);
+
+#endif      /* __APP_TPUT_AUTOTUNE_H__ */
+
+
+/* [] END OF FILE */
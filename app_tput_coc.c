@@ -0,0 +1,419 @@
+/******************************************************************************
+* File Name:   app_tput_coc.c
+*
+* Description: This file contains the L2CAP LE credit based channel
+*              throughput mode. A client opens a channel on APP_TPUT_COC_PSM;
+*              the CoC task then sends SDUs of up to the channel MTU for as
+*              long as the peer grants credits, and the SDUs received from
+*              the client are counted.
+*
+* Related Document: See README.md
+*
+********************************************************************************
+* Copyright 2021-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/******************************************************************************
+ *                                INCLUDES
+ ******************************************************************************/
+#include <stdio.h>
+#include "wiced_bt_l2c.h"
+#include "app_tput_coc.h"
+#include "app_bt_conn.h"
+
+/******************************************************************************
+ *                                Constants
+ ******************************************************************************/
+/* Time the CoC task sleeps while no channel is sending, so that a test run
+ * started through the Control characteristic is picked up */
+#define APP_TPUT_COC_IDLE_MS                    (100)
+
+/******************************************************************************
+ *                                Variable Definitions
+ ******************************************************************************/
+static cy_thread_t coc_task_handle;
+static uint64_t coc_task_stack[APP_TPUT_COC_TASK_STACK_SIZE / sizeof(uint64_t)];
+
+/* SDU sent on every channel, copied by the stack on each write */
+static uint8_t coc_sdu[APP_TPUT_COC_MTU];
+
+/****************************************************************************
+ *                              FUNCTION DEFINITIONS
+ ***************************************************************************/
+
+/**
+ * Function Name:
+ * app_tput_coc_find
+ *
+ * Function Description:
+ * @brief  Finds the client owning an L2CAP channel
+ *
+ * @param cid        local channel ID
+ *
+ * @return conn_state_info_t*  client, NULL if no client owns the channel
+ */
+static conn_state_info_t *app_tput_coc_find(uint16_t cid)
+{
+    conn_state_info_t *p_conn;
+
+    for (uint8_t index = 0; index < APP_BT_MAX_CONNECTIONS; index++)
+    {
+        p_conn = app_bt_conn_get(index);
+        if ((NULL != p_conn) && (cid == p_conn->coc.cid))
+        {
+            return p_conn;
+        }
+    }
+    return NULL;
+}
+
+/**
+ * Function Name:
+ * app_tput_coc_sdu_size
+ *
+ * Function Description:
+ * @brief  Returns the SDU size sent on a channel, the smaller of the local
+ *         and peer MTUs
+ *
+ * @param p_coc      channel of the client
+ *
+ * @return uint16_t  SDU size in bytes
+ */
+uint16_t app_tput_coc_sdu_size(const app_tput_coc_t *p_coc)
+{
+    return (p_coc->peer_mtu < APP_TPUT_COC_MTU) ? p_coc->peer_mtu : APP_TPUT_COC_MTU;
+}
+
+/**
+ * Function Name:
+ * app_tput_coc_connect_ind
+ *
+ * Function Description:
+ * @brief  Accepts the channel a connected client opens, one per client
+ *
+ * @param context    unused
+ * @param bd_addr    address of the client
+ * @param local_cid  local channel ID
+ * @param psm        PSM the client connects to
+ * @param id         signalling identifier of the request
+ * @param mtu_peer   MTU of the client
+ *
+ * @return void
+ */
+static void app_tput_coc_connect_ind(void *context, wiced_bt_device_address_t bd_addr,
+                                     uint16_t local_cid, uint16_t psm, uint8_t id, uint16_t mtu_peer)
+{
+    conn_state_info_t *p_conn = app_bt_conn_find_by_bda(bd_addr);
+
+    if ((NULL == p_conn) || (0 != p_conn->coc.cid))
+    {
+        wiced_bt_l2cap_le_connect_rsp(bd_addr, id, local_cid, L2CAP_LE_RESULT_NO_RESOURCES, APP_TPUT_COC_MTU);
+        return;
+    }
+
+    p_conn->coc.peer_mtu = mtu_peer;
+    p_conn->coc.congested = WICED_FALSE;
+    p_conn->coc.outstanding = 0;
+    if (!wiced_bt_l2cap_le_connect_rsp(bd_addr, id, local_cid, L2CAP_CONN_OK, APP_TPUT_COC_MTU))
+    {
+        printf("L2CAP CoC: connect response failed [conn_id %d]\n", p_conn->conn_id);
+        return;
+    }
+    p_conn->coc.cid = local_cid;
+    printf("L2CAP CoC: channel 0x%04X open, SDU %d bytes [conn_id %d]\n",
+           local_cid, app_tput_coc_sdu_size(&p_conn->coc), p_conn->conn_id);
+    cy_rtos_thread_set_notification(&coc_task_handle);
+}
+
+/**
+ * Function Name:
+ * app_tput_coc_disconnect_ind
+ *
+ * Function Description:
+ * @brief  Closes the channel of a client on request of the client
+ *
+ * @param context    unused
+ * @param local_cid  local channel ID
+ * @param ack        WICED_TRUE if the stack expects a response
+ *
+ * @return void
+ */
+static void app_tput_coc_disconnect_ind(void *context, uint16_t local_cid, wiced_bool_t ack)
+{
+    conn_state_info_t *p_conn = app_tput_coc_find(local_cid);
+
+    if (ack)
+    {
+        wiced_bt_l2cap_le_disconnect_rsp(local_cid);
+    }
+    if (NULL != p_conn)
+    {
+        p_conn->coc.cid = 0;
+        printf("L2CAP CoC: channel 0x%04X closed [conn_id %d]\n", local_cid, p_conn->conn_id);
+    }
+}
+
+/**
+ * Function Name:
+ * app_tput_coc_disconnect_cfm
+ *
+ * Function Description:
+ * @brief  Completes the closing of a channel
+ *
+ * @param context    unused
+ * @param local_cid  local channel ID
+ * @param result     result of the disconnection
+ *
+ * @return void
+ */
+static void app_tput_coc_disconnect_cfm(void *context, uint16_t local_cid, uint16_t result)
+{
+    conn_state_info_t *p_conn = app_tput_coc_find(local_cid);
+
+    if (NULL != p_conn)
+    {
+        p_conn->coc.cid = 0;
+    }
+}
+
+/**
+ * Function Name:
+ * app_tput_coc_data_ind
+ *
+ * Function Description:
+ * @brief  Counts an SDU received from a client
+ *
+ * @param context    unused
+ * @param local_cid  local channel ID
+ * @param p_data     received SDU
+ * @param len        length of the SDU
+ *
+ * @return void
+ */
+static void app_tput_coc_data_ind(void *context, uint16_t local_cid, uint8_t *p_data, uint16_t len)
+{
+    conn_state_info_t *p_conn = app_tput_coc_find(local_cid);
+
+    if (NULL != p_conn)
+    {
+        app_tput_counter_add(&p_conn->coc.rx_ctr, len);
+    }
+}
+
+/**
+ * Function Name:
+ * app_tput_coc_congestion
+ *
+ * Function Description:
+ * @brief  Tracks whether the peer has credits left for a channel
+ *
+ * @param context    unused
+ * @param local_cid  local channel ID
+ * @param congested  WICED_TRUE while the channel cannot send
+ *
+ * @return void
+ */
+static void app_tput_coc_congestion(void *context, uint16_t local_cid, wiced_bool_t congested)
+{
+    conn_state_info_t *p_conn = app_tput_coc_find(local_cid);
+
+    if (NULL == p_conn)
+    {
+        return;
+    }
+    p_conn->coc.congested = congested;
+    if (congested)
+    {
+        p_conn->coc.congestion_events++;
+    }
+    else
+    {
+        cy_rtos_thread_set_notification(&coc_task_handle);
+    }
+}
+
+/**
+ * Function Name:
+ * app_tput_coc_tx_complete
+ *
+ * Function Description:
+ * @brief  Releases the transmitted SDUs from the outstanding count and wakes
+ *         the CoC task to send more
+ *
+ * @param context    unused
+ * @param local_cid  local channel ID
+ * @param buf_count  number of SDUs transmitted
+ *
+ * @return void
+ */
+static void app_tput_coc_tx_complete(void *context, uint16_t local_cid, uint16_t buf_count)
+{
+    conn_state_info_t *p_conn = app_tput_coc_find(local_cid);
+    uint16_t outstanding;
+
+    if (NULL == p_conn)
+    {
+        return;
+    }
+    outstanding = __atomic_load_n(&p_conn->coc.outstanding, __ATOMIC_RELAXED);
+    if (buf_count > outstanding)
+    {
+        buf_count = outstanding;
+    }
+    __atomic_fetch_sub(&p_conn->coc.outstanding, buf_count, __ATOMIC_RELEASE);
+    cy_rtos_thread_set_notification(&coc_task_handle);
+}
+
+/**
+ * Function Name:
+ * app_tput_coc_task
+ *
+ * Function Description:
+ * @brief  Sends SDUs on the channel of every client running a TX test until
+ *         APP_TPUT_COC_MAX_OUTSTANDING SDUs are pending or the peer runs out
+ *         of credits, then sleeps until the stack transmits an SDU or
+ *         returns credits
+ *
+ * @param arg        unused
+ *
+ * @return void
+ */
+static void app_tput_coc_task(cy_thread_arg_t arg)
+{
+    conn_state_info_t *p_conn;
+    app_tput_coc_t *p_coc;
+    uint16_t sdu_size;
+    uint16_t cid;
+    uint8_t result;
+    uint8_t sending;
+
+    while (true)
+    {
+        sending = 0;
+        for (uint8_t index = 0; index < APP_BT_MAX_CONNECTIONS; index++)
+        {
+            p_conn = app_bt_conn_get(index);
+            if ((NULL == p_conn) || (0 == (cid = p_conn->coc.cid)) ||
+                (!p_conn->ctrl.running) || (!(p_conn->ctrl.direction & APP_TPUT_CTRL_DIR_TX)))
+            {
+                continue;
+            }
+            p_coc = &p_conn->coc;
+            sending++;
+            sdu_size = app_tput_coc_sdu_size(p_coc);
+            while ((!p_coc->congested) &&
+                   (__atomic_load_n(&p_coc->outstanding, __ATOMIC_ACQUIRE) < APP_TPUT_COC_MAX_OUTSTANDING))
+            {
+                result = wiced_bt_l2cap_le_data_write(cid, coc_sdu, sdu_size, L2CAP_FLUSHABLE_CH_BASED);
+                if (L2CAP_DATAWRITE_FAILED == result)
+                {
+                    p_coc->send_failures++;
+                    break;
+                }
+                /* A congested write is queued, the stack stops accepting more */
+                __atomic_fetch_add(&p_coc->outstanding, 1, __ATOMIC_RELAXED);
+                app_tput_counter_add(&p_coc->tx_ctr, sdu_size);
+                if (L2CAP_DATAWRITE_CONGESTED == result)
+                {
+                    /* The congestion callbacks alone own the flag, they may
+                     * have reported this congestion and its end already */
+                    break;
+                }
+            }
+        }
+        cy_rtos_thread_wait_notification((0 != sending) ? NOTIFY_BURST_DELAY_MS : APP_TPUT_COC_IDLE_MS);
+    }
+}
+
+/**
+ * Function Name:
+ * app_tput_coc_init
+ *
+ * Function Description:
+ * @brief  Fills the SDU and creates the CoC task
+ *
+ * @return void
+ */
+void app_tput_coc_init(void)
+{
+    cy_rslt_t result;
+
+    for (uint32_t i = 0; i < sizeof(coc_sdu); i++)
+    {
+        coc_sdu[i] = (uint8_t)i;
+    }
+
+    result = cy_rtos_thread_create(&coc_task_handle,
+                                   &app_tput_coc_task,
+                                   APP_TPUT_COC_TASK_NAME,
+                                   &coc_task_stack,
+                                   sizeof(coc_task_stack),
+                                   CY_RTOS_PRIORITY_NORMAL,
+                                   0);
+    if (result != CY_RSLT_SUCCESS)
+    {
+        printf("CoC task creation failed 0x%lX\n", (unsigned long)result);
+    }
+}
+
+/**
+ * Function Name:
+ * app_tput_coc_register
+ *
+ * Function Description:
+ * @brief  Registers APP_TPUT_COC_PSM with the L2CAP layer. Called once the
+ *         Bluetooth stack is enabled.
+ *
+ * @return void
+ */
+void app_tput_coc_register(void)
+{
+    static wiced_bt_l2cap_le_appl_information_t coc_appl_info =
+    {
+        .le_connect_ind_cb    = app_tput_coc_connect_ind,
+        .le_connect_cfm_cb    = NULL,
+        .disconnect_ind_cb    = app_tput_coc_disconnect_ind,
+        .disconnect_cfm_cb    = app_tput_coc_disconnect_cfm,
+        .data_ind_cb          = app_tput_coc_data_ind,
+        .congestion_status_cb = app_tput_coc_congestion,
+        .tx_complete_cb       = app_tput_coc_tx_complete,
+        .le_mps               = APP_TPUT_COC_MPS,
+    };
+
+    if (0 == wiced_bt_l2cap_le_register(APP_TPUT_COC_PSM, &coc_appl_info, NULL))
+    {
+        printf("L2CAP CoC: PSM 0x%04X registration failed\n", APP_TPUT_COC_PSM);
+    }
+}
+
+
+/* [] END OF FILE */
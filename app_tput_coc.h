@@ -0,0 +1,111 @@
+/******************************************************************************
+* File Name:   app_tput_coc.h
+*
+* Description: This file contains the definitions of the L2CAP LE credit
+*              based channel throughput mode, which moves data over an
+*              L2CAP connection oriented channel instead of GATT.
+*
+* Related Document: See README.md
+*
+********************************************************************************
+* Copyright 2021-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef __APP_TPUT_COC_H__
+#define __APP_TPUT_COC_H__
+
+/******************************************************************************
+ *                                INCLUDES
+ ******************************************************************************/
+#include <stdint.h>
+#include "wiced_bt_dev.h"
+#include "cyabs_rtos.h"
+#include "app_tput_config.h"
+#include "app_tput_counters.h"
+
+/******************************************************************************
+ *                                Constants
+ ******************************************************************************/
+/* LE PSM the client connects to, from the dynamic range 0x0080 - 0x00FF */
+#ifndef APP_TPUT_COC_PSM
+#define APP_TPUT_COC_PSM                        (0x0080)
+#endif
+
+/* Local SDU size, L2capMtuSize in design.cybt */
+#ifndef APP_TPUT_COC_MTU
+#define APP_TPUT_COC_MTU                        (512)
+#endif
+
+/* Local PDU size: a 251 octet LL PDU less the 4 byte L2CAP header */
+#ifndef APP_TPUT_COC_MPS
+#define APP_TPUT_COC_MPS                        (247)
+#endif
+
+/* SDUs handed to the stack and not yet transmitted, per channel. Sending
+ * stops at this limit or when the stack reports the channel congested
+ * because the peer ran out of credits. */
+#ifndef APP_TPUT_COC_MAX_OUTSTANDING
+#define APP_TPUT_COC_MAX_OUTSTANDING            (4)
+#endif
+
+#define APP_TPUT_COC_TASK_NAME                  "CoC Task"
+#define APP_TPUT_COC_TASK_STACK_SIZE            (1024)
+
+/******************************************************************************
+ *                                Structures
+ ******************************************************************************/
+/* L2CAP channel of one client */
+typedef struct
+{
+    volatile uint16_t     cid;              /* local channel ID, 0 while closed */
+    uint16_t              peer_mtu;         /* largest SDU the peer accepts */
+    volatile wiced_bool_t congested;        /* peer out of credits */
+    volatile uint16_t     outstanding;      /* SDUs not yet transmitted */
+    uint32_t              congestion_events;
+    uint32_t              send_failures;
+    app_tput_counter_t    tx_ctr;           /* written by the CoC task */
+    app_tput_counter_t    rx_ctr;           /* written by the Bluetooth stack thread */
+    uint64_t              reported_tx;
+    uint64_t              reported_rx;
+} app_tput_coc_t;
+
+/****************************************************************************
+ *                              FUNCTION DECLARATIONS
+ ***************************************************************************/
+void     app_tput_coc_init(void);
+void     app_tput_coc_register(void);
+uint16_t app_tput_coc_sdu_size(const app_tput_coc_t *p_coc);
+
+#endif      /* __APP_TPUT_COC_H__ */
+
+
+/* [] END OF FILE */
@@ -0,0 +1,165 @@
+/******************************************************************************
+* File Name:   app_tput_config.h
+*
+* Description: Build-time configuration of the throughput test and of the
+*              requested Bluetooth LE link. Every value can be overridden from
+*              the Makefile DEFINES (or the compiler command line) so that the
+*              same application logic can be run against different link
+*              settings without editing the source.
+*
+* Related Document: See README.md
+*
+********************************************************************************
+* Copyright 2021-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef __APP_TPUT_CONFIG_H__
+#define __APP_TPUT_CONFIG_H__
+
+/******************************************************************************
+ *                                Constants
+ ******************************************************************************/
+
+/* Maximum number of simultaneous client connections. Must match
+ * MaxClientsConnections in design.cybt */
+#ifndef APP_BT_MAX_CONNECTIONS
+#define APP_BT_MAX_CONNECTIONS                  (4)
+#endif
+
+/* Largest GATT notification payload in bytes. The payload sent on a link is
+ * sized from its negotiated ATT MTU and LE data length, up to this value */
+#ifndef NOTIFICATION_MAX_DATA_SIZE
+#define NOTIFICATION_MAX_DATA_SIZE              (509)
+#endif
+
+/* Length of the Notify characteristic value in the GATT database. Must match
+ * the ByteLength of the Notify characteristic in design.cybt */
+#ifndef APP_TPUT_NOTIFY_VALUE_LEN
+#define APP_TPUT_NOTIFY_VALUE_LEN               (495)
+#endif
+
+/* Largest notification payload sent: NOTIFICATION_MAX_DATA_SIZE, bounded by
+ * the Notify value length */
+#define APP_TPUT_NOTIFY_MAX_LEN                 ((NOTIFICATION_MAX_DATA_SIZE < APP_TPUT_NOTIFY_VALUE_LEN) ? \
+                                                 NOTIFICATION_MAX_DATA_SIZE : APP_TPUT_NOTIFY_VALUE_LEN)
+
+/* LE data length requested after connection, in octets and microseconds */
+#ifndef APP_TPUT_DLE_TX_OCTETS
+#define APP_TPUT_DLE_TX_OCTETS                  (251)
+#endif
+
+#ifndef APP_TPUT_DLE_TX_TIME
+#define APP_TPUT_DLE_TX_TIME                    (2120)
+#endif
+
+/* Initial number of notifications per burst, adapted at run time by
+ * app_tput_pacer */
+#ifndef PACKET_PER_EVENT
+#define PACKET_PER_EVENT                        (10)
+#endif
+
+/* Delay between two notification bursts in milliseconds, applied after a
+ * congested round or when the controller has no free TX buffers */
+#ifndef NOTIFY_BURST_DELAY_MS
+#define NOTIFY_BURST_DELAY_MS                   (10)
+#endif
+
+/* Requested connection interval in units of 1.25 ms */
+#ifndef CONNECTION_INTERVAL
+#define CONNECTION_INTERVAL                     (28)
+#endif
+
+/* Requested supervision timeout in units of 10 ms */
+#ifndef SUPERVISION_TIMEOUT
+#define SUPERVISION_TIMEOUT                     (1000)
+#endif
+
+/* PHY requested after connection, BTM_BLE_PREFER_1M_PHY or BTM_BLE_PREFER_2M_PHY */
+#ifndef APP_TPUT_PREFERRED_PHY
+#define APP_TPUT_PREFERRED_PHY                  (BTM_BLE_PREFER_2M_PHY)
+#endif
+
+/* Frequency of the throughput HAL timer in Hz */
+#ifndef TPUT_FREQUENCY
+#define TPUT_FREQUENCY                          (3000000)
+#endif
+
+/* Default throughput report period in seconds, can be changed at run time
+ * through the Control characteristic */
+#ifndef TPUT_REPORT_PERIOD_S
+#define TPUT_REPORT_PERIOD_S                    (5)
+#endif
+
+/* 1: WriteMe values are passed to the sink consumers without being staged
+ * in the GATT attribute table. 0: values are stored and can be read back */
+#ifndef APP_TPUT_WRITEME_SINK
+#define APP_TPUT_WRITEME_SINK                   (1)
+#endif
+
+/* 1: registers app_bt_sink_validator, which compares every WriteMe value with
+ * the byte sequence 0, 1, ..., 255 repeated and counts the mismatches */
+#ifndef APP_TPUT_SINK_VALIDATOR
+#define APP_TPUT_SINK_VALIDATOR                 (0)
+#endif
+
+/* 1: registers app_bt_sink_forwarder, which copies every WriteMe value to a
+ * queue of APP_TPUT_SINK_FORWARDER_QUEUE_LENGTH items drained by tput_task */
+#ifndef APP_TPUT_SINK_FORWARDER
+#define APP_TPUT_SINK_FORWARDER                 (0)
+#endif
+
+/* Each queued value holds a buffer pool block until tput_task drains it, once
+ * every bucket. At most half of APP_BT_POOL_MTU_BLOCK_COUNT, so that the GATT
+ * responses always find MTU-class blocks; values beyond it are dropped */
+#ifndef APP_TPUT_SINK_FORWARDER_QUEUE_LENGTH
+#define APP_TPUT_SINK_FORWARDER_QUEUE_LENGTH    (4)
+#endif
+
+/* Initial payload format, 1: framed with sequence number and CRC32
+ * (app_tput_frame.h), 0: plain pattern. Can be changed at run time with
+ * app_tput_frame_set_enabled() */
+#ifndef APP_TPUT_FRAMED_PAYLOAD
+#define APP_TPUT_FRAMED_PAYLOAD                 (0)
+#endif
+
+/* Default period of the Telemetry notifications in ms, 0 disables them. Can
+ * be changed per client through the Control characteristic */
+#ifndef APP_TPUT_TELEMETRY_PERIOD_MS
+#define APP_TPUT_TELEMETRY_PERIOD_MS            (1000)
+#endif
+
+#define CONN_INTERVAL_MULTIPLIER                (1.25f)
+
+#endif      /* __APP_TPUT_CONFIG_H__ */
+
+
+/* [] END OF FILE */
@@ -0,0 +1,331 @@
+/******************************************************************************
+* File Name:   app_tput_congestion.c
+*
+* Description: This file contains the congestion analytics. Congestion
+*              episodes are timed from GATT_CONGESTION_EVT, the controller
+*              TX buffers are sampled every statistics bucket, and each
+*              report tells whether the link, the controller buffers or
+*              the pacing limits the throughput.
+*
+* Related Document: See README.md
+*
+********************************************************************************
+* Copyright 2021-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/******************************************************************************
+ *                                INCLUDES
+ ******************************************************************************/
+#include <stdio.h>
+#include "wiced_bt_ble.h"
+#include "app_tput_congestion.h"
+
+/******************************************************************************
+ *                                Variable Definitions
+ ******************************************************************************/
+/* Written by notify_task */
+static volatile uint32_t congestion_blocked_ms;
+static uint32_t congestion_reported_blocked_ms;
+
+/* Written by tput_task */
+static uint32_t buffers_min;
+static uint32_t buffers_sum;
+static uint32_t buffers_samples;
+
+/****************************************************************************
+ *                              FUNCTION DEFINITIONS
+ ***************************************************************************/
+
+/**
+ * Function Name:
+ * app_tput_congestion_begin
+ *
+ * Function Description:
+ * @brief  Starts a congestion episode. Called in the Bluetooth stack thread
+ *         when the stack reports a client congested.
+ *
+ * @param p_cong     congestion state of the client
+ * @param tx_packets notifications sent to the client so far, modulo 2^32
+ *
+ * @return void
+ */
+void app_tput_congestion_begin(app_tput_congestion_t *p_cong, uint32_t tx_packets)
+{
+    cy_time_t now = 0;
+
+    if (p_cong->active)
+    {
+        return;
+    }
+    cy_rtos_get_time(&now);
+    p_cong->start = now;
+    p_cong->packets_before += tx_packets - p_cong->packets_at_end;
+    p_cong->episodes++;
+    __atomic_store_n(&p_cong->active, WICED_TRUE, __ATOMIC_RELEASE);
+}
+
+/**
+ * Function Name:
+ * app_tput_congestion_end
+ *
+ * Function Description:
+ * @brief  Ends the congestion episode in progress and adds its length to the
+ *         histogram. Called in the Bluetooth stack thread when the stack
+ *         reports a client no longer congested.
+ *
+ * @param p_cong     congestion state of the client
+ * @param tx_packets notifications sent to the client so far, modulo 2^32
+ *
+ * @return void
+ */
+void app_tput_congestion_end(app_tput_congestion_t *p_cong, uint32_t tx_packets)
+{
+    cy_time_t now = 0;
+    uint32_t length_ms;
+    uint32_t bucket;
+
+    if (!p_cong->active)
+    {
+        return;
+    }
+    cy_rtos_get_time(&now);
+    length_ms = (uint32_t)(now - p_cong->start);
+    bucket = (length_ms < 2u) ? 0u : (31u - (uint32_t)__builtin_clz(length_ms));
+    if (bucket >= APP_TPUT_CONGESTION_HIST_BUCKETS)
+    {
+        bucket = APP_TPUT_CONGESTION_HIST_BUCKETS - 1u;
+    }
+
+    p_cong->hist[bucket]++;
+    if (length_ms > p_cong->longest_ms)
+    {
+        p_cong->longest_ms = length_ms;
+    }
+    p_cong->packets_at_end = tx_packets;
+    /* The length is added with the episode closed so that a reader never
+     * counts it twice */
+    __atomic_store_n(&p_cong->active, WICED_FALSE, __ATOMIC_RELEASE);
+    p_cong->congested_ms += length_ms;
+}
+
+/**
+ * Function Name:
+ * app_tput_congestion_report
+ *
+ * Function Description:
+ * @brief  Returns the congestion of a client since the previous report. The
+ *         episode in progress counts towards the congested time up to now.
+ *
+ * @param p_cong     congestion state of the client
+ * @param period_ms  time since the previous report
+ * @param p_report   congestion since the previous report, filled
+ *
+ * @return void
+ */
+void app_tput_congestion_report(app_tput_congestion_t *p_cong, uint32_t period_ms,
+                                app_tput_congestion_report_t *p_report)
+{
+    cy_time_t now = 0;
+    wiced_bool_t active = __atomic_load_n(&p_cong->active, __ATOMIC_ACQUIRE);
+    uint32_t finished_ms = p_cong->congested_ms;
+    uint32_t episodes = p_cong->episodes;
+    uint32_t packets = p_cong->packets_before;
+    uint32_t finished = episodes - (active ? 1u : 0u);
+    uint32_t total_ms = finished_ms;
+    uint32_t delta_ms;
+
+    cy_rtos_get_time(&now);
+    if (active)
+    {
+        total_ms += (uint32_t)(now - p_cong->start);
+    }
+    /* The part of an episode reported while in progress is not reported
+     * again once it ends; never report a negative time */
+    delta_ms = total_ms - p_cong->reported_ms;
+    if ((int32_t)delta_ms < 0)
+    {
+        delta_ms = 0;
+        total_ms = p_cong->reported_ms;
+    }
+
+    p_report->episodes = episodes - p_cong->reported_episodes;
+    p_report->congested_percent = (0 != period_ms) ? ((delta_ms * 100u) / period_ms) : 0;
+    if (p_report->congested_percent > 100u)
+    {
+        p_report->congested_percent = 100u;
+    }
+    p_report->mean_ms = (finished != p_cong->reported_finished) ?
+                        ((finished_ms - p_cong->reported_finished_ms) / (finished - p_cong->reported_finished)) : 0;
+    p_report->longest_ms = p_cong->longest_ms;
+    p_report->mean_packets = (0 != p_report->episodes) ?
+                             ((packets - p_cong->reported_packets) / p_report->episodes) : 0;
+
+    p_cong->reported_episodes = episodes;
+    p_cong->reported_finished = finished;
+    p_cong->reported_finished_ms = finished_ms;
+    p_cong->reported_ms = total_ms;
+    p_cong->reported_packets = packets;
+}
+
+/**
+ * Function Name:
+ * app_tput_congestion_print_hist
+ *
+ * Function Description:
+ * @brief  Prints the episode length histogram of a client on one line
+ *
+ * @param p_cong     congestion state of the client
+ *
+ * @return void
+ */
+void app_tput_congestion_print_hist(const app_tput_congestion_t *p_cong)
+{
+    printf("Congestion episodes (ms):");
+    for (uint32_t i = 0; i < APP_TPUT_CONGESTION_HIST_BUCKETS; i++)
+    {
+        if (0 == p_cong->hist[i])
+        {
+            continue;
+        }
+        if (i == (APP_TPUT_CONGESTION_HIST_BUCKETS - 1u))
+        {
+            printf(" >=%lu:%lu", (unsigned long)(1ul << i), (unsigned long)p_cong->hist[i]);
+        }
+        else
+        {
+            printf(" %lu-%lu:%lu", (unsigned long)((0 == i) ? 0ul : (1ul << i)),
+                   (unsigned long)(1ul << (i + 1)), (unsigned long)p_cong->hist[i]);
+        }
+    }
+    printf("\n");
+}
+
+/**
+ * Function Name:
+ * app_tput_congestion_add_blocked
+ *
+ * Function Description:
+ * @brief  Adds time notify_task spent waiting because every streaming client
+ *         was congested. Called by notify_task.
+ *
+ * @param ms         time blocked
+ *
+ * @return void
+ */
+void app_tput_congestion_add_blocked(uint32_t ms)
+{
+    congestion_blocked_ms += ms;
+}
+
+/**
+ * Function Name:
+ * app_tput_congestion_sample_buffers
+ *
+ * Function Description:
+ * @brief  Samples the free controller TX buffers. Called by tput_task every
+ *         statistics bucket.
+ *
+ * @param void
+ *
+ * @return void
+ */
+void app_tput_congestion_sample_buffers(void)
+{
+    int available = wiced_bt_ble_get_available_tx_buffers();
+    uint32_t free_buffers = (available > 0) ? (uint32_t)available : 0u;
+
+    if ((0 == buffers_samples) || (free_buffers < buffers_min))
+    {
+        buffers_min = free_buffers;
+    }
+    buffers_sum += free_buffers;
+    buffers_samples++;
+}
+
+/**
+ * Function Name:
+ * app_tput_congestion_get_buffers
+ *
+ * Function Description:
+ * @brief  Returns the TX buffer headroom and notify_task blocking since the
+ *         previous call and starts a new sampling period. Called by
+ *         tput_task every report period.
+ *
+ * @param p_buffers  headroom and blocking, filled
+ *
+ * @return void
+ */
+void app_tput_congestion_get_buffers(app_tput_congestion_buffers_t *p_buffers)
+{
+    uint32_t blocked_ms = congestion_blocked_ms;
+
+    p_buffers->min_free = buffers_min;
+    p_buffers->mean_free = (0 != buffers_samples) ? (buffers_sum / buffers_samples) : 0;
+    p_buffers->blocked_ms = blocked_ms - congestion_reported_blocked_ms;
+    congestion_reported_blocked_ms = blocked_ms;
+    buffers_min = 0;
+    buffers_sum = 0;
+    buffers_samples = 0;
+}
+
+/**
+ * Function Name:
+ * app_tput_congestion_limit
+ *
+ * Function Description:
+ * @brief  Names what most likely limits the TX throughput of a client: the
+ *         link when the client was congested for a large share of the
+ *         period, the controller buffers when they ran out without the
+ *         stack reporting congestion, and otherwise the pacing of
+ *         notify_task.
+ *
+ * @param p_report   congestion of the client
+ * @param p_buffers  TX buffer headroom
+ *
+ * @return const char*  name of the limit
+ */
+const char *app_tput_congestion_limit(const app_tput_congestion_report_t *p_report,
+                                      const app_tput_congestion_buffers_t *p_buffers)
+{
+    if (p_report->congested_percent >= APP_TPUT_CONGESTION_LINK_PERCENT)
+    {
+        return "link";
+    }
+    if (0 == p_buffers->min_free)
+    {
+        return "controller buffers";
+    }
+    return "pacing";
+}
+
+
+/* [] END OF FILE */
@@ -0,0 +1,124 @@
+/******************************************************************************
+* File Name:   app_tput_congestion.h
+*
+* Description: This file contains the definitions of the congestion
+*              analytics: congestion episodes per client, time spent
+*              congested and controller TX buffer headroom.
+*
+* Related Document: See README.md
+*
+********************************************************************************
+* Copyright 2021-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef __APP_TPUT_CONGESTION_H__
+#define __APP_TPUT_CONGESTION_H__
+
+/******************************************************************************
+ *                                INCLUDES
+ ******************************************************************************/
+#include <stdint.h>
+#include "wiced_bt_dev.h"
+#include "cyabs_rtos.h"
+#include "app_tput_config.h"
+
+/******************************************************************************
+ *                                Constants
+ ******************************************************************************/
+/* Episode length histogram: bucket 0 counts episodes under 2 ms, bucket i
+ * those of 2^i to 2^(i+1) ms and the last bucket everything above */
+#define APP_TPUT_CONGESTION_HIST_BUCKETS        (12)
+
+/* Share of the report period spent congested above which the link, rather
+ * than the controller buffers or the pacing, is reported as the limit */
+#ifndef APP_TPUT_CONGESTION_LINK_PERCENT
+#define APP_TPUT_CONGESTION_LINK_PERCENT        (25)
+#endif
+
+/******************************************************************************
+ *                                Structures
+ ******************************************************************************/
+/* Congestion episodes of one client, from GATT_CONGESTION_EVT. Written by
+ * the Bluetooth stack thread, read by tput_task. */
+typedef struct
+{
+    volatile wiced_bool_t active;           /* episode in progress */
+    volatile cy_time_t    start;            /* start of the episode in progress */
+    volatile uint32_t     episodes;
+    volatile uint32_t     congested_ms;     /* length of the finished episodes */
+    volatile uint32_t     longest_ms;
+    volatile uint32_t     packets_before;   /* packets sent between episodes */
+    uint32_t              packets_at_end;   /* TX packets when the last episode ended */
+    volatile uint32_t     hist[APP_TPUT_CONGESTION_HIST_BUCKETS];
+    uint32_t              reported_episodes;
+    uint32_t              reported_finished;        /* episodes ended at the previous report */
+    uint32_t              reported_finished_ms;     /* their total length */
+    uint32_t              reported_ms;              /* congested time including the episode in progress */
+    uint32_t              reported_packets;
+} app_tput_congestion_t;
+
+/* Congestion of one client since the previous report */
+typedef struct
+{
+    uint32_t episodes;
+    uint32_t congested_percent;             /* of the report period */
+    uint32_t mean_ms;                       /* of the episodes that ended */
+    uint32_t longest_ms;                    /* since connection */
+    uint32_t mean_packets;                  /* sent between two episodes */
+} app_tput_congestion_report_t;
+
+/* Controller TX buffers and notify_task blocking since the previous report */
+typedef struct
+{
+    uint32_t min_free;
+    uint32_t mean_free;
+    uint32_t blocked_ms;                    /* notify_task waiting on congested clients */
+} app_tput_congestion_buffers_t;
+
+/****************************************************************************
+ *                              FUNCTION DECLARATIONS
+ ***************************************************************************/
+void        app_tput_congestion_begin(app_tput_congestion_t *p_cong, uint32_t tx_packets);
+void        app_tput_congestion_end(app_tput_congestion_t *p_cong, uint32_t tx_packets);
+void        app_tput_congestion_report(app_tput_congestion_t *p_cong, uint32_t period_ms,
+                                       app_tput_congestion_report_t *p_report);
+void        app_tput_congestion_print_hist(const app_tput_congestion_t *p_cong);
+void        app_tput_congestion_add_blocked(uint32_t ms);
+void        app_tput_congestion_sample_buffers(void);
+void        app_tput_congestion_get_buffers(app_tput_congestion_buffers_t *p_buffers);
+const char *app_tput_congestion_limit(const app_tput_congestion_report_t *p_report,
+                                      const app_tput_congestion_buffers_t *p_buffers);
+
+#endif      /* __APP_TPUT_CONGESTION_H__ */
+
+
+/* [] END OF FILE */
@@ -0,0 +1,106 @@
+/******************************************************************************
+* File Name:   app_tput_counters.c
+*
+* Description: This file contains the throughput byte and packet counters.
+*              Each counter block has a single producer that updates it
+*              without atomic read-modify-write; readers take consistent
+*              64-bit snapshots through a sequence lock.
+*
+* Related Document: See README.md
+*
+********************************************************************************
+* Copyright 2021-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/******************************************************************************
+ *                                INCLUDES
+ ******************************************************************************/
+#include "cyabs_rtos.h"
+#include "app_tput_counters.h"
+
+/******************************************************************************
+ *                                Constants
+ ******************************************************************************/
+/* Retries before the reader yields to let a preempted producer finish */
+#define APP_TPUT_COUNTER_SPIN_RETRIES           (8)
+
+/****************************************************************************
+ *                              FUNCTION DEFINITIONS
+ ***************************************************************************/
+
+/**
+ * Function Name:
+ * app_tput_counter_snapshot
+ *
+ * Function Description:
+ * @brief  Copies a counter block. Retries while the producer is updating it,
+ *         so bytes and packets always belong to the same update. Must be
+ *         called from task context, and not from the Bluetooth stack
+ *         callbacks: while the producer is preempted mid-update, the reader
+ *         sleeps.
+ *
+ * @param p_ctr      counter block to read
+ * @param p_snap     destination of the copy
+ *
+ * @return void
+ */
+void app_tput_counter_snapshot(const app_tput_counter_t *p_ctr, app_tput_counter_snapshot_t *p_snap)
+{
+    uint32_t seq_begin, seq_end;
+    uint32_t retries = 0;
+
+    while (true)
+    {
+        seq_begin = __atomic_load_n(&p_ctr->seq, __ATOMIC_ACQUIRE);
+        if (0 == (seq_begin & 1u))
+        {
+            p_snap->bytes = p_ctr->bytes;
+            p_snap->packets = p_ctr->packets;
+            __atomic_thread_fence(__ATOMIC_ACQUIRE);
+            seq_end = __atomic_load_n(&p_ctr->seq, __ATOMIC_RELAXED);
+            if (seq_begin == seq_end)
+            {
+                return;
+            }
+        }
+
+        if (++retries >= APP_TPUT_COUNTER_SPIN_RETRIES)
+        {
+            /* The producer was preempted in the middle of an update */
+            cy_rtos_delay_milliseconds(1);
+            retries = 0;
+        }
+    }
+}
+
+
+/* [] END OF FILE */
@@ -0,0 +1,106 @@
+/******************************************************************************
+* File Name:   app_tput_counters.h
+*
+* Description: This file contains the throughput byte and packet counters.
+*              Each counter block has a single producer that updates it
+*              without atomic read-modify-write; readers take consistent
+*              64-bit snapshots through a sequence lock.
+*
+* Related Document: See README.md
+*
+********************************************************************************
+* Copyright 2021-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef __APP_TPUT_COUNTERS_H__
+#define __APP_TPUT_COUNTERS_H__
+
+/******************************************************************************
+ *                                INCLUDES
+ ******************************************************************************/
+#include <stdint.h>
+
+/******************************************************************************
+ *                                Structures
+ ******************************************************************************/
+/* Counter block written by exactly one task or interrupt */
+typedef struct
+{
+    volatile uint32_t seq;          /* odd while the producer updates the block */
+    volatile uint64_t bytes;        /* bytes transferred */
+    volatile uint64_t packets;      /* packets transferred */
+} app_tput_counter_t;
+
+/* Consistent copy of a counter block */
+typedef struct
+{
+    uint64_t bytes;
+    uint64_t packets;
+} app_tput_counter_snapshot_t;
+
+/****************************************************************************
+ *                              FUNCTION DECLARATIONS
+ ***************************************************************************/
+void app_tput_counter_snapshot(const app_tput_counter_t *p_ctr, app_tput_counter_snapshot_t *p_snap);
+
+/****************************************************************************
+ *                              INLINE FUNCTIONS
+ ***************************************************************************/
+/**
+ * Function Name:
+ * app_tput_counter_add
+ *
+ * Function Description:
+ * @brief  Counts one packet of len bytes. Must only be called by the producer
+ *         owning the block; plain stores are used, the sequence number tells
+ *         readers when the 64-bit values are being updated.
+ *
+ * @param p_ctr      counter block of the producer
+ * @param len        length of the packet in bytes
+ *
+ * @return void
+ */
+static inline void app_tput_counter_add(app_tput_counter_t *p_ctr, uint32_t len)
+{
+    uint32_t seq = p_ctr->seq;
+
+    __atomic_store_n(&p_ctr->seq, seq + 1u, __ATOMIC_RELAXED);
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+    p_ctr->bytes += len;
+    p_ctr->packets++;
+    __atomic_store_n(&p_ctr->seq, seq + 2u, __ATOMIC_RELEASE);
+}
+
+#endif      /* __APP_TPUT_COUNTERS_H__ */
+
+
+/* [] END OF FILE */
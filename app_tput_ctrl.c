@@ -0,0 +1,514 @@
+/******************************************************************************
+* File Name:   app_tput_ctrl.c
+*
+* Description: This file contains the commands of the Control
+*              characteristic, which configure a throughput test run of
+*              the client writing them without reconnecting.
+*
+* Related Document: See README.md
+*
+********************************************************************************
+* Copyright 2021-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/******************************************************************************
+ *                                INCLUDES
+ ******************************************************************************/
+#include <stdio.h>
+#include <string.h>
+#include "wiced_bt_l2c.h"
+#include "cycfg_bt_settings.h"
+#include "app_tput_ctrl.h"
+#include "app_bt_conn.h"
+#include "app_tput_payload.h"
+#include "app_tput_frame.h"
+#include "app_tput_trace.h"
+
+/******************************************************************************
+ *                                Constants
+ ******************************************************************************/
+/******************************************************************************
+ *                                Structures
+ ******************************************************************************/
+/* Command sequence queued for notify_task */
+typedef struct
+{
+    uint16_t conn_id;
+    uint16_t len;
+    uint8_t  cmd[APP_TPUT_CTRL_MAX_LEN];
+} app_tput_ctrl_msg_t;
+
+/******************************************************************************
+ *                                Variable Definitions
+ ******************************************************************************/
+static cy_queue_t ctrl_queue;
+static cy_event_t *p_ctrl_events;
+static uint32_t ctrl_event_bit;
+
+/* Parameter length of each command */
+static const uint8_t ctrl_param_len[APP_TPUT_CTRL_CMD_MAX] =
+{
+    [APP_TPUT_CTRL_CMD_START]          = 0,
+    [APP_TPUT_CTRL_CMD_STOP]           = 0,
+    [APP_TPUT_CTRL_CMD_DIRECTION]      = 1,
+    [APP_TPUT_CTRL_CMD_PAYLOAD_SIZE]   = 2,
+    [APP_TPUT_CTRL_CMD_BURST]          = 1,
+    [APP_TPUT_CTRL_CMD_DURATION]       = 4,
+    [APP_TPUT_CTRL_CMD_CONN_INTERVAL]  = 2,
+    [APP_TPUT_CTRL_CMD_PHY]            = 1,
+    [APP_TPUT_CTRL_CMD_PATTERN]        = 1,
+    [APP_TPUT_CTRL_CMD_FRAMED]         = 1,
+    [APP_TPUT_CTRL_CMD_TELEMETRY]      = 2,
+    [APP_TPUT_CTRL_CMD_AUTOTUNE]       = 1,
+    [APP_TPUT_CTRL_CMD_LINK_MONITOR]   = 1,
+    [APP_TPUT_CTRL_CMD_TRACE]          = 1,
+    [APP_TPUT_CTRL_CMD_REPORT_PERIOD]  = 2,
+};
+
+/****************************************************************************
+ *                              FUNCTION DEFINITIONS
+ ***************************************************************************/
+
+/**
+ * Function Name:
+ * app_tput_ctrl_init
+ *
+ * Function Description:
+ * @brief  Sets the configuration of a new client: running in both
+ *         directions with the build-time parameters
+ *
+ * @param p_ctrl     configuration of the client
+ *
+ * @return void
+ */
+void app_tput_ctrl_init(app_tput_ctrl_t *p_ctrl)
+{
+    memset(p_ctrl, 0, sizeof(app_tput_ctrl_t));
+    p_ctrl->running = WICED_TRUE;
+    p_ctrl->direction = APP_TPUT_CTRL_DIR_BOTH;
+    p_ctrl->conn_interval = CONNECTION_INTERVAL;
+    p_ctrl->phy = APP_TPUT_PREFERRED_PHY;
+    p_ctrl->telemetry_period_ms = APP_TPUT_TELEMETRY_PERIOD_MS;
+    cy_rtos_get_time(&p_ctrl->start_time);
+}
+
+/**
+ * Function Name:
+ * app_tput_ctrl_command
+ *
+ * Function Description:
+ * @brief  Checks the parameter of one command and, if apply is set, applies
+ *         it to the client
+ *
+ * @param p_conn     client the command applies to
+ * @param opcode     command opcode
+ * @param p_param    command parameter
+ * @param apply      WICED_FALSE to only check the parameter
+ *
+ * @return wiced_bt_gatt_status_t  WICED_BT_GATT_ILLEGAL_PARAMETER if out of range
+ */
+static wiced_bt_gatt_status_t app_tput_ctrl_command(conn_state_info_t *p_conn, uint8_t opcode,
+                                                    const uint8_t *p_param, wiced_bool_t apply)
+{
+    app_tput_ctrl_t *p_ctrl = &p_conn->ctrl;
+    wiced_bt_ble_phy_preferences_t phy_preferences;
+    uint32_t value = 0;
+
+    for (uint8_t i = ctrl_param_len[opcode]; i > 0; i--)
+    {
+        value = (value << 8) | p_param[i - 1];
+    }
+
+    switch (opcode)
+    {
+    case APP_TPUT_CTRL_CMD_START:
+        if (apply)
+        {
+            cy_rtos_get_time(&p_ctrl->start_time);
+            p_ctrl->running = WICED_TRUE;
+        }
+        break;
+
+    case APP_TPUT_CTRL_CMD_STOP:
+        if (apply)
+        {
+            p_ctrl->running = WICED_FALSE;
+        }
+        break;
+
+    case APP_TPUT_CTRL_CMD_DIRECTION:
+        if ((0 == value) || (value & ~APP_TPUT_CTRL_DIR_ALL))
+        {
+            return WICED_BT_GATT_ILLEGAL_PARAMETER;
+        }
+        if (apply)
+        {
+            p_ctrl->direction = (uint8_t)value;
+        }
+        break;
+
+    case APP_TPUT_CTRL_CMD_PAYLOAD_SIZE:
+        if (value > APP_TPUT_NOTIFY_MAX_LEN)
+        {
+            return WICED_BT_GATT_ILLEGAL_PARAMETER;
+        }
+        if (apply)
+        {
+            p_ctrl->payload_limit = (uint16_t)value;
+            app_bt_conn_update_payload_size(p_conn);
+        }
+        break;
+
+    case APP_TPUT_CTRL_CMD_BURST:
+        if (value > APP_TPUT_PACER_MAX_BURST)
+        {
+            return WICED_BT_GATT_ILLEGAL_PARAMETER;
+        }
+        if (apply)
+        {
+            app_tput_pacer_set_fixed(&p_conn->pacer, (uint16_t)value);
+        }
+        break;
+
+    case APP_TPUT_CTRL_CMD_DURATION:
+        if (apply)
+        {
+            p_ctrl->duration_ms = value;
+        }
+        break;
+
+    case APP_TPUT_CTRL_CMD_CONN_INTERVAL:
+        if ((value < APP_TPUT_CTRL_MIN_CONN_INTERVAL) || (value > APP_TPUT_CTRL_MAX_CONN_INTERVAL))
+        {
+            return WICED_BT_GATT_ILLEGAL_PARAMETER;
+        }
+        if (apply)
+        {
+            p_ctrl->conn_interval = (uint16_t)value;
+            if (!wiced_bt_l2cap_update_ble_conn_params(p_conn->remote_addr,
+                                                       p_ctrl->conn_interval,
+                                                       APP_TPUT_CTRL_CONN_INTERVAL_MAX(p_ctrl->conn_interval),
+                                                       CY_BT_CONN_LATENCY, SUPERVISION_TIMEOUT))
+            {
+                printf("Failed to Send Connection update parameter request \r\n");
+            }
+        }
+        break;
+
+    case APP_TPUT_CTRL_CMD_PHY:
+        if ((0 == (value & APP_TPUT_CTRL_PHY_MASK)) ||
+            (value & ~(APP_TPUT_CTRL_PHY_MASK | APP_TPUT_CTRL_PHY_CODED_MASK)) ||
+            (APP_TPUT_CTRL_PHY_CODED_MASK == (value & APP_TPUT_CTRL_PHY_CODED_MASK)) ||
+            ((value & APP_TPUT_CTRL_PHY_CODED_MASK) && !(value & BTM_BLE_PREFER_LELR_PHY)))
+        {
+            return WICED_BT_GATT_ILLEGAL_PARAMETER;
+        }
+        if (apply)
+        {
+            p_ctrl->phy = (uint8_t)value;
+            memset(&phy_preferences, 0, sizeof(phy_preferences));
+            phy_preferences.rx_phys = p_ctrl->phy & APP_TPUT_CTRL_PHY_MASK;
+            phy_preferences.tx_phys = p_ctrl->phy & APP_TPUT_CTRL_PHY_MASK;
+            if (p_ctrl->phy & APP_TPUT_CTRL_PHY_CODED_S2)
+            {
+                phy_preferences.phy_opts = BTM_BLE_PREFER_LELR_512K;
+            }
+            else if (p_ctrl->phy & APP_TPUT_CTRL_PHY_CODED_S8)
+            {
+                phy_preferences.phy_opts = BTM_BLE_PREFER_LELR_125K;
+            }
+            memcpy(phy_preferences.remote_bd_addr, p_conn->remote_addr, BD_ADDR_LEN);
+            if (WICED_BT_SUCCESS != wiced_bt_ble_set_phy(&phy_preferences))
+            {
+                printf("Failed to send request to switch PHY\n");
+            }
+        }
+        break;
+
+    case APP_TPUT_CTRL_CMD_PATTERN:
+        if ((value >= APP_TPUT_PAYLOAD_PATTERN_MAX) ||
+            ((APP_TPUT_PAYLOAD_REPLAY == value) && !app_tput_payload_has_replay()))
+        {
+            return WICED_BT_GATT_ILLEGAL_PARAMETER;
+        }
+        if (apply)
+        {
+            app_tput_payload_set_pattern((app_tput_payload_pattern_t)value);
+        }
+        break;
+
+    case APP_TPUT_CTRL_CMD_FRAMED:
+        if (value > 1)
+        {
+            return WICED_BT_GATT_ILLEGAL_PARAMETER;
+        }
+        if (apply)
+        {
+            app_tput_frame_set_enabled(value ? WICED_TRUE : WICED_FALSE);
+        }
+        break;
+
+    case APP_TPUT_CTRL_CMD_TELEMETRY:
+        if ((0 != value) && (value < APP_TPUT_CTRL_MIN_TELEMETRY_PERIOD_MS))
+        {
+            return WICED_BT_GATT_ILLEGAL_PARAMETER;
+        }
+        if (apply)
+        {
+            p_ctrl->telemetry_period_ms = (uint16_t)value;
+        }
+        break;
+
+    case APP_TPUT_CTRL_CMD_AUTOTUNE:
+        if (value > 1)
+        {
+            return WICED_BT_GATT_ILLEGAL_PARAMETER;
+        }
+        if (apply)
+        {
+            /* The sweep itself is driven by tput_task */
+            p_conn->autotune.request = value ? APP_TPUT_AUTOTUNE_REQ_START : APP_TPUT_AUTOTUNE_REQ_ABORT;
+        }
+        break;
+
+    case APP_TPUT_CTRL_CMD_LINK_MONITOR:
+        if (value > 1)
+        {
+            return WICED_BT_GATT_ILLEGAL_PARAMETER;
+        }
+        if (apply)
+        {
+            p_conn->link.enabled = value ? WICED_TRUE : WICED_FALSE;
+        }
+        break;
+
+    case APP_TPUT_CTRL_CMD_TRACE:
+        if ((APP_TPUT_TRACE_REQ_DUMP != value) && (APP_TPUT_TRACE_REQ_DUMP_RESET != value))
+        {
+            return WICED_BT_GATT_ILLEGAL_PARAMETER;
+        }
+        if (apply)
+        {
+            app_tput_trace_request((app_tput_trace_req_t)value);
+        }
+        break;
+
+    case APP_TPUT_CTRL_CMD_REPORT_PERIOD:
+        /* Shared by every client, the last one written applies */
+        if (value < APP_TPUT_STATS_BUCKET_MS)
+        {
+            return WICED_BT_GATT_ILLEGAL_PARAMETER;
+        }
+        if (apply)
+        {
+            app_tput_stats_set_report_period(value);
+        }
+        break;
+
+    default:
+        return WICED_BT_GATT_REQ_NOT_SUPPORTED;
+    }
+    return WICED_BT_GATT_SUCCESS;
+}
+
+/**
+ * Function Name:
+ * app_tput_ctrl_parse
+ *
+ * Function Description:
+ * @brief  Walks the commands of a write, checking each one and, if apply is
+ *         set, applying it
+ *
+ * @param p_conn     client the commands apply to
+ * @param p_cmd      commands written
+ * @param len        length of the commands
+ * @param apply      WICED_FALSE to only check the commands
+ *
+ * @return wiced_bt_gatt_status_t  status of the first invalid command
+ */
+static wiced_bt_gatt_status_t app_tput_ctrl_parse(conn_state_info_t *p_conn, const uint8_t *p_cmd,
+                                                  uint16_t len, wiced_bool_t apply)
+{
+    wiced_bt_gatt_status_t status;
+    uint16_t offset = 0;
+    uint8_t opcode;
+
+    while (offset < len)
+    {
+        opcode = p_cmd[offset++];
+        if ((0 == opcode) || (opcode >= APP_TPUT_CTRL_CMD_MAX))
+        {
+            return WICED_BT_GATT_REQ_NOT_SUPPORTED;
+        }
+        if ((len - offset) < ctrl_param_len[opcode])
+        {
+            return WICED_BT_GATT_INVALID_ATTR_LEN;
+        }
+        status = app_tput_ctrl_command(p_conn, opcode, &p_cmd[offset], apply);
+        if (WICED_BT_GATT_SUCCESS != status)
+        {
+            return status;
+        }
+        offset += ctrl_param_len[opcode];
+    }
+    return WICED_BT_GATT_SUCCESS;
+}
+
+/**
+ * Function Name:
+ * app_tput_ctrl_queue_init
+ *
+ * Function Description:
+ * @brief  Creates the queue of the commands applied by notify_task
+ *
+ * @param p_events   event group of notify_task
+ * @param event_bit  event signalled when commands are queued
+ *
+ * @return void
+ */
+void app_tput_ctrl_queue_init(cy_event_t *p_events, uint32_t event_bit)
+{
+    cy_rslt_t result = cy_rtos_queue_init(&ctrl_queue, APP_TPUT_CTRL_QUEUE_LENGTH, sizeof(app_tput_ctrl_msg_t));
+
+    if (CY_RSLT_SUCCESS != result)
+    {
+        printf("Control queue initialization failed 0x%lX\n", (unsigned long)result);
+        return;
+    }
+    p_ctrl_events = p_events;
+    ctrl_event_bit = event_bit;
+}
+
+/**
+ * Function Name:
+ * app_tput_ctrl_submit
+ *
+ * Function Description:
+ * @brief  Checks the commands written to the Control characteristic and
+ *         queues them for notify_task, which applies them with
+ *         app_tput_ctrl_process. The connection state is only changed by
+ *         notify_task, and the write is rejected unless every command of it
+ *         is valid.
+ *
+ * @param conn_id    Connection ID of the client writing the commands
+ * @param p_cmd      commands written
+ * @param len        length of the commands
+ *
+ * @return wiced_bt_gatt_status_t  Bluetooth LE GATT status, WICED_BT_GATT_BUSY
+ *                                 if the queue is full
+ */
+wiced_bt_gatt_status_t app_tput_ctrl_submit(uint16_t conn_id, const uint8_t *p_cmd, uint16_t len)
+{
+    conn_state_info_t *p_conn = app_bt_conn_find(conn_id);
+    wiced_bt_gatt_status_t status;
+    app_tput_ctrl_msg_t msg;
+
+    if (NULL == p_conn)
+    {
+        return WICED_BT_GATT_ERROR;
+    }
+    if ((0 == len) || (len > APP_TPUT_CTRL_MAX_LEN))
+    {
+        return WICED_BT_GATT_INVALID_ATTR_LEN;
+    }
+    status = app_tput_ctrl_parse(p_conn, p_cmd, len, WICED_FALSE);
+    if (WICED_BT_GATT_SUCCESS != status)
+    {
+        return status;
+    }
+
+    msg.conn_id = conn_id;
+    msg.len = len;
+    memcpy(msg.cmd, p_cmd, len);
+    if ((NULL == p_ctrl_events) || (CY_RSLT_SUCCESS != cy_rtos_queue_put(&ctrl_queue, &msg, 0)))
+    {
+        return WICED_BT_GATT_BUSY;
+    }
+    cy_rtos_event_setbits(p_ctrl_events, ctrl_event_bit);
+    return WICED_BT_GATT_SUCCESS;
+}
+
+/**
+ * Function Name:
+ * app_tput_ctrl_process
+ *
+ * Function Description:
+ * @brief  Applies the queued commands, in order. Called by notify_task.
+ *         Commands of a client that disconnected meanwhile are dropped.
+ *
+ * @return void
+ */
+void app_tput_ctrl_process(void)
+{
+    conn_state_info_t *p_conn;
+    app_tput_ctrl_msg_t msg;
+
+    while ((NULL != p_ctrl_events) && (CY_RSLT_SUCCESS == cy_rtos_queue_get(&ctrl_queue, &msg, 0)))
+    {
+        p_conn = app_bt_conn_find(msg.conn_id);
+        if (NULL != p_conn)
+        {
+            (void)app_tput_ctrl_parse(p_conn, msg.cmd, msg.len, WICED_TRUE);
+        }
+    }
+}
+
+/**
+ * Function Name:
+ * app_tput_ctrl_expired
+ *
+ * Function Description:
+ * @brief  Stops the test run of a client once its duration has elapsed
+ *
+ * @param p_ctrl     configuration of the client
+ *
+ * @return wiced_bool_t  WICED_TRUE if the run was stopped by this call
+ */
+wiced_bool_t app_tput_ctrl_expired(app_tput_ctrl_t *p_ctrl)
+{
+    cy_time_t now = 0;
+
+    if ((!p_ctrl->running) || (0 == p_ctrl->duration_ms))
+    {
+        return WICED_FALSE;
+    }
+    cy_rtos_get_time(&now);
+    if ((uint32_t)(now - p_ctrl->start_time) < p_ctrl->duration_ms)
+    {
+        return WICED_FALSE;
+    }
+    p_ctrl->running = WICED_FALSE;
+    return WICED_TRUE;
+}
+
+
+/* [] END OF FILE */
@@ -0,0 +1,148 @@
+/******************************************************************************
+* File Name:   app_tput_ctrl.h
+*
+* Description: This file contains the commands of the Control
+*              characteristic, which configure a throughput test run of
+*              the client writing them without reconnecting.
+*
+* Related Document: See README.md
+*
+********************************************************************************
+* Copyright 2021-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef __APP_TPUT_CTRL_H__
+#define __APP_TPUT_CTRL_H__
+
+/******************************************************************************
+ *                                INCLUDES
+ ******************************************************************************/
+#include <stdint.h>
+#include "wiced_bt_dev.h"
+#include "wiced_bt_ble.h"
+#include "wiced_bt_gatt.h"
+#include "cyabs_rtos.h"
+#include "app_tput_config.h"
+
+/******************************************************************************
+ *                                Constants
+ ******************************************************************************/
+/* Test directions, APP_TPUT_CTRL_CMD_DIRECTION parameter */
+#define APP_TPUT_CTRL_DIR_TX                    (0x01u)   /* server sends notifications */
+#define APP_TPUT_CTRL_DIR_RX                    (0x02u)   /* server reports client writes */
+#define APP_TPUT_CTRL_DIR_READ                  (0x04u)   /* server serves generated Notify value reads */
+#define APP_TPUT_CTRL_DIR_BOTH                  (APP_TPUT_CTRL_DIR_TX | APP_TPUT_CTRL_DIR_RX)
+#define APP_TPUT_CTRL_DIR_ALL                   (APP_TPUT_CTRL_DIR_BOTH | APP_TPUT_CTRL_DIR_READ)
+
+/* APP_TPUT_CTRL_CMD_PHY parameter: a BTM_BLE_PREFER_*_PHY mask, and with
+ * BTM_BLE_PREFER_LELR_PHY at most one Coded PHY coding option */
+#define APP_TPUT_CTRL_PHY_MASK                  (BTM_BLE_PREFER_1M_PHY | BTM_BLE_PREFER_2M_PHY | \
+                                                 BTM_BLE_PREFER_LELR_PHY)
+#define APP_TPUT_CTRL_PHY_CODED_S2              (0x10u)   /* prefer Coded S2, 500 kbps */
+#define APP_TPUT_CTRL_PHY_CODED_S8              (0x20u)   /* prefer Coded S8, 125 kbps */
+#define APP_TPUT_CTRL_PHY_CODED_MASK            (APP_TPUT_CTRL_PHY_CODED_S2 | APP_TPUT_CTRL_PHY_CODED_S8)
+
+/* Shortest telemetry period accepted, one statistics bucket */
+#define APP_TPUT_CTRL_MIN_TELEMETRY_PERIOD_MS   (100)
+
+/* Longest command sequence accepted in one write, the Control value length */
+#define APP_TPUT_CTRL_MAX_LEN                   (20)
+
+/* Command sequences waiting for notify_task */
+#ifndef APP_TPUT_CTRL_QUEUE_LENGTH
+#define APP_TPUT_CTRL_QUEUE_LENGTH              (8)
+#endif
+
+/* Connection interval range allowed by the specification, 1.25 ms units */
+#define APP_TPUT_CTRL_MIN_CONN_INTERVAL         (6)
+#define APP_TPUT_CTRL_MAX_CONN_INTERVAL         (3200)
+
+/* Largest interval of a connection parameter update requesting interval:
+ * one step above it, within the allowed range */
+#define APP_TPUT_CTRL_CONN_INTERVAL_MAX(interval) \
+    (((interval) < APP_TPUT_CTRL_MAX_CONN_INTERVAL) ? ((interval) + 1) : APP_TPUT_CTRL_MAX_CONN_INTERVAL)
+
+/******************************************************************************
+ *                                Enumerations
+ ******************************************************************************/
+/* Command opcodes. A write holds one or more commands, each an opcode
+ * followed by its little endian parameter. The whole write is checked
+ * before any command is applied. */
+typedef enum
+{
+    APP_TPUT_CTRL_CMD_START          = 0x01,  /* no parameter, start the test run */
+    APP_TPUT_CTRL_CMD_STOP           = 0x02,  /* no parameter, stop the test run */
+    APP_TPUT_CTRL_CMD_DIRECTION      = 0x03,  /* uint8, APP_TPUT_CTRL_DIR_* */
+    APP_TPUT_CTRL_CMD_PAYLOAD_SIZE   = 0x04,  /* uint16, notification payload limit, 0 for MTU sized */
+    APP_TPUT_CTRL_CMD_BURST          = 0x05,  /* uint8, notifications per round, 0 for adaptive */
+    APP_TPUT_CTRL_CMD_DURATION       = 0x06,  /* uint32, run length in ms, 0 for unlimited */
+    APP_TPUT_CTRL_CMD_CONN_INTERVAL  = 0x07,  /* uint16, requested interval in 1.25 ms units */
+    APP_TPUT_CTRL_CMD_PHY            = 0x08,  /* uint8, BTM_BLE_PREFER_*_PHY mask | APP_TPUT_CTRL_PHY_CODED_* */
+    APP_TPUT_CTRL_CMD_PATTERN        = 0x09,  /* uint8, app_tput_payload_pattern_t */
+    APP_TPUT_CTRL_CMD_FRAMED         = 0x0A,  /* uint8, 1 for framed payloads */
+    APP_TPUT_CTRL_CMD_TELEMETRY      = 0x0B,  /* uint16, telemetry period in ms, 0 to disable */
+    APP_TPUT_CTRL_CMD_AUTOTUNE       = 0x0C,  /* uint8, 1 to start an auto-tune sweep, 0 to abort it */
+    APP_TPUT_CTRL_CMD_LINK_MONITOR   = 0x0D,  /* uint8, 1 to enable the PHY fallback monitor, 0 to disable it */
+    APP_TPUT_CTRL_CMD_TRACE          = 0x0E,  /* uint8, app_tput_trace_req_t, print the callback trace */
+    APP_TPUT_CTRL_CMD_REPORT_PERIOD  = 0x0F,  /* uint16, throughput report period in ms */
+    APP_TPUT_CTRL_CMD_MAX
+} app_tput_ctrl_cmd_t;
+
+/******************************************************************************
+ *                                Structures
+ ******************************************************************************/
+/* Test run configuration of one client */
+typedef struct
+{
+    volatile wiced_bool_t running;          /* notifications allowed */
+    volatile uint8_t      direction;        /* APP_TPUT_CTRL_DIR_* */
+    uint16_t              payload_limit;    /* largest notification payload, 0 for none */
+    uint16_t              conn_interval;    /* requested interval in 1.25 ms units */
+    uint8_t               phy;              /* requested PHY, APP_TPUT_CTRL_CMD_PHY parameter */
+    uint32_t              duration_ms;      /* run length, 0 for unlimited */
+    uint16_t              telemetry_period_ms; /* Telemetry notification period, 0 for none */
+    cy_time_t             start_time;       /* time of the last start */
+} app_tput_ctrl_t;
+
+/****************************************************************************
+ *                              FUNCTION DECLARATIONS
+ ***************************************************************************/
+void                   app_tput_ctrl_init(app_tput_ctrl_t *p_ctrl);
+void                   app_tput_ctrl_queue_init(cy_event_t *p_events, uint32_t event_bit);
+wiced_bt_gatt_status_t app_tput_ctrl_submit(uint16_t conn_id, const uint8_t *p_cmd, uint16_t len);
+void                   app_tput_ctrl_process(void);
+wiced_bool_t           app_tput_ctrl_expired(app_tput_ctrl_t *p_ctrl);
+
+#endif      /* __APP_TPUT_CTRL_H__ */
+
+
+/* [] END OF FILE */
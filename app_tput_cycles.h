@@ -0,0 +1,152 @@
+/******************************************************************************
+* File Name:   app_tput_cycles.h
+*
+* Description: This file contains the access to the DWT cycle counter,
+*              used to time the Bluetooth callback paths with cycle
+*              resolution. The host build reads the monotonic clock instead.
+*
+* Related Document: See README.md
+*
+********************************************************************************
+* Copyright 2021-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef __APP_TPUT_CYCLES_H__
+#define __APP_TPUT_CYCLES_H__
+
+/******************************************************************************
+ *                                INCLUDES
+ ******************************************************************************/
+#include <stdint.h>
+#include "cybsp.h"
+#if APP_TPUT_HOST
+#include <time.h>
+#endif
+
+/****************************************************************************
+ *                              INLINE FUNCTIONS
+ ***************************************************************************/
+#if APP_TPUT_HOST
+/**
+ * Function Name:
+ * app_tput_cycles_init
+ *
+ * Function Description:
+ * @brief  The host build counts nanoseconds of the monotonic clock, there is
+ *         nothing to start
+ *
+ * @param void
+ *
+ * @return void
+ */
+static inline void app_tput_cycles_init(void)
+{
+}
+
+/**
+ * Function Name:
+ * app_tput_cycles_now
+ *
+ * Function Description:
+ * @brief  Returns the monotonic clock in nanoseconds, one cycle of the 1 GHz
+ *         SystemCoreClock of the host build. Differences of two readings are
+ *         valid across one wrap, about 4 s.
+ *
+ * @param void
+ *
+ * @return uint32_t  nanoseconds
+ */
+static inline uint32_t app_tput_cycles_now(void)
+{
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint32_t)(((uint64_t)now.tv_sec * 1000000000u) + (uint64_t)now.tv_nsec);
+}
+#else
+/**
+ * Function Name:
+ * app_tput_cycles_init
+ *
+ * Function Description:
+ * @brief  Enables the trace unit and starts the DWT cycle counter
+ *
+ * @param void
+ *
+ * @return void
+ */
+static inline void app_tput_cycles_init(void)
+{
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CYCCNT = 0;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+}
+
+/**
+ * Function Name:
+ * app_tput_cycles_now
+ *
+ * Function Description:
+ * @brief  Returns the cycle counter. Differences of two readings are valid
+ *         across one wrap, about 45 s at 96 MHz.
+ *
+ * @param void
+ *
+ * @return uint32_t  CPU cycles
+ */
+static inline uint32_t app_tput_cycles_now(void)
+{
+    return DWT->CYCCNT;
+}
+
+#endif
+
+/**
+ * Function Name:
+ * app_tput_cycles_to_us
+ *
+ * Function Description:
+ * @brief  Converts a number of CPU cycles to microseconds
+ *
+ * @param cycles     CPU cycles
+ *
+ * @return uint32_t  microseconds
+ */
+static inline uint32_t app_tput_cycles_to_us(uint32_t cycles)
+{
+    return (uint32_t)(((uint64_t)cycles * 1000000u) / SystemCoreClock);
+}
+
+#endif      /* __APP_TPUT_CYCLES_H__ */
+
+
+/* [] END OF FILE */
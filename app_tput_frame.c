@@ -0,0 +1,364 @@
+/******************************************************************************
+* File Name:   app_tput_frame.c
+*
+* Description: This file contains the framed throughput payload format.
+*              Every frame carries a sequence number, a timestamp, the
+*              length of its data and a CRC32, so the receiver can detect
+*              lost, duplicated, reordered and corrupted frames.
+*
+* Related Document: See README.md
+*
+********************************************************************************
+* Copyright 2021-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/******************************************************************************
+ *                                INCLUDES
+ ******************************************************************************/
+#include <string.h>
+#include "app_tput_frame.h"
+
+/******************************************************************************
+ *                                Constants
+ ******************************************************************************/
+/* Reflected CRC-32 polynomial (IEEE 802.3) */
+#define APP_TPUT_CRC32_POLY                     (0xEDB88320u)
+
+/******************************************************************************
+ *                                Variable Definitions
+ ******************************************************************************/
+/* Slice-by-8 tables, crc_table[k][i] is the CRC of byte i followed by k zero bytes */
+static uint32_t crc_table[8][256];
+static wiced_bool_t crc_table_ready;
+
+static volatile wiced_bool_t frame_enabled = APP_TPUT_FRAMED_PAYLOAD ? WICED_TRUE : WICED_FALSE;
+
+/****************************************************************************
+ *                              FUNCTION DEFINITIONS
+ ***************************************************************************/
+
+/**
+ * Function Name:
+ * app_tput_frame_init
+ *
+ * Function Description:
+ * @brief  Builds the CRC32 tables. Must be called before frames are encoded
+ *         or received.
+ *
+ * @param void
+ *
+ * @return void
+ */
+void app_tput_frame_init(void)
+{
+    uint32_t crc;
+
+    if (crc_table_ready)
+    {
+        return;
+    }
+    for (uint32_t i = 0; i < 256; i++)
+    {
+        crc = i;
+        for (uint8_t bit = 0; bit < 8; bit++)
+        {
+            crc = (crc & 1u) ? ((crc >> 1) ^ APP_TPUT_CRC32_POLY) : (crc >> 1);
+        }
+        crc_table[0][i] = crc;
+    }
+    for (uint32_t i = 0; i < 256; i++)
+    {
+        for (uint8_t k = 1; k < 8; k++)
+        {
+            crc_table[k][i] = (crc_table[k - 1][i] >> 8) ^ crc_table[0][crc_table[k - 1][i] & 0xFFu];
+        }
+    }
+    crc_table_ready = WICED_TRUE;
+}
+
+/**
+ * Function Name:
+ * app_tput_frame_set_enabled
+ *
+ * Function Description:
+ * @brief  Selects framed or plain payloads for notifications and writes
+ *
+ * @param enabled    WICED_TRUE to use framed payloads
+ *
+ * @return void
+ */
+void app_tput_frame_set_enabled(wiced_bool_t enabled)
+{
+    frame_enabled = enabled;
+}
+
+/**
+ * Function Name:
+ * app_tput_frame_is_enabled
+ *
+ * Function Description:
+ * @brief  Returns whether framed payloads are used
+ *
+ * @param void
+ *
+ * @return wiced_bool_t  WICED_TRUE if framed payloads are used
+ */
+wiced_bool_t app_tput_frame_is_enabled(void)
+{
+    return frame_enabled;
+}
+
+/**
+ * Function Name:
+ * app_tput_crc32_update
+ *
+ * Function Description:
+ * @brief  Continues a CRC32 over len bytes, eight bytes per step. The
+ *         register is not inverted on entry or exit. Assumes a little endian
+ *         CPU.
+ *
+ * @param crc        CRC register
+ * @param p_data     data to add
+ * @param len        length of the data
+ *
+ * @return uint32_t  updated CRC register
+ */
+uint32_t app_tput_crc32_update(uint32_t crc, const uint8_t *p_data, uint32_t len)
+{
+    uint32_t lo, hi;
+
+    while (len >= 8)
+    {
+        memcpy(&lo, p_data, sizeof(lo));
+        memcpy(&hi, p_data + 4, sizeof(hi));
+        lo ^= crc;
+        crc = crc_table[7][lo & 0xFFu] ^ crc_table[6][(lo >> 8) & 0xFFu] ^
+              crc_table[5][(lo >> 16) & 0xFFu] ^ crc_table[4][lo >> 24] ^
+              crc_table[3][hi & 0xFFu] ^ crc_table[2][(hi >> 8) & 0xFFu] ^
+              crc_table[1][(hi >> 16) & 0xFFu] ^ crc_table[0][hi >> 24];
+        p_data += 8;
+        len -= 8;
+    }
+    while (len--)
+    {
+        crc = crc_table[0][(crc ^ *p_data++) & 0xFFu] ^ (crc >> 8);
+    }
+    return crc;
+}
+
+/**
+ * Function Name:
+ * app_tput_frame_crc
+ *
+ * Function Description:
+ * @brief  Computes the CRC32 of a frame over its sequence number, length and
+ *         data. The timestamp is excluded so that it can be set when the
+ *         frame is sent.
+ *
+ * @param p_frame    frame, header fields other than the CRC already set
+ * @param data_len   length of the data following the header
+ *
+ * @return uint32_t  CRC32 of the frame
+ */
+uint32_t app_tput_frame_crc(const uint8_t *p_frame, uint16_t data_len)
+{
+    uint32_t crc = 0xFFFFFFFFu;
+
+    crc = app_tput_crc32_update(crc, &p_frame[APP_TPUT_FRAME_SEQ_OFFSET], 4);
+    crc = app_tput_crc32_update(crc, &p_frame[APP_TPUT_FRAME_LEN_OFFSET], 2);
+    crc = app_tput_crc32_update(crc, &p_frame[APP_TPUT_FRAME_HDR_LEN], data_len);
+    return ~crc;
+}
+
+/**
+ * Function Name:
+ * app_tput_frame_put32
+ *
+ * Function Description:
+ * @brief  Stores a 32-bit little endian field
+ *
+ * @param p_dst      destination
+ * @param value      value to store
+ *
+ * @return void
+ */
+static void app_tput_frame_put32(uint8_t *p_dst, uint32_t value)
+{
+    p_dst[0] = (uint8_t)value;
+    p_dst[1] = (uint8_t)(value >> 8);
+    p_dst[2] = (uint8_t)(value >> 16);
+    p_dst[3] = (uint8_t)(value >> 24);
+}
+
+/**
+ * Function Name:
+ * app_tput_frame_get32
+ *
+ * Function Description:
+ * @brief  Loads a 32-bit little endian field
+ *
+ * @param p_src      source
+ *
+ * @return uint32_t  field value
+ */
+static uint32_t app_tput_frame_get32(const uint8_t *p_src)
+{
+    return (uint32_t)p_src[0] | ((uint32_t)p_src[1] << 8) |
+           ((uint32_t)p_src[2] << 16) | ((uint32_t)p_src[3] << 24);
+}
+
+/**
+ * Function Name:
+ * app_tput_frame_encode
+ *
+ * Function Description:
+ * @brief  Writes the header of a frame whose data is already in place, using
+ *         the next sequence number of the stream. The sequence number only
+ *         advances when app_tput_frame_sent() is called.
+ *
+ * @param p_tx       transmit state of the stream
+ * @param p_frame    frame buffer, data at APP_TPUT_FRAME_HDR_LEN
+ * @param frame_len  length of the frame, at least APP_TPUT_FRAME_HDR_LEN
+ * @param timestamp  send time in ms
+ *
+ * @return void
+ */
+void app_tput_frame_encode(const app_tput_frame_tx_t *p_tx, uint8_t *p_frame,
+                           uint16_t frame_len, uint32_t timestamp)
+{
+    uint16_t data_len = frame_len - APP_TPUT_FRAME_HDR_LEN;
+
+    app_tput_frame_put32(&p_frame[APP_TPUT_FRAME_SEQ_OFFSET], p_tx->seq);
+    app_tput_frame_put32(&p_frame[APP_TPUT_FRAME_TS_OFFSET], timestamp);
+    p_frame[APP_TPUT_FRAME_LEN_OFFSET] = (uint8_t)data_len;
+    p_frame[APP_TPUT_FRAME_LEN_OFFSET + 1] = (uint8_t)(data_len >> 8);
+    app_tput_frame_put32(&p_frame[APP_TPUT_FRAME_CRC_OFFSET], app_tput_frame_crc(p_frame, data_len));
+}
+
+/**
+ * Function Name:
+ * app_tput_frame_sent
+ *
+ * Function Description:
+ * @brief  Accounts a frame encoded with app_tput_frame_encode() as sent and
+ *         advances the sequence number of the stream
+ *
+ * @param p_tx       transmit state of the stream
+ * @param frame_len  length of the frame
+ *
+ * @return void
+ */
+void app_tput_frame_sent(app_tput_frame_tx_t *p_tx, uint16_t frame_len)
+{
+    p_tx->seq++;
+    app_tput_counter_add(&p_tx->good, frame_len - APP_TPUT_FRAME_HDR_LEN);
+}
+
+/**
+ * Function Name:
+ * app_tput_frame_receive
+ *
+ * Function Description:
+ * @brief  Checks a received frame and updates the loss, duplicate, reorder
+ *         and CRC error counts of the stream. A frame arriving after later
+ *         ones removes the gap it was counted in. Frames older than
+ *         APP_TPUT_FRAME_RX_WINDOW can not be told apart and are counted as
+ *         duplicates.
+ *
+ * @param p_rx       receive state of the stream
+ * @param p_frame    received frame
+ * @param frame_len  length of the frame
+ *
+ * @return void
+ */
+void app_tput_frame_receive(app_tput_frame_rx_t *p_rx, const uint8_t *p_frame,
+                            uint16_t frame_len)
+{
+    uint16_t data_len;
+    uint32_t seq, offset;
+    int32_t distance;
+
+    if (frame_len < APP_TPUT_FRAME_HDR_LEN)
+    {
+        p_rx->crc_errors++;
+        return;
+    }
+    data_len = (uint16_t)(p_frame[APP_TPUT_FRAME_LEN_OFFSET] |
+                          (p_frame[APP_TPUT_FRAME_LEN_OFFSET + 1] << 8));
+    if ((data_len != (frame_len - APP_TPUT_FRAME_HDR_LEN)) ||
+        (app_tput_frame_get32(&p_frame[APP_TPUT_FRAME_CRC_OFFSET]) != app_tput_frame_crc(p_frame, data_len)))
+    {
+        p_rx->crc_errors++;
+        return;
+    }
+
+    seq = app_tput_frame_get32(&p_frame[APP_TPUT_FRAME_SEQ_OFFSET]);
+    if (!p_rx->started)
+    {
+        p_rx->started = WICED_TRUE;
+        p_rx->expected = seq + 1u;
+        p_rx->window = 1u;
+    }
+    else
+    {
+        distance = (int32_t)(seq - p_rx->expected);
+        if (distance >= 0)
+        {
+            /* In order, or ahead of the frames still missing */
+            p_rx->gaps += (uint32_t)distance;
+            offset = (uint32_t)distance + 1u;
+            p_rx->window = (offset >= APP_TPUT_FRAME_RX_WINDOW) ? 0u : (p_rx->window << offset);
+            p_rx->window |= 1u;
+            p_rx->expected = seq + 1u;
+        }
+        else
+        {
+            offset = (uint32_t)(-(distance + 1));
+            if ((offset >= APP_TPUT_FRAME_RX_WINDOW) || (p_rx->window & (1u << offset)))
+            {
+                p_rx->duplicates++;
+                return;
+            }
+            /* Late frame filling a gap */
+            p_rx->window |= (1u << offset);
+            p_rx->reorders++;
+            if (p_rx->gaps > 0)
+            {
+                p_rx->gaps--;
+            }
+        }
+    }
+    app_tput_counter_add(&p_rx->good, data_len);
+}
+
+
+/* [] END OF FILE */
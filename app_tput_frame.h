@@ -0,0 +1,116 @@
+/******************************************************************************
+* File Name:   app_tput_frame.h
+*
+* Description: This file contains the framed throughput payload format.
+*              Every frame carries a sequence number, a timestamp, the
+*              length of its data and a CRC32, so the receiver can detect
+*              lost, duplicated, reordered and corrupted frames.
+*
+* Related Document: See README.md
+*
+********************************************************************************
+* Copyright 2021-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef __APP_TPUT_FRAME_H__
+#define __APP_TPUT_FRAME_H__
+
+/******************************************************************************
+ *                                INCLUDES
+ ******************************************************************************/
+#include <stdint.h>
+#include "wiced_bt_dev.h"
+#include "app_tput_config.h"
+#include "app_tput_counters.h"
+
+/******************************************************************************
+ *                                Constants
+ ******************************************************************************/
+/* Frame header, all fields little endian:
+ *   [0]  sequence number  (4 bytes)
+ *   [4]  timestamp in ms  (4 bytes, not covered by the CRC)
+ *   [8]  data length      (2 bytes)
+ *   [10] CRC32            (4 bytes, over sequence number, length and data)
+ * followed by the data */
+#define APP_TPUT_FRAME_SEQ_OFFSET               (0)
+#define APP_TPUT_FRAME_TS_OFFSET                (4)
+#define APP_TPUT_FRAME_LEN_OFFSET               (8)
+#define APP_TPUT_FRAME_CRC_OFFSET               (10)
+#define APP_TPUT_FRAME_HDR_LEN                  (14)
+
+/* Number of sequence numbers below the next expected one that are tracked
+ * to tell late frames from duplicates */
+#define APP_TPUT_FRAME_RX_WINDOW                (32)
+
+/******************************************************************************
+ *                                Structures
+ ******************************************************************************/
+/* Transmit state of one stream, owned by the sending task */
+typedef struct
+{
+    uint32_t            seq;            /* sequence number of the next frame */
+    app_tput_counter_t  good;           /* frame data bytes sent */
+    uint64_t            reported_good;  /* good.bytes at the last report */
+} app_tput_frame_tx_t;
+
+/* Receive state of one stream, owned by the Bluetooth stack thread */
+typedef struct
+{
+    wiced_bool_t        started;        /* a valid frame has been received */
+    uint32_t            expected;       /* next expected sequence number */
+    uint32_t            window;         /* bit n set if expected - 1 - n was received */
+    volatile uint32_t   gaps;           /* frames missing */
+    volatile uint32_t   duplicates;     /* frames received more than once */
+    volatile uint32_t   reorders;       /* frames received after a later one */
+    volatile uint32_t   crc_errors;     /* frames with a CRC or length mismatch */
+    app_tput_counter_t  good;           /* data bytes of valid, new frames */
+    uint64_t            reported_good;  /* good.bytes at the last report */
+} app_tput_frame_rx_t;
+
+/****************************************************************************
+ *                              FUNCTION DECLARATIONS
+ ***************************************************************************/
+void         app_tput_frame_init(void);
+void         app_tput_frame_set_enabled(wiced_bool_t enabled);
+wiced_bool_t app_tput_frame_is_enabled(void);
+uint32_t     app_tput_crc32_update(uint32_t crc, const uint8_t *p_data, uint32_t len);
+uint32_t     app_tput_frame_crc(const uint8_t *p_frame, uint16_t data_len);
+void         app_tput_frame_encode(const app_tput_frame_tx_t *p_tx, uint8_t *p_frame,
+                                   uint16_t frame_len, uint32_t timestamp);
+void         app_tput_frame_sent(app_tput_frame_tx_t *p_tx, uint16_t frame_len);
+void         app_tput_frame_receive(app_tput_frame_rx_t *p_rx, const uint8_t *p_frame,
+                                    uint16_t frame_len);
+
+#endif      /* __APP_TPUT_FRAME_H__ */
+
+
+/* [] END OF FILE */
@@ -0,0 +1,173 @@
+/******************************************************************************
+* File Name:   app_tput_indication.c
+*
+* Description: This file contains the indication mode. It records the
+*              round trip time from sending an indication to receiving its
+*              confirmation, and counts the confirmed bytes.
+*
+* Related Document: See README.md
+*
+********************************************************************************
+* Copyright 2021-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/******************************************************************************
+ *                                INCLUDES
+ ******************************************************************************/
+#include <stdbool.h>
+#include <string.h>
+#include "app_tput_indication.h"
+
+/****************************************************************************
+ *                              FUNCTION DEFINITIONS
+ ***************************************************************************/
+
+/**
+ * Function Name:
+ * app_tput_indication_init
+ *
+ * Function Description:
+ * @brief  Initializes the indication state of a new connection
+ *
+ * @param p_ind      indication state of the client
+ *
+ * @return void
+ */
+void app_tput_indication_init(app_tput_indication_t *p_ind)
+{
+    memset(p_ind, 0, sizeof(*p_ind));
+    p_ind->rtt_min_ms = UINT32_MAX;
+}
+
+/**
+ * Function Name:
+ * app_tput_indication_sent
+ *
+ * Function Description:
+ * @brief  Records an indication accepted by the stack. Called by notify_task.
+ *
+ * @param p_ind      indication state of the client
+ * @param len        length of the indication
+ *
+ * @return void
+ */
+void app_tput_indication_sent(app_tput_indication_t *p_ind, uint16_t len)
+{
+    cy_time_t now = 0;
+
+    cy_rtos_get_time(&now);
+    p_ind->sent_time = now;
+    p_ind->len = len;
+    __atomic_store_n(&p_ind->in_flight, WICED_TRUE, __ATOMIC_RELEASE);
+}
+
+/**
+ * Function Name:
+ * app_tput_indication_confirmed
+ *
+ * Function Description:
+ * @brief  Records the confirmation of the indication in flight. Called in
+ *         the Bluetooth stack thread on GATT_HANDLE_VALUE_CONF.
+ *
+ * @param p_ind      indication state of the client
+ *
+ * @return void
+ */
+void app_tput_indication_confirmed(app_tput_indication_t *p_ind)
+{
+    cy_time_t now = 0;
+    uint32_t rtt_ms;
+    uint32_t min_ms, max_ms;
+
+    if (!__atomic_load_n(&p_ind->in_flight, __ATOMIC_ACQUIRE))
+    {
+        return;
+    }
+    cy_rtos_get_time(&now);
+    rtt_ms = (uint32_t)(now - p_ind->sent_time);
+
+    /* tput_task resets the extremes on each report, so update them with
+     * compare and swap rather than overwrite a reset */
+    min_ms = __atomic_load_n(&p_ind->rtt_min_ms, __ATOMIC_RELAXED);
+    while ((rtt_ms < min_ms) &&
+           !__atomic_compare_exchange_n(&p_ind->rtt_min_ms, &min_ms, rtt_ms, false,
+                                        __ATOMIC_RELAXED, __ATOMIC_RELAXED))
+    {
+    }
+    max_ms = __atomic_load_n(&p_ind->rtt_max_ms, __ATOMIC_RELAXED);
+    while ((rtt_ms > max_ms) &&
+           !__atomic_compare_exchange_n(&p_ind->rtt_max_ms, &max_ms, rtt_ms, false,
+                                        __ATOMIC_RELAXED, __ATOMIC_RELAXED))
+    {
+    }
+    app_tput_counter_add(&p_ind->rtt, rtt_ms);
+    app_tput_counter_add(&p_ind->acked, p_ind->len);
+
+    /* Let notify_task send the next indication */
+    __atomic_store_n(&p_ind->in_flight, WICED_FALSE, __ATOMIC_RELEASE);
+}
+
+/**
+ * Function Name:
+ * app_tput_indication_report
+ *
+ * Function Description:
+ * @brief  Returns the round trip times of the confirmations received since
+ *         the previous report. Called by tput_task.
+ *
+ * @param p_ind      indication state of the client
+ * @param p_report   round trip times, filled
+ *
+ * @return void
+ */
+void app_tput_indication_report(app_tput_indication_t *p_ind, app_tput_indication_report_t *p_report)
+{
+    app_tput_counter_snapshot_t rtt;
+    uint32_t min_ms, max_ms;
+
+    /* A confirmation landing between the reset of the extremes and the
+     * snapshot counts in this mean and in the next report's extremes */
+    min_ms = __atomic_exchange_n(&p_ind->rtt_min_ms, UINT32_MAX, __ATOMIC_RELAXED);
+    max_ms = __atomic_exchange_n(&p_ind->rtt_max_ms, 0, __ATOMIC_RELAXED);
+    app_tput_counter_snapshot(&p_ind->rtt, &rtt);
+
+    p_report->count = (uint32_t)(rtt.packets - p_ind->reported_count);
+    p_report->mean_ms = (0 != p_report->count) ?
+                        (uint32_t)((rtt.bytes - p_ind->reported_sum_ms) / p_report->count) : 0;
+    p_report->min_ms = (UINT32_MAX != min_ms) ? min_ms : 0;
+    p_report->max_ms = max_ms;
+    p_ind->reported_count = rtt.packets;
+    p_ind->reported_sum_ms = rtt.bytes;
+}
+
+
+/* [] END OF FILE */
@@ -0,0 +1,95 @@
+/******************************************************************************
+* File Name:   app_tput_indication.h
+*
+* Description: This file contains the definitions of the indication mode,
+*              which tracks the confirmation of every indication sent on
+*              the Notify characteristic.
+*
+* Related Document: See README.md
+*
+********************************************************************************
+* Copyright 2021-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef __APP_TPUT_INDICATION_H__
+#define __APP_TPUT_INDICATION_H__
+
+/******************************************************************************
+ *                                INCLUDES
+ ******************************************************************************/
+#include <stdint.h>
+#include "wiced_bt_dev.h"
+#include "cyabs_rtos.h"
+#include "app_tput_counters.h"
+
+/******************************************************************************
+ *                                Structures
+ ******************************************************************************/
+/* Indication state of one client. ATT allows one outstanding indication per
+ * bearer, so the next indication is only sent once the client confirmed the
+ * previous one. */
+typedef struct
+{
+    volatile wiced_bool_t in_flight;    /* indication waiting for its confirmation */
+    cy_time_t             sent_time;    /* time the indication was sent */
+    uint16_t              len;          /* length of the indication in flight */
+    app_tput_counter_t    acked;        /* confirmed bytes, written by the stack thread */
+    uint64_t              reported_acked;
+    app_tput_counter_t    rtt;          /* bytes: sum of the round trip times in ms,
+                                         * packets: confirmations received */
+    uint64_t              reported_sum_ms;
+    uint64_t              reported_count;
+    volatile uint32_t     rtt_min_ms;   /* since the previous report, UINT32_MAX if none */
+    volatile uint32_t     rtt_max_ms;   /* since the previous report */
+} app_tput_indication_t;
+
+/* Confirmation round trip times since the previous report */
+typedef struct
+{
+    uint32_t count;
+    uint32_t mean_ms;
+    uint32_t min_ms;
+    uint32_t max_ms;
+} app_tput_indication_report_t;
+
+/****************************************************************************
+ *                              FUNCTION DECLARATIONS
+ ***************************************************************************/
+void app_tput_indication_init(app_tput_indication_t *p_ind);
+void app_tput_indication_sent(app_tput_indication_t *p_ind, uint16_t len);
+void app_tput_indication_confirmed(app_tput_indication_t *p_ind);
+void app_tput_indication_report(app_tput_indication_t *p_ind, app_tput_indication_report_t *p_report);
+
+#endif      /* __APP_TPUT_INDICATION_H__ */
+
+
+/* [] END OF FILE */
@@ -0,0 +1,426 @@
+/******************************************************************************
+* File Name:   app_tput_link.c
+*
+* Description: This file contains the link monitor. It samples the RSSI,
+*              the throughput and the congestion of every link and moves
+*              the link to a slower, more robust PHY when it degrades and
+*              back when it recovers, with hysteresis between the two.
+*
+* Related Document: See README.md
+*
+********************************************************************************
+* Copyright 2021-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/******************************************************************************
+ *                                INCLUDES
+ ******************************************************************************/
+#include <stdio.h>
+#include <string.h>
+#include "wiced_bt_ble.h"
+#include "app_tput_link.h"
+#include "app_bt_conn.h"
+
+/******************************************************************************
+ *                                Constants
+ ******************************************************************************/
+/* rssi_avg value before the first RSSI sample */
+#define APP_TPUT_LINK_RSSI_NONE                 (INT16_MIN)
+
+/******************************************************************************
+ *                                Variable Definitions
+ ******************************************************************************/
+/* Filtered RSSI below which a level is poor, in dBm. A link moves back to a
+ * level once the RSSI is APP_TPUT_LINK_HYSTERESIS_DB above its threshold. */
+static const int8_t link_poor_rssi[APP_TPUT_LINK_LEVELS] =
+{
+    [APP_TPUT_LINK_2M]       = -72,
+    [APP_TPUT_LINK_1M]       = -82,
+    [APP_TPUT_LINK_CODED_S2] = -90,
+    [APP_TPUT_LINK_CODED_S8] = INT8_MIN,
+};
+
+/* PHY Control command parameter of each level */
+static const uint8_t link_ctrl_phy[APP_TPUT_LINK_LEVELS] =
+{
+    [APP_TPUT_LINK_2M]       = BTM_BLE_PREFER_2M_PHY,
+    [APP_TPUT_LINK_1M]       = BTM_BLE_PREFER_1M_PHY,
+    [APP_TPUT_LINK_CODED_S2] = BTM_BLE_PREFER_LELR_PHY | APP_TPUT_CTRL_PHY_CODED_S2,
+    [APP_TPUT_LINK_CODED_S8] = BTM_BLE_PREFER_LELR_PHY | APP_TPUT_CTRL_PHY_CODED_S8,
+};
+
+static const char *link_level_name[APP_TPUT_LINK_LEVELS] =
+{
+    [APP_TPUT_LINK_2M]       = "2M",
+    [APP_TPUT_LINK_1M]       = "1M",
+    [APP_TPUT_LINK_CODED_S2] = "Coded S2",
+    [APP_TPUT_LINK_CODED_S8] = "Coded S8",
+};
+
+/****************************************************************************
+ *                              FUNCTION DEFINITIONS
+ ***************************************************************************/
+
+/**
+ * Function Name:
+ * app_tput_link_level_of
+ *
+ * Function Description:
+ * @brief  Returns the fastest level allowed by a PHY preference
+ *
+ * @param phy        PHY Control command parameter
+ *
+ * @return uint8_t   app_tput_link_level_t
+ */
+static uint8_t app_tput_link_level_of(uint8_t phy)
+{
+    if (phy & BTM_BLE_PREFER_2M_PHY)
+    {
+        return APP_TPUT_LINK_2M;
+    }
+    if (phy & BTM_BLE_PREFER_1M_PHY)
+    {
+        return APP_TPUT_LINK_1M;
+    }
+    if (phy & APP_TPUT_CTRL_PHY_CODED_S8)
+    {
+        return APP_TPUT_LINK_CODED_S8;
+    }
+    return APP_TPUT_LINK_CODED_S2;
+}
+
+/**
+ * Function Name:
+ * app_tput_link_init
+ *
+ * Function Description:
+ * @brief  Initializes the link monitor of a new connection
+ *
+ * @param p_link     link monitor state
+ * @param phy        PHY preference requested at connection
+ *
+ * @return void
+ */
+void app_tput_link_init(app_tput_link_t *p_link, uint8_t phy)
+{
+    cy_time_t now = 0;
+
+    cy_rtos_get_time(&now);
+    memset(p_link, 0, sizeof(app_tput_link_t));
+    p_link->enabled = APP_TPUT_LINK_MONITOR ? WICED_TRUE : WICED_FALSE;
+    p_link->level = app_tput_link_level_of(phy);
+    p_link->max_level = APP_TPUT_LINK_CODED_S8;
+    p_link->phy_requested = phy;
+    p_link->phy_seen = phy;
+    p_link->rssi_avg = APP_TPUT_LINK_RSSI_NONE;
+    p_link->last_time = now;
+    p_link->change_time = now;
+}
+
+/**
+ * Function Name:
+ * app_tput_link_level_name
+ *
+ * Function Description:
+ * @brief  Returns the name of a link monitor level
+ *
+ * @param level      app_tput_link_level_t
+ *
+ * @return const char*  name of the level
+ */
+const char *app_tput_link_level_name(uint8_t level)
+{
+    return (level < APP_TPUT_LINK_LEVELS) ? link_level_name[level] : "?";
+}
+
+/**
+ * Function Name:
+ * app_tput_link_phy_name
+ *
+ * Function Description:
+ * @brief  Returns the name of a PHY reported by BTM_BLE_PHY_UPDATE_EVT
+ *
+ * @param phy        PHY reported by the controller
+ *
+ * @return const char*  name of the PHY
+ */
+const char *app_tput_link_phy_name(uint8_t phy)
+{
+    switch (phy)
+    {
+    case 1:
+        return "1M";
+    case 2:
+        return "2M";
+    case APP_TPUT_LINK_PHY_CODED:
+        return "Coded";
+    default:
+        return "?";
+    }
+}
+
+/**
+ * Function Name:
+ * app_tput_link_rssi_cb
+ *
+ * Function Description:
+ * @brief  Completion callback of wiced_bt_dev_read_rssi, called in the
+ *         Bluetooth stack thread
+ *
+ * @param p_data     wiced_bt_dev_rssi_result_t of the read
+ *
+ * @return void
+ */
+static void app_tput_link_rssi_cb(void *p_data)
+{
+    wiced_bt_dev_rssi_result_t *p_result = (wiced_bt_dev_rssi_result_t *)p_data;
+    conn_state_info_t *p_conn;
+
+    if ((NULL == p_result) || (WICED_BT_SUCCESS != p_result->status))
+    {
+        return;
+    }
+    p_conn = app_bt_conn_find_by_bda(p_result->rem_bda);
+    if (NULL != p_conn)
+    {
+        p_conn->link.rssi = p_result->rssi;
+        p_conn->link.rssi_valid = WICED_TRUE;
+    }
+}
+
+/**
+ * Function Name:
+ * app_tput_link_apply
+ *
+ * Function Description:
+ * @brief  Requests the PHY of a level through the PHY Control command. It
+ *         is queued for notify_task like a Control write, so tput_task
+ *         neither changes the connection state nor calls the stack.
+ *
+ * @param p_conn     client
+ * @param level      app_tput_link_level_t to move to
+ * @param now        current time in ms
+ *
+ * @return void
+ */
+static void app_tput_link_apply(conn_state_info_t *p_conn, uint8_t level, cy_time_t now)
+{
+    app_tput_link_t *p_link = &p_conn->link;
+    uint8_t cmd[2] = { APP_TPUT_CTRL_CMD_PHY, link_ctrl_phy[level] };
+
+    printf("Link monitor: %s -> %s, RSSI %d dBm, %lu kbps [conn_id %d]\n",
+           link_level_name[p_link->level], link_level_name[level],
+           (APP_TPUT_LINK_RSSI_NONE == p_link->rssi_avg) ? 0 : (p_link->rssi_avg / 16),
+           (unsigned long)p_link->kbps, p_conn->conn_id);
+
+    if (WICED_BT_GATT_SUCCESS != app_tput_ctrl_submit(p_conn->conn_id, cmd, sizeof(cmd)))
+    {
+        printf("Link monitor: PHY change rejected [conn_id %d]\n", p_conn->conn_id);
+        return;
+    }
+
+    /* ctrl.phy follows once notify_task applies the command */
+    p_link->phy_requested = link_ctrl_phy[level];
+    p_link->level = level;
+    p_link->change_time = now;
+    p_link->poor_count = 0;
+    p_link->good_count = 0;
+}
+
+/**
+ * Function Name:
+ * app_tput_link_evaluate
+ *
+ * Function Description:
+ * @brief  Classifies the last period of a link as poor, good or neither
+ *         and changes the PHY once enough consecutive periods agree
+ *
+ * @param p_conn     client
+ * @param congestion congestion events during the period
+ * @param now        current time in ms
+ *
+ * @return void
+ */
+static void app_tput_link_evaluate(conn_state_info_t *p_conn, uint32_t congestion, cy_time_t now)
+{
+    app_tput_link_t *p_link = &p_conn->link;
+    wiced_bool_t has_rssi = (APP_TPUT_LINK_RSSI_NONE != p_link->rssi_avg) ? WICED_TRUE : WICED_FALSE;
+    int16_t rssi = p_link->rssi_avg / 16;
+    uint8_t level = p_link->level;
+    wiced_bool_t poor;
+    wiced_bool_t good;
+
+    /* A Coded PHY request the peer did not follow is not retried */
+    if ((level >= APP_TPUT_LINK_CODED_S2) && (APP_TPUT_LINK_PHY_CODED != p_conn->tx_phy))
+    {
+        printf("Link monitor: Coded PHY not accepted by the peer [conn_id %d]\n", p_conn->conn_id);
+        p_link->max_level = APP_TPUT_LINK_1M;
+        app_tput_link_apply(p_conn, APP_TPUT_LINK_1M, now);
+        return;
+    }
+
+    if (p_link->kbps > p_link->best_kbps[level])
+    {
+        p_link->best_kbps[level] = p_link->kbps;
+    }
+
+    /* Poor: weak signal, or congestion with throughput well below what the
+     * PHY achieved before. Congestion alone only means the link is full. */
+    poor = ((has_rssi) && (rssi < link_poor_rssi[level])) ||
+           ((0 != congestion) &&
+            ((uint64_t)p_link->kbps * 100u < (uint64_t)p_link->best_kbps[level] * APP_TPUT_LINK_DROP_PERCENT));
+    /* Good: signal comfortably above the threshold of the faster PHY */
+    good = (has_rssi) && (level > APP_TPUT_LINK_2M) && (0 == congestion) &&
+           (rssi > (link_poor_rssi[level - 1] + APP_TPUT_LINK_HYSTERESIS_DB));
+
+    if (poor)
+    {
+        p_link->good_count = 0;
+        if ((++p_link->poor_count >= APP_TPUT_LINK_DOWN_COUNT) && (level < p_link->max_level))
+        {
+            p_link->fallbacks++;
+            app_tput_link_apply(p_conn, level + 1, now);
+        }
+    }
+    else if (good)
+    {
+        p_link->poor_count = 0;
+        if (++p_link->good_count >= APP_TPUT_LINK_UP_COUNT)
+        {
+            p_link->recoveries++;
+            app_tput_link_apply(p_conn, level - 1, now);
+        }
+    }
+    else
+    {
+        p_link->poor_count = 0;
+        p_link->good_count = 0;
+    }
+}
+
+/**
+ * Function Name:
+ * app_tput_link_poll
+ *
+ * Function Description:
+ * @brief  Samples the RSSI, throughput and congestion of every monitored
+ *         link once per APP_TPUT_LINK_PERIOD_MS and evaluates it. Called
+ *         by tput_task every statistics bucket.
+ *
+ * @param void
+ *
+ * @return void
+ */
+void app_tput_link_poll(void)
+{
+    conn_state_info_t *p_conn;
+    app_tput_link_t *p_link;
+    app_tput_counter_snapshot_t tx_snap, rx_snap;
+    cy_time_t now = 0;
+    uint32_t elapsed_ms;
+    uint32_t congestion;
+    uint64_t bytes;
+    uint8_t phy;
+
+    cy_rtos_get_time(&now);
+    for (uint8_t index = 0; index < APP_BT_MAX_CONNECTIONS; index++)
+    {
+        p_conn = app_bt_conn_get(index);
+        if ((NULL == p_conn) || (!p_conn->link.enabled))
+        {
+            continue;
+        }
+        p_link = &p_conn->link;
+
+        elapsed_ms = (uint32_t)(now - p_link->last_time);
+        if (elapsed_ms < APP_TPUT_LINK_PERIOD_MS)
+        {
+            continue;
+        }
+        app_tput_counter_snapshot(&p_conn->tx_ctr, &tx_snap);
+        app_tput_counter_snapshot(&p_conn->rx_ctr, &rx_snap);
+        bytes = tx_snap.bytes + rx_snap.bytes;
+        congestion = p_conn->congestion_events - p_link->last_congestion;
+        p_link->kbps = (uint32_t)(((bytes - p_link->last_bytes) * 8u) / elapsed_ms);
+        p_link->last_bytes = bytes;
+        p_link->last_congestion = p_conn->congestion_events;
+        p_link->last_time = now;
+
+        /* Exponential average of the RSSI over about four samples */
+        if (p_link->rssi_valid)
+        {
+            p_link->rssi_valid = WICED_FALSE;
+            if (APP_TPUT_LINK_RSSI_NONE == p_link->rssi_avg)
+            {
+                p_link->rssi_avg = (int16_t)(p_link->rssi * 16);
+            }
+            else
+            {
+                p_link->rssi_avg += (int16_t)((p_link->rssi * 16 - p_link->rssi_avg) / 4);
+            }
+        }
+        wiced_bt_dev_read_rssi(p_conn->remote_addr, BT_TRANSPORT_LE, app_tput_link_rssi_cb);
+
+        /* Follow a PHY chosen through the Control characteristic. ctrl.phy
+         * is written by notify_task; a change to the PHY this monitor
+         * submitted is its own and leaves the level alone. */
+        phy = __atomic_load_n(&p_conn->ctrl.phy, __ATOMIC_RELAXED);
+        if (phy != p_link->phy_seen)
+        {
+            p_link->phy_seen = phy;
+        }
+        else
+        {
+            phy = p_link->phy_requested;
+        }
+        if (phy != p_link->phy_requested)
+        {
+            p_link->phy_requested = phy;
+            p_link->level = app_tput_link_level_of(phy);
+            p_link->change_time = now;
+            p_link->poor_count = 0;
+            p_link->good_count = 0;
+        }
+
+        /* Leave the PHY alone while a sweep measures it or a new PHY settles */
+        if ((APP_TPUT_AUTOTUNE_SETTLE == p_conn->autotune.state) ||
+            (APP_TPUT_AUTOTUNE_MEASURE == p_conn->autotune.state) ||
+            ((uint32_t)(now - p_link->change_time) < APP_TPUT_LINK_HOLD_MS))
+        {
+            continue;
+        }
+        app_tput_link_evaluate(p_conn, congestion, now);
+    }
+}
+
+
+/* [] END OF FILE */
@@ -0,0 +1,147 @@
+/******************************************************************************
+* File Name:   app_tput_link.h
+*
+* Description: This file contains the definitions of the link monitor,
+*              which moves a connection between the 2M, 1M and Coded PHYs
+*              as its RSSI and throughput change.
+*
+* Related Document: See README.md
+*
+********************************************************************************
+* Copyright 2021-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef __APP_TPUT_LINK_H__
+#define __APP_TPUT_LINK_H__
+
+/******************************************************************************
+ *                                INCLUDES
+ ******************************************************************************/
+#include <stdint.h>
+#include "wiced_bt_dev.h"
+#include "cyabs_rtos.h"
+#include "app_tput_config.h"
+
+/******************************************************************************
+ *                                Constants
+ ******************************************************************************/
+/* Enable the link monitor on new connections. Clients can enable it with
+ * the LINK_MONITOR Control command */
+#ifndef APP_TPUT_LINK_MONITOR
+#define APP_TPUT_LINK_MONITOR                   (0)
+#endif
+
+/* Period of the RSSI samples and link evaluations */
+#ifndef APP_TPUT_LINK_PERIOD_MS
+#define APP_TPUT_LINK_PERIOD_MS                 (1000)
+#endif
+
+/* Consecutive poor evaluations before moving to a slower PHY */
+#ifndef APP_TPUT_LINK_DOWN_COUNT
+#define APP_TPUT_LINK_DOWN_COUNT                (3)
+#endif
+
+/* Consecutive good evaluations before moving to a faster PHY */
+#ifndef APP_TPUT_LINK_UP_COUNT
+#define APP_TPUT_LINK_UP_COUNT                  (5)
+#endif
+
+/* Time a new PHY is kept before the link is evaluated again */
+#ifndef APP_TPUT_LINK_HOLD_MS
+#define APP_TPUT_LINK_HOLD_MS                   (5000)
+#endif
+
+/* RSSI margin above the fallback threshold needed to move back up, in dB */
+#ifndef APP_TPUT_LINK_HYSTERESIS_DB
+#define APP_TPUT_LINK_HYSTERESIS_DB             (6)
+#endif
+
+/* A congested evaluation whose throughput fell below this percentage of the
+ * best seen on the PHY counts as poor */
+#ifndef APP_TPUT_LINK_DROP_PERCENT
+#define APP_TPUT_LINK_DROP_PERCENT              (50)
+#endif
+
+/* PHY reported by BTM_BLE_PHY_UPDATE_EVT for the Coded PHY */
+#define APP_TPUT_LINK_PHY_CODED                 (3)
+
+/******************************************************************************
+ *                                Enumerations
+ ******************************************************************************/
+/* PHYs used by the link monitor, fastest first */
+typedef enum
+{
+    APP_TPUT_LINK_2M,
+    APP_TPUT_LINK_1M,
+    APP_TPUT_LINK_CODED_S2,
+    APP_TPUT_LINK_CODED_S8,
+    APP_TPUT_LINK_LEVELS
+} app_tput_link_level_t;
+
+/******************************************************************************
+ *                                Structures
+ ******************************************************************************/
+/* Link monitor state of one client, driven by tput_task */
+typedef struct
+{
+    wiced_bool_t     enabled;
+    uint8_t          level;             /* app_tput_link_level_t in use */
+    uint8_t          max_level;         /* slowest level the peer accepted */
+    uint8_t          phy_requested;     /* PHY of the level last applied */
+    uint8_t          phy_seen;          /* ctrl.phy at the last evaluation */
+    volatile int8_t  rssi;              /* last RSSI read, dBm */
+    volatile wiced_bool_t rssi_valid;
+    int16_t          rssi_avg;          /* filtered RSSI, 1/16 dBm */
+    uint8_t          poor_count;        /* consecutive poor evaluations */
+    uint8_t          good_count;        /* consecutive good evaluations */
+    uint32_t         fallbacks;         /* moves to a slower PHY */
+    uint32_t         recoveries;        /* moves to a faster PHY */
+    cy_time_t        last_time;         /* time of the last evaluation */
+    cy_time_t        change_time;       /* time of the last PHY change */
+    uint64_t         last_bytes;        /* TX + RX bytes at the last evaluation */
+    uint32_t         last_congestion;   /* congestion events at the last evaluation */
+    uint32_t         kbps;              /* throughput of the last evaluation */
+    uint32_t         best_kbps[APP_TPUT_LINK_LEVELS]; /* best throughput seen per level */
+} app_tput_link_t;
+
+/****************************************************************************
+ *                              FUNCTION DECLARATIONS
+ ***************************************************************************/
+void        app_tput_link_init(app_tput_link_t *p_link, uint8_t phy);
+void        app_tput_link_poll(void);
+const char *app_tput_link_level_name(uint8_t level);
+const char *app_tput_link_phy_name(uint8_t phy);
+
+#endif      /* __APP_TPUT_LINK_H__ */
+
+
+/* [] END OF FILE */
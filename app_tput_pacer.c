@@ -0,0 +1,169 @@
+/******************************************************************************
+* File Name:   app_tput_pacer.c
+*
+* Description: This file contains the adaptive notification burst pacing
+*              used by notify_task. The burst size of each link follows an
+*              additive-increase, multiplicative-decrease (AIMD) rule driven by
+*              the congestion reported by the stack.
+*
+* Related Document: See README.md
+*
+********************************************************************************
+* Copyright 2021-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/******************************************************************************
+ *                                INCLUDES
+ ******************************************************************************/
+#include "app_tput_pacer.h"
+
+/****************************************************************************
+ *                              FUNCTION DEFINITIONS
+ ***************************************************************************/
+
+/**
+ * Function Name:
+ * app_tput_pacer_init
+ *
+ * Function Description:
+ * @brief  Resets the pacing state of a link. The first burst uses
+ *         PACKET_PER_EVENT notifications.
+ *
+ * @param p_pacer    pacing state of the link
+ *
+ * @return void
+ */
+void app_tput_pacer_init(app_tput_pacer_t *p_pacer)
+{
+    p_pacer->burst = PACKET_PER_EVENT;
+    p_pacer->fixed_burst = 0;
+    p_pacer->rounds = 0;
+    p_pacer->congested_rounds = 0;
+    p_pacer->reported_rounds = 0;
+    p_pacer->reported_congested = 0;
+}
+
+/**
+ * Function Name:
+ * app_tput_pacer_set_fixed
+ *
+ * Function Description:
+ * @brief  Fixes the burst size, or returns to adaptive pacing starting from
+ *         PACKET_PER_EVENT
+ *
+ * @param p_pacer    pacing state of the link
+ * @param burst      notifications per round, 0 for adaptive pacing
+ *
+ * @return void
+ */
+void app_tput_pacer_set_fixed(app_tput_pacer_t *p_pacer, uint16_t burst)
+{
+    p_pacer->fixed_burst = burst;
+    p_pacer->burst = (0 != burst) ? burst : PACKET_PER_EVENT;
+}
+
+/**
+ * Function Name:
+ * app_tput_pacer_on_round
+ *
+ * Function Description:
+ * @brief  Updates the burst size after a round of notifications. The burst
+ *         grows by APP_TPUT_PACER_INCREASE after a round accepted entirely by
+ *         the stack and is halved when the round hit congestion.
+ *
+ * @param p_pacer    pacing state of the link
+ * @param congested  WICED_TRUE if the stack reported congestion in the round
+ *
+ * @return void
+ */
+void app_tput_pacer_on_round(app_tput_pacer_t *p_pacer, wiced_bool_t congested)
+{
+    p_pacer->rounds++;
+
+    if (congested)
+    {
+        p_pacer->congested_rounds++;
+    }
+    if (0 != p_pacer->fixed_burst)
+    {
+        return;
+    }
+
+    if (congested)
+    {
+        p_pacer->burst /= 2;
+        if (p_pacer->burst < APP_TPUT_PACER_MIN_BURST)
+        {
+            p_pacer->burst = APP_TPUT_PACER_MIN_BURST;
+        }
+    }
+    else
+    {
+        p_pacer->burst += APP_TPUT_PACER_INCREASE;
+        if (p_pacer->burst > APP_TPUT_PACER_MAX_BURST)
+        {
+            p_pacer->burst = APP_TPUT_PACER_MAX_BURST;
+        }
+    }
+}
+
+/**
+ * Function Name:
+ * app_tput_pacer_report
+ *
+ * Function Description:
+ * @brief  Returns the percentage of rounds that hit congestion since the
+ *         previous call. Called once per throughput report.
+ *
+ * @param p_pacer    pacing state of the link
+ *
+ * @return uint32_t  congestion rate in percent
+ */
+uint32_t app_tput_pacer_report(app_tput_pacer_t *p_pacer)
+{
+    /* Read the congested count first, notify_task increments it after rounds */
+    uint32_t congested = p_pacer->congested_rounds;
+    uint32_t rounds = p_pacer->rounds;
+    uint32_t rate = 0;
+
+    if (rounds != p_pacer->reported_rounds)
+    {
+        rate = ((congested - p_pacer->reported_congested) * 100u) / (rounds - p_pacer->reported_rounds);
+    }
+    p_pacer->reported_rounds = rounds;
+    p_pacer->reported_congested = congested;
+
+    return rate;
+}
+
+
+/* [] END OF FILE */
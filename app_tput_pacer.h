@@ -0,0 +1,100 @@
+/******************************************************************************
+* File Name:   app_tput_pacer.h
+*
+* Description: This file contains the adaptive notification burst pacing
+*              used by notify_task. The burst size of each link follows an
+*              additive-increase, multiplicative-decrease (AIMD) rule driven by
+*              the congestion reported by the stack.
+*
+* Related Document: See README.md
+*
+********************************************************************************
+* Copyright 2021-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef __APP_TPUT_PACER_H__
+#define __APP_TPUT_PACER_H__
+
+/******************************************************************************
+ *                                INCLUDES
+ ******************************************************************************/
+#include <stdint.h>
+#include "wiced_bt_dev.h"
+#include "app_tput_config.h"
+
+/******************************************************************************
+ *                                Constants
+ ******************************************************************************/
+/* Smallest and largest notification burst, in packets */
+#ifndef APP_TPUT_PACER_MIN_BURST
+#define APP_TPUT_PACER_MIN_BURST                (1)
+#endif
+
+#ifndef APP_TPUT_PACER_MAX_BURST
+#define APP_TPUT_PACER_MAX_BURST                (32)
+#endif
+
+/* Packets added to the burst after each round sent without congestion */
+#ifndef APP_TPUT_PACER_INCREASE
+#define APP_TPUT_PACER_INCREASE                 (1)
+#endif
+
+/* Free controller TX buffers needed to start the next round without sleeping */
+#ifndef APP_TPUT_PACER_HEADROOM_BUFFERS
+#define APP_TPUT_PACER_HEADROOM_BUFFERS         (1)
+#endif
+
+/******************************************************************************
+ *                                Structures
+ ******************************************************************************/
+typedef struct
+{
+    uint16_t burst;                 /* notifications allowed in the next round */
+    uint16_t fixed_burst;           /* burst set by the client, 0 when adaptive */
+    uint32_t rounds;                /* rounds sent since connection */
+    uint32_t congested_rounds;      /* rounds that ended with congestion */
+    uint32_t reported_rounds;       /* rounds at the last throughput report */
+    uint32_t reported_congested;    /* congested rounds at the last throughput report */
+} app_tput_pacer_t;
+
+/****************************************************************************
+ *                              FUNCTION DECLARATIONS
+ ***************************************************************************/
+void     app_tput_pacer_init(app_tput_pacer_t *p_pacer);
+void     app_tput_pacer_set_fixed(app_tput_pacer_t *p_pacer, uint16_t burst);
+void     app_tput_pacer_on_round(app_tput_pacer_t *p_pacer, wiced_bool_t congested);
+uint32_t app_tput_pacer_report(app_tput_pacer_t *p_pacer);
+
+#endif      /* __APP_TPUT_PACER_H__ */
+
+
+/* [] END OF FILE */
@@ -0,0 +1,484 @@
+/******************************************************************************
+* File Name:   app_tput_payload.c
+*
+* Description: This file contains the notification payload generator. A
+*              low priority task fills a ring of buffers with the selected
+*              pattern ahead of the notify task, which only takes ready
+*              buffers and hands them to the stack.
+*
+* Related Document: See README.md
+*
+********************************************************************************
+* Copyright 2021-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/******************************************************************************
+ *                                INCLUDES
+ ******************************************************************************/
+#include <stdio.h>
+#include <string.h>
+#include "cyabs_rtos.h"
+#include "app_tput_payload.h"
+
+/******************************************************************************
+ *                                Constants
+ ******************************************************************************/
+#if (APP_TPUT_PAYLOAD_RING_SIZE < 1) || (APP_TPUT_PAYLOAD_RING_SIZE > 32)
+#error "APP_TPUT_PAYLOAD_RING_SIZE must be 1 to 32, one bit per buffer"
+#endif
+
+#define APP_TPUT_PAYLOAD_ALL_SLOTS              ((uint32_t)(0xFFFFFFFFull >> (32u - APP_TPUT_PAYLOAD_RING_SIZE)))
+
+/* Buffers are word aligned and sized for the largest notification */
+#define APP_TPUT_PAYLOAD_WORDS                  ((NOTIFICATION_MAX_DATA_SIZE + 3u) / 4u)
+#define APP_TPUT_PAYLOAD_BUF_SIZE               (APP_TPUT_PAYLOAD_WORDS * 4u)
+
+/******************************************************************************
+ *                                Variable Definitions
+ ******************************************************************************/
+/* A buffer is free (owned by the generator task), ready (filled, waiting for
+ * the notify task) or in flight (owned by the stack until transmitted). The
+ * stack releases buffers in any order, so the free and ready buffers are
+ * tracked in bitmaps rather than a FIFO: a buffer held by a congested client
+ * does not keep the generator from refilling the ones released after it. */
+static uint32_t payload_ring[APP_TPUT_PAYLOAD_RING_SIZE][APP_TPUT_PAYLOAD_WORDS];
+static uint32_t payload_free_map = APP_TPUT_PAYLOAD_ALL_SLOTS;
+static uint32_t payload_ready_map;
+static uint32_t payload_fill_slot = APP_TPUT_PAYLOAD_RING_SIZE - 1u; /* last slot filled, generator task only */
+static uint32_t payload_take_slot = APP_TPUT_PAYLOAD_RING_SIZE - 1u; /* last slot taken, notify task only */
+static volatile uint32_t payload_underruns;
+
+static volatile app_tput_payload_pattern_t payload_pattern = APP_TPUT_PAYLOAD_DEFAULT_PATTERN;
+
+/* Generator state, carried from one buffer to the next */
+static uint8_t payload_counter;
+static uint32_t payload_xorshift = 2463534242u;
+static uint32_t payload_text_offset;
+/* Replay buffer, published with a sequence lock so that the generator never
+ * pairs the pointer of one buffer with the length of another */
+static const uint8_t *payload_replay_data;
+static uint32_t payload_replay_len;
+static uint32_t payload_replay_seq;             /* odd while the buffer is updated */
+static uint32_t payload_replay_offset;
+
+static const char payload_text[] =
+    "Bluetooth Low Energy throughput depends on the connection interval, the "
+    "PHY, the ATT MTU, the LL data length and the number of packets the "
+    "controllers exchange in each connection event. ";
+
+static cy_thread_t payload_task_handle;
+static uint64_t payload_task_stack[APP_TPUT_PAYLOAD_TASK_STACK_SIZE / sizeof(uint64_t)];
+
+/****************************************************************************
+ *                              FUNCTION DEFINITIONS
+ ***************************************************************************/
+
+/**
+ * Function Name:
+ * app_tput_payload_copy_cyclic
+ *
+ * Function Description:
+ * @brief  Fills a buffer by repeating a source, continuing at *p_offset
+ *
+ * @param p_dst      buffer to fill
+ * @param len        length of the buffer
+ * @param p_src      source repeated
+ * @param src_len    length of the source
+ * @param p_offset   source offset, updated
+ *
+ * @return void
+ */
+static void app_tput_payload_copy_cyclic(uint8_t *p_dst, uint32_t len, const uint8_t *p_src,
+                                         uint32_t src_len, uint32_t *p_offset)
+{
+    uint32_t chunk;
+
+    if (*p_offset >= src_len)
+    {
+        *p_offset = 0;
+    }
+    while (len > 0)
+    {
+        chunk = src_len - *p_offset;
+        if (chunk > len)
+        {
+            chunk = len;
+        }
+        memcpy(p_dst, &p_src[*p_offset], chunk);
+        p_dst += chunk;
+        len -= chunk;
+        *p_offset += chunk;
+        if (*p_offset == src_len)
+        {
+            *p_offset = 0;
+        }
+    }
+}
+
+/**
+ * Function Name:
+ * app_tput_payload_next_slot
+ *
+ * Function Description:
+ * @brief  Returns the first slot set in a bitmap, searching from the slot
+ *         after the previous one so that the buffers are filled and sent in
+ *         ring order while they are released in order
+ *
+ * @param map        bitmap of the candidate slots
+ * @param previous   slot picked last time
+ *
+ * @return uint32_t  slot, APP_TPUT_PAYLOAD_RING_SIZE if the bitmap is empty
+ */
+static uint32_t app_tput_payload_next_slot(uint32_t map, uint32_t previous)
+{
+    uint32_t slot = previous;
+
+    for (uint32_t i = 0; i < APP_TPUT_PAYLOAD_RING_SIZE; i++)
+    {
+        slot = (slot + 1u) % APP_TPUT_PAYLOAD_RING_SIZE;
+        if (0 != (map & (1u << slot)))
+        {
+            return slot;
+        }
+    }
+    return APP_TPUT_PAYLOAD_RING_SIZE;
+}
+
+/**
+ * Function Name:
+ * app_tput_payload_get_replay
+ *
+ * Function Description:
+ * @brief  Reads the registered replay buffer, retrying while
+ *         app_tput_payload_set_replay() updates it
+ *
+ * @param pp_data    destination of the data pointer
+ *
+ * @return uint32_t  length of the data, 0 if none is registered
+ */
+static uint32_t app_tput_payload_get_replay(const uint8_t **pp_data)
+{
+    uint32_t seq_begin, seq_end;
+    uint32_t len;
+
+    while (true)
+    {
+        seq_begin = __atomic_load_n(&payload_replay_seq, __ATOMIC_ACQUIRE);
+        if (0 == (seq_begin & 1u))
+        {
+            *pp_data = payload_replay_data;
+            len = payload_replay_len;
+            __atomic_thread_fence(__ATOMIC_ACQUIRE);
+            seq_end = __atomic_load_n(&payload_replay_seq, __ATOMIC_RELAXED);
+            if (seq_begin == seq_end)
+            {
+                return (NULL != *pp_data) ? len : 0;
+            }
+        }
+        /* The writer was preempted in the middle of an update */
+        cy_rtos_delay_milliseconds(1);
+    }
+}
+
+/**
+ * Function Name:
+ * app_tput_payload_fill
+ *
+ * Function Description:
+ * @brief  Fills one ring buffer with the selected pattern
+ *
+ * @param p_words    buffer to fill
+ *
+ * @return void
+ */
+static void app_tput_payload_fill(uint32_t *p_words)
+{
+    uint8_t *p_bytes = (uint8_t *)p_words;
+    const uint8_t *p_replay = NULL;
+    uint32_t replay_len;
+    uint32_t x;
+
+    switch (payload_pattern)
+    {
+    case APP_TPUT_PAYLOAD_XORSHIFT:
+        x = payload_xorshift;
+        for (uint32_t i = 0; i < APP_TPUT_PAYLOAD_WORDS; i++)
+        {
+            x ^= x << 13;
+            x ^= x >> 17;
+            x ^= x << 5;
+            p_words[i] = x;
+        }
+        payload_xorshift = x;
+        break;
+
+    case APP_TPUT_PAYLOAD_ZERO:
+        memset(p_bytes, 0, APP_TPUT_PAYLOAD_BUF_SIZE);
+        break;
+
+    case APP_TPUT_PAYLOAD_TEXT:
+        app_tput_payload_copy_cyclic(p_bytes, APP_TPUT_PAYLOAD_BUF_SIZE, (const uint8_t *)payload_text,
+                                     sizeof(payload_text) - 1u, &payload_text_offset);
+        break;
+
+    case APP_TPUT_PAYLOAD_REPLAY:
+        replay_len = app_tput_payload_get_replay(&p_replay);
+        if (0 != replay_len)
+        {
+            app_tput_payload_copy_cyclic(p_bytes, APP_TPUT_PAYLOAD_BUF_SIZE, p_replay,
+                                         replay_len, &payload_replay_offset);
+            break;
+        }
+        /* The buffer was removed, fall back to the incrementing pattern */
+        /* fall through */
+
+    case APP_TPUT_PAYLOAD_INCREMENTING:
+    default:
+        for (uint32_t i = 0; i < APP_TPUT_PAYLOAD_BUF_SIZE; i++)
+        {
+            p_bytes[i] = payload_counter++;
+        }
+        break;
+    }
+}
+
+/**
+ * Function Name:
+ * app_tput_payload_task
+ *
+ * Function Description:
+ * @brief  Fills every free ring buffer, then sleeps until the stack
+ *         releases one
+ *
+ * @param arg        unused
+ *
+ * @return void
+ */
+static void app_tput_payload_task(cy_thread_arg_t arg)
+{
+    uint32_t slot;
+
+    while (true)
+    {
+        while (APP_TPUT_PAYLOAD_RING_SIZE !=
+               (slot = app_tput_payload_next_slot(__atomic_load_n(&payload_free_map, __ATOMIC_ACQUIRE),
+                                                  payload_fill_slot)))
+        {
+            __atomic_fetch_and(&payload_free_map, ~(1u << slot), __ATOMIC_RELAXED);
+            app_tput_payload_fill(payload_ring[slot]);
+            __atomic_fetch_or(&payload_ready_map, 1u << slot, __ATOMIC_RELEASE);
+            payload_fill_slot = slot;
+        }
+        cy_rtos_thread_wait_notification(CY_RTOS_NEVER_TIMEOUT);
+    }
+}
+
+/**
+ * Function Name:
+ * app_tput_payload_init
+ *
+ * Function Description:
+ * @brief  Creates the generator task, which fills the ring before the first
+ *         client connects
+ *
+ * @return void
+ */
+void app_tput_payload_init(void)
+{
+    cy_rslt_t result;
+
+    result = cy_rtos_thread_create(&payload_task_handle,
+                                   &app_tput_payload_task,
+                                   APP_TPUT_PAYLOAD_TASK_NAME,
+                                   &payload_task_stack,
+                                   sizeof(payload_task_stack),
+                                   CY_RTOS_PRIORITY_BELOWNORMAL,
+                                   0);
+    if (result != CY_RSLT_SUCCESS)
+    {
+        printf("Payload task creation failed 0x%lX\n", (unsigned long)result);
+    }
+}
+
+/**
+ * Function Name:
+ * app_tput_payload_set_pattern
+ *
+ * Function Description:
+ * @brief  Selects the pattern of the buffers generated from now on. Buffers
+ *         already in the ring keep the previous pattern.
+ *
+ * @param pattern    pattern to generate
+ *
+ * @return wiced_result_t  WICED_BADARG if the pattern is unknown, or is
+ *                         APP_TPUT_PAYLOAD_REPLAY with no buffer registered
+ */
+wiced_result_t app_tput_payload_set_pattern(app_tput_payload_pattern_t pattern)
+{
+    if ((pattern >= APP_TPUT_PAYLOAD_PATTERN_MAX) ||
+        ((APP_TPUT_PAYLOAD_REPLAY == pattern) && !app_tput_payload_has_replay()))
+    {
+        return WICED_BADARG;
+    }
+    payload_pattern = pattern;
+    return WICED_SUCCESS;
+}
+
+/**
+ * Function Name:
+ * app_tput_payload_get_pattern
+ *
+ * Function Description:
+ * @brief  Returns the pattern being generated
+ *
+ * @return app_tput_payload_pattern_t  current pattern
+ */
+app_tput_payload_pattern_t app_tput_payload_get_pattern(void)
+{
+    return payload_pattern;
+}
+
+/**
+ * Function Name:
+ * app_tput_payload_set_replay
+ *
+ * Function Description:
+ * @brief  Registers the data sent by APP_TPUT_PAYLOAD_REPLAY, for example a
+ *         capture of real traffic linked into the image. The data is
+ *         repeated and must stay valid while the pattern is used. Callers
+ *         must not register buffers from two tasks at once.
+ *
+ * @param p_data     data to replay, NULL to remove it
+ * @param len        length of the data
+ *
+ * @return void
+ */
+void app_tput_payload_set_replay(const uint8_t *p_data, uint32_t len)
+{
+    __atomic_store_n(&payload_replay_seq, payload_replay_seq + 1u, __ATOMIC_RELAXED);
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+    payload_replay_data = p_data;
+    payload_replay_len = (NULL != p_data) ? len : 0;
+    __atomic_store_n(&payload_replay_seq, payload_replay_seq + 1u, __ATOMIC_RELEASE);
+}
+
+/**
+ * Function Name:
+ * app_tput_payload_has_replay
+ *
+ * Function Description:
+ * @brief  Tells whether a buffer is registered for APP_TPUT_PAYLOAD_REPLAY
+ *
+ * @return bool      true if app_tput_payload_set_replay() registered data
+ */
+bool app_tput_payload_has_replay(void)
+{
+    const uint8_t *p_data;
+
+    return (0 != app_tput_payload_get_replay(&p_data));
+}
+
+/**
+ * Function Name:
+ * app_tput_payload_take
+ *
+ * Function Description:
+ * @brief  Takes the next ready buffer of the ring. Must only be called by
+ *         the notify task. The buffer is returned with
+ *         app_tput_payload_release() once the stack has transmitted it, or
+ *         if it is not sent.
+ *
+ * @return uint8_t*  buffer of NOTIFICATION_MAX_DATA_SIZE bytes, NULL if the
+ *                   generator has not caught up
+ */
+uint8_t *app_tput_payload_take(void)
+{
+    uint32_t slot = app_tput_payload_next_slot(__atomic_load_n(&payload_ready_map, __ATOMIC_ACQUIRE),
+                                               payload_take_slot);
+
+    if (APP_TPUT_PAYLOAD_RING_SIZE == slot)
+    {
+        payload_underruns++;
+        return NULL;
+    }
+    __atomic_fetch_and(&payload_ready_map, ~(1u << slot), __ATOMIC_RELAXED);
+    payload_take_slot = slot;
+    return (uint8_t *)payload_ring[slot];
+}
+
+/**
+ * Function Name:
+ * app_tput_payload_release
+ *
+ * Function Description:
+ * @brief  Returns a buffer obtained from app_tput_payload_take() to the
+ *         generator. Matches pfn_free_buffer_t, so it can be passed as the
+ *         context of a notification and called on
+ *         GATT_APP_BUFFER_TRANSMITTED_EVT.
+ *
+ * @param p_buf      buffer to release
+ *
+ * @return void
+ */
+void app_tput_payload_release(uint8_t *p_buf)
+{
+    uint32_t slot;
+
+    if (p_buf < (uint8_t *)payload_ring)
+    {
+        return;
+    }
+    slot = (uint32_t)(p_buf - (uint8_t *)payload_ring) / APP_TPUT_PAYLOAD_BUF_SIZE;
+    if (slot >= APP_TPUT_PAYLOAD_RING_SIZE)
+    {
+        return;
+    }
+    __atomic_fetch_or(&payload_free_map, 1u << slot, __ATOMIC_RELEASE);
+    cy_rtos_thread_set_notification(&payload_task_handle);
+}
+
+/**
+ * Function Name:
+ * app_tput_payload_get_underruns
+ *
+ * Function Description:
+ * @brief  Returns the number of times the notify task found no ready buffer
+ *
+ * @return uint32_t  underrun count
+ */
+uint32_t app_tput_payload_get_underruns(void)
+{
+    return payload_underruns;
+}
+
+
+/* [] END OF FILE */
@@ -0,0 +1,100 @@
+/******************************************************************************
+* File Name:   app_tput_payload.h
+*
+* Description: This file contains the notification payload generator. A
+*              low priority task fills a ring of buffers with the selected
+*              pattern ahead of the notify task, which only takes ready
+*              buffers and hands them to the stack.
+*
+* Related Document: See README.md
+*
+********************************************************************************
+* Copyright 2021-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef __APP_TPUT_PAYLOAD_H__
+#define __APP_TPUT_PAYLOAD_H__
+
+/******************************************************************************
+ *                                INCLUDES
+ ******************************************************************************/
+#include <stdbool.h>
+#include <stdint.h>
+#include "wiced_bt_dev.h"
+#include "app_tput_config.h"
+
+/******************************************************************************
+ *                                Constants
+ ******************************************************************************/
+/* Number of payload buffers in the ring, 32 at most. Bounds the
+ * notifications in flight in the stack across all clients */
+#ifndef APP_TPUT_PAYLOAD_RING_SIZE
+#define APP_TPUT_PAYLOAD_RING_SIZE              (32)
+#endif
+
+/* Pattern used until app_tput_payload_set_pattern() is called */
+#ifndef APP_TPUT_PAYLOAD_DEFAULT_PATTERN
+#define APP_TPUT_PAYLOAD_DEFAULT_PATTERN        (APP_TPUT_PAYLOAD_INCREMENTING)
+#endif
+
+#define APP_TPUT_PAYLOAD_TASK_NAME              "Payload Task"
+#define APP_TPUT_PAYLOAD_TASK_STACK_SIZE        (1024)
+
+/******************************************************************************
+ *                                Enumerations
+ ******************************************************************************/
+typedef enum
+{
+    APP_TPUT_PAYLOAD_INCREMENTING,      /* byte counter continuing across buffers */
+    APP_TPUT_PAYLOAD_XORSHIFT,          /* xorshift32 pseudo random bytes, incompressible */
+    APP_TPUT_PAYLOAD_ZERO,              /* all bytes zero */
+    APP_TPUT_PAYLOAD_TEXT,              /* English text, compressible */
+    APP_TPUT_PAYLOAD_REPLAY,            /* buffer registered with app_tput_payload_set_replay() */
+    APP_TPUT_PAYLOAD_PATTERN_MAX
+} app_tput_payload_pattern_t;
+
+/****************************************************************************
+ *                              FUNCTION DECLARATIONS
+ ***************************************************************************/
+void           app_tput_payload_init(void);
+wiced_result_t app_tput_payload_set_pattern(app_tput_payload_pattern_t pattern);
+app_tput_payload_pattern_t app_tput_payload_get_pattern(void);
+void           app_tput_payload_set_replay(const uint8_t *p_data, uint32_t len);
+bool           app_tput_payload_has_replay(void);
+uint8_t       *app_tput_payload_take(void);
+void           app_tput_payload_release(uint8_t *p_buf);
+uint32_t       app_tput_payload_get_underruns(void);
+
+#endif      /* __APP_TPUT_PAYLOAD_H__ */
+
+
+/* [] END OF FILE */
@@ -0,0 +1,319 @@
+/******************************************************************************
+* File Name:   app_tput_ping.c
+*
+* Description: This file contains the Ping characteristic. A probe
+*              written by a client is echoed as a notification from the GATT
+*              callback itself, without going through notify_task, and the
+*              time from callback entry to the echo being handed to the stack
+*              is added to a log2 bucketed histogram.
+*
+* Related Document: See README.md
+*
+********************************************************************************
+* Copyright 2021-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/******************************************************************************
+ *                                INCLUDES
+ ******************************************************************************/
+#include <stddef.h>
+#include <stdio.h>
+#include <string.h>
+#include "GeneratedSource/cycfg_gatt_db.h"
+#include "app_tput_ping.h"
+#include "app_tput_cycles.h"
+#include "app_bt_conn.h"
+
+/******************************************************************************
+ *                                Structures
+ ******************************************************************************/
+/* Echo buffer, owned by the stack from the send until transmitted */
+typedef struct
+{
+    volatile wiced_bool_t in_use;
+    uint8_t               data[APP_TPUT_PING_MAX_LEN];
+} app_tput_ping_slot_t;
+
+/******************************************************************************
+ *                                Variable Definitions
+ ******************************************************************************/
+static app_tput_ping_slot_t ping_slots[APP_TPUT_PING_SLOTS];
+
+/* Cycle counter at the entry of the GATT callback being processed */
+static uint32_t ping_entry_cycles;
+
+/* Histogram, written by the Bluetooth stack thread only. ping_hist_seq is
+ * odd while it is updated so that readers can retry. */
+static volatile uint32_t ping_hist_seq;
+static app_tput_ping_hist_t ping_hist;
+
+/* Probe count at the previous report */
+static uint32_t ping_reported_count;
+
+/****************************************************************************
+ *                              FUNCTION DEFINITIONS
+ ***************************************************************************/
+
+/**
+ * Function Name:
+ * app_tput_ping_mark_entry
+ *
+ * Function Description:
+ * @brief  Records the entry of the GATT event callback, the start of the
+ *         latency of a probe
+ *
+ * @param void
+ *
+ * @return void
+ */
+void app_tput_ping_mark_entry(void)
+{
+    ping_entry_cycles = app_tput_cycles_now();
+}
+
+/**
+ * Function Name:
+ * app_tput_ping_release
+ *
+ * Function Description:
+ * @brief  Returns an echo buffer once transmitted, passed to the stack as the
+ *         free function of the notification
+ *
+ * @param p_buf      echo buffer
+ *
+ * @return void
+ */
+static void app_tput_ping_release(uint8_t *p_buf)
+{
+    app_tput_ping_slot_t *p_slot = (app_tput_ping_slot_t *)(p_buf - offsetof(app_tput_ping_slot_t, data));
+
+    __atomic_store_n(&p_slot->in_use, WICED_FALSE, __ATOMIC_RELEASE);
+}
+
+/**
+ * Function Name:
+ * app_tput_ping_record
+ *
+ * Function Description:
+ * @brief  Adds a latency to the histogram
+ *
+ * @param us         latency in microseconds
+ *
+ * @return void
+ */
+static void app_tput_ping_record(uint32_t us)
+{
+    uint32_t bucket = (us < 2u) ? 0u : (31u - (uint32_t)__builtin_clz(us));
+
+    if (bucket >= APP_TPUT_PING_HIST_BUCKETS)
+    {
+        bucket = APP_TPUT_PING_HIST_BUCKETS - 1u;
+    }
+
+    __atomic_store_n(&ping_hist_seq, ping_hist_seq + 1u, __ATOMIC_RELAXED);
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+    if ((0 == ping_hist.count) || (us < ping_hist.min_us))
+    {
+        ping_hist.min_us = us;
+    }
+    if (us > ping_hist.max_us)
+    {
+        ping_hist.max_us = us;
+    }
+    ping_hist.sum_us += us;
+    ping_hist.buckets[bucket]++;
+    ping_hist.count++;
+    __atomic_store_n(&ping_hist_seq, ping_hist_seq + 1u, __ATOMIC_RELEASE);
+}
+
+/**
+ * Function Name:
+ * app_tput_ping_write
+ *
+ * Function Description:
+ * @brief  Write handler of the Ping characteristic. Echoes the probe to the
+ *         client as a notification straight away and records the latency
+ *         from the GATT callback entry to the echo being handed to the stack.
+ *
+ * @param conn_id      Connection ID of the client writing the probe
+ * @param p_attr       attribute written
+ * @param p_val        probe, in the stack buffer
+ * @param len          length of the probe
+ *
+ * @return wiced_bt_gatt_status_t  Bluetooth LE GATT status
+ */
+wiced_bt_gatt_status_t app_tput_ping_write(uint16_t conn_id, gatt_db_lookup_table_t *p_attr,
+                                           uint8_t *p_val, uint16_t len)
+{
+    conn_state_info_t *p_conn = app_bt_conn_find(conn_id);
+    app_tput_ping_slot_t *p_slot = NULL;
+    wiced_bt_gatt_status_t status;
+
+    if (len > APP_TPUT_PING_MAX_LEN)
+    {
+        return WICED_BT_GATT_INVALID_ATTR_LEN;
+    }
+    if (NULL == p_conn)
+    {
+        return WICED_BT_GATT_SUCCESS;
+    }
+    if (!(p_conn->ping.cccd & GATT_CLIENT_CONFIG_NOTIFICATION))
+    {
+        p_conn->ping.dropped++;
+        return WICED_BT_GATT_SUCCESS;
+    }
+
+    for (uint8_t i = 0; i < APP_TPUT_PING_SLOTS; i++)
+    {
+        if (!__atomic_load_n(&ping_slots[i].in_use, __ATOMIC_ACQUIRE))
+        {
+            p_slot = &ping_slots[i];
+            break;
+        }
+    }
+    if (NULL == p_slot)
+    {
+        p_conn->ping.dropped++;
+        return WICED_BT_GATT_SUCCESS;
+    }
+
+    p_slot->in_use = WICED_TRUE;
+    memcpy(p_slot->data, p_val, len);
+    status = wiced_bt_gatt_server_send_notification(conn_id, HDLC_THROUGHPUT_MEASUREMENT_PING_VALUE,
+                                                    len, p_slot->data, (void *)app_tput_ping_release);
+    if (WICED_BT_GATT_SUCCESS != status)
+    {
+        p_slot->in_use = WICED_FALSE;
+        p_conn->ping.dropped++;
+        return WICED_BT_GATT_SUCCESS;
+    }
+    app_tput_ping_record(app_tput_cycles_to_us(app_tput_cycles_now() - ping_entry_cycles));
+    p_conn->ping.echoed++;
+    return WICED_BT_GATT_SUCCESS;
+}
+
+/**
+ * Function Name:
+ * app_tput_ping_cccd_write
+ *
+ * Function Description:
+ * @brief  Write handler of the Ping characteristic CCCD, kept per client
+ *
+ * @param conn_id      Connection ID of the client writing the value
+ * @param p_attr       attribute written
+ * @param p_val        written value
+ * @param len          length of the written value
+ *
+ * @return wiced_bt_gatt_status_t  Bluetooth LE GATT status
+ */
+wiced_bt_gatt_status_t app_tput_ping_cccd_write(uint16_t conn_id, gatt_db_lookup_table_t *p_attr,
+                                                uint8_t *p_val, uint16_t len)
+{
+    conn_state_info_t *p_conn = app_bt_conn_find(conn_id);
+
+    if (NULL != p_conn)
+    {
+        p_conn->ping.cccd = p_attr->p_data[0];
+    }
+    return WICED_BT_GATT_SUCCESS;
+}
+
+/**
+ * Function Name:
+ * app_tput_ping_get_hist
+ *
+ * Function Description:
+ * @brief  Returns a consistent copy of the latency histogram, retrying
+ *         while the stack thread updates it
+ *
+ * @param p_hist     copy of the histogram, filled
+ *
+ * @return void
+ */
+void app_tput_ping_get_hist(app_tput_ping_hist_t *p_hist)
+{
+    uint32_t seq;
+
+    do
+    {
+        seq = __atomic_load_n(&ping_hist_seq, __ATOMIC_ACQUIRE);
+        memcpy(p_hist, &ping_hist, sizeof(app_tput_ping_hist_t));
+        __atomic_thread_fence(__ATOMIC_ACQUIRE);
+    } while ((seq & 1u) || (seq != __atomic_load_n(&ping_hist_seq, __ATOMIC_RELAXED)));
+}
+
+/**
+ * Function Name:
+ * app_tput_ping_report
+ *
+ * Function Description:
+ * @brief  Prints the latency histogram when probes were echoed since the
+ *         previous report. Called by tput_task every report period.
+ *
+ * @param void
+ *
+ * @return void
+ */
+void app_tput_ping_report(void)
+{
+    app_tput_ping_hist_t hist;
+
+    app_tput_ping_get_hist(&hist);
+    if (hist.count == ping_reported_count)
+    {
+        return;
+    }
+    ping_reported_count = hist.count;
+
+    printf("Ping latency      : %lu probes, mean %lu us, min %lu us, max %lu us\n",
+           (unsigned long)hist.count, (unsigned long)(hist.sum_us / hist.count),
+           (unsigned long)hist.min_us, (unsigned long)hist.max_us);
+    for (uint32_t i = 0; i < APP_TPUT_PING_HIST_BUCKETS; i++)
+    {
+        if (0 == hist.buckets[i])
+        {
+            continue;
+        }
+        if (i == (APP_TPUT_PING_HIST_BUCKETS - 1u))
+        {
+            printf("  >= %5lu us      : %lu\n", (unsigned long)(1ul << i), (unsigned long)hist.buckets[i]);
+        }
+        else
+        {
+            printf("  %5lu - %5lu us : %lu\n", (unsigned long)((0 == i) ? 0ul : (1ul << i)),
+                   (unsigned long)(1ul << (i + 1)), (unsigned long)hist.buckets[i]);
+        }
+    }
+}
+
+
+/* [] END OF FILE */
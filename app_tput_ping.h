@@ -0,0 +1,105 @@
+/******************************************************************************
+* File Name:   app_tput_ping.h
+*
+* Description: This file contains the definitions of the Ping
+*              characteristic, which echoes every probe written by a client
+*              and records how long the server took to send the echo.
+*
+* Related Document: See README.md
+*
+********************************************************************************
+* Copyright 2021-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef __APP_TPUT_PING_H__
+#define __APP_TPUT_PING_H__
+
+/******************************************************************************
+ *                                INCLUDES
+ ******************************************************************************/
+#include <stdint.h>
+#include "wiced_bt_dev.h"
+#include "wiced_bt_gatt.h"
+#include "app_tput_config.h"
+#include "app_bt_attr_table.h"
+
+/******************************************************************************
+ *                                Constants
+ ******************************************************************************/
+/* Longest probe, the Ping value length in design.cybt */
+#define APP_TPUT_PING_MAX_LEN                   (20)
+
+/* Echoes in flight in the stack across all clients */
+#ifndef APP_TPUT_PING_SLOTS
+#define APP_TPUT_PING_SLOTS                     (4)
+#endif
+
+/* Histogram bucket i counts latencies of 2^i to 2^(i+1) us, bucket 0 also
+ * counts those under 1 us and the last bucket everything above */
+#define APP_TPUT_PING_HIST_BUCKETS              (16)
+
+/******************************************************************************
+ *                                Structures
+ ******************************************************************************/
+/* Ping state of one client */
+typedef struct
+{
+    uint16_t cccd;                      /* Ping CCCD of the client */
+    uint32_t echoed;                    /* probes echoed */
+    uint32_t dropped;                   /* probes not echoed */
+} app_tput_ping_t;
+
+/* Server latency from the GATT callback entry to the echo handed to the stack */
+typedef struct
+{
+    uint32_t count;
+    uint32_t min_us;
+    uint32_t max_us;
+    uint64_t sum_us;
+    uint32_t buckets[APP_TPUT_PING_HIST_BUCKETS];
+} app_tput_ping_hist_t;
+
+/****************************************************************************
+ *                              FUNCTION DECLARATIONS
+ ***************************************************************************/
+void                   app_tput_ping_mark_entry(void);
+wiced_bt_gatt_status_t app_tput_ping_write(uint16_t conn_id, gatt_db_lookup_table_t *p_attr,
+                                           uint8_t *p_val, uint16_t len);
+wiced_bt_gatt_status_t app_tput_ping_cccd_write(uint16_t conn_id, gatt_db_lookup_table_t *p_attr,
+                                                uint8_t *p_val, uint16_t len);
+void                   app_tput_ping_get_hist(app_tput_ping_hist_t *p_hist);
+void                   app_tput_ping_report(void);
+
+#endif      /* __APP_TPUT_PING_H__ */
+
+
+/* [] END OF FILE */
@@ -0,0 +1,100 @@
+/******************************************************************************
+* File Name:   app_tput_read.c
+*
+* Description: This file contains the read throughput value. Byte n of the
+*              value is n modulo 256, so the value is a window into one
+*              constant table and read responses need no buffer or copy.
+*
+* Related Document: See README.md
+*
+********************************************************************************
+* Copyright 2021-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/******************************************************************************
+ *                                INCLUDES
+ ******************************************************************************/
+#include "app_tput_read.h"
+
+/******************************************************************************
+ *                                Constants
+ ******************************************************************************/
+/* Period of the generated value */
+#define APP_TPUT_READ_PERIOD                    (256u)
+
+/******************************************************************************
+ *                                Variable Definitions
+ ******************************************************************************/
+/* One period for the start of any window plus the longest window */
+static uint8_t read_table[APP_TPUT_READ_PERIOD + APP_TPUT_READ_WINDOW_LEN];
+
+/****************************************************************************
+ *                              FUNCTION DEFINITIONS
+ ***************************************************************************/
+
+/**
+ * Function Name:
+ * app_tput_read_init
+ *
+ * Function Description:
+ * @brief  Fills the table the read windows are taken from
+ *
+ * @return void
+ */
+void app_tput_read_init(void)
+{
+    for (uint32_t i = 0; i < sizeof(read_table); i++)
+    {
+        read_table[i] = (uint8_t)(i % APP_TPUT_READ_PERIOD);
+    }
+}
+
+/**
+ * Function Name:
+ * app_tput_read_window
+ *
+ * Function Description:
+ * @brief  Returns the generated value from an offset on. The table is never
+ *         written after app_tput_read_init, so the window can be handed to the
+ *         stack without a context to free it.
+ *
+ * @param offset     offset of the first byte
+ *
+ * @return const uint8_t*  up to APP_TPUT_READ_WINDOW_LEN bytes of the value
+ */
+const uint8_t *app_tput_read_window(uint16_t offset)
+{
+    return &read_table[offset % APP_TPUT_READ_PERIOD];
+}
+
+
+/* [] END OF FILE */
@@ -0,0 +1,260 @@
+/******************************************************************************
+* File Name:   app_tput_stats.c
+*
+* Description: This file contains the throughput statistics engine. Byte and
+*              packet counters are sampled into fixed-period buckets kept in
+*              a sliding window, from which the throughput report computes
+*              mean, minimum, maximum and percentile throughput, packet rate
+*              and stalls.
+*
+* Related Document: See README.md
+*
+********************************************************************************
+* Copyright 2021-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/******************************************************************************
+ *                                INCLUDES
+ ******************************************************************************/
+#include <string.h>
+#include "app_tput_stats.h"
+
+/******************************************************************************
+ *                                Variable Definitions
+ ******************************************************************************/
+/* Throughput report period, a multiple of APP_TPUT_STATS_BUCKET_MS */
+static volatile uint32_t tput_report_period_ms = TPUT_REPORT_PERIOD_S * 1000;
+
+/****************************************************************************
+ *                              FUNCTION DEFINITIONS
+ ***************************************************************************/
+
+/**
+ * Function Name:
+ * app_tput_stats_sample
+ *
+ * Function Description:
+ * @brief  Closes the current bucket with the data transferred since the
+ *         previous sample. Called once per bucket period with the running
+ *         byte and packet counters of the stream.
+ *
+ * @param p_stats        statistics of the stream
+ * @param total_bytes    byte counter of the stream
+ * @param total_packets  packet counter of the stream
+ * @param active         WICED_TRUE if the stream is expected to carry data; an
+ *                       empty bucket of an active stream counts as a stall
+ *
+ * @return void
+ */
+void app_tput_stats_sample(app_tput_stats_t *p_stats, uint64_t total_bytes,
+                           uint64_t total_packets, wiced_bool_t active)
+{
+    app_tput_stats_bucket_t *p_bucket = &p_stats->bucket[p_stats->head];
+
+    p_bucket->bytes = (uint32_t)(total_bytes - p_stats->last_bytes);
+    p_bucket->packets = (uint32_t)(total_packets - p_stats->last_packets);
+    p_stats->last_bytes = total_bytes;
+    p_stats->last_packets = total_packets;
+
+    /* A stall starts with the first empty bucket of an active stream */
+    if (active && (0 == p_bucket->bytes))
+    {
+        if (!p_stats->stalled)
+        {
+            p_stats->stalls++;
+        }
+        p_stats->stalled = WICED_TRUE;
+    }
+    else
+    {
+        p_stats->stalled = WICED_FALSE;
+    }
+
+    p_stats->head = (p_stats->head + 1) % APP_TPUT_STATS_WINDOW_BUCKETS;
+    if (p_stats->count < APP_TPUT_STATS_WINDOW_BUCKETS)
+    {
+        p_stats->count++;
+    }
+}
+
+/**
+ * Function Name:
+ * app_tput_stats_report
+ *
+ * Function Description:
+ * @brief  Computes the statistics of the most recent buckets of the window
+ *
+ * @param p_stats    statistics of the stream
+ * @param buckets    number of most recent buckets to cover, capped to the
+ *                   buckets held by the window
+ * @param p_report   destination of the computed statistics
+ *
+ * @return void
+ */
+void app_tput_stats_report(app_tput_stats_t *p_stats, uint16_t buckets,
+                           app_tput_stats_report_t *p_report)
+{
+    uint32_t kbps[APP_TPUT_STATS_WINDOW_BUCKETS];
+    uint64_t packets = 0;
+    uint32_t value;
+    uint16_t index, i, j;
+
+    memset(p_report, 0, sizeof(app_tput_stats_report_t));
+    if (buckets > p_stats->count)
+    {
+        buckets = p_stats->count;
+    }
+    p_report->buckets = buckets;
+    p_report->stalls = p_stats->stalls - p_stats->reported_stalls;
+    p_stats->reported_stalls = p_stats->stalls;
+    if (0 == buckets)
+    {
+        return;
+    }
+
+    /* Walk back from the newest bucket; kbps of a bucket is bits per ms.
+     * Keep the values sorted with an insertion sort for the percentiles. */
+    index = p_stats->head;
+    for (i = 0; i < buckets; i++)
+    {
+        index = (index + APP_TPUT_STATS_WINDOW_BUCKETS - 1) % APP_TPUT_STATS_WINDOW_BUCKETS;
+        p_report->bytes += p_stats->bucket[index].bytes;
+        packets += p_stats->bucket[index].packets;
+
+        value = (p_stats->bucket[index].bytes * 8u) / APP_TPUT_STATS_BUCKET_MS;
+        for (j = i; (j > 0) && (kbps[j - 1] > value); j--)
+        {
+            kbps[j] = kbps[j - 1];
+        }
+        kbps[j] = value;
+    }
+
+    p_report->mean_kbps = (uint32_t)((p_report->bytes * 8u) / ((uint64_t)buckets * APP_TPUT_STATS_BUCKET_MS));
+    p_report->packets_per_s = (uint32_t)((packets * 1000u) / ((uint64_t)buckets * APP_TPUT_STATS_BUCKET_MS));
+    p_report->min_kbps = kbps[0];
+    p_report->max_kbps = kbps[buckets - 1];
+    /* Nearest-rank percentiles */
+    p_report->p50_kbps = kbps[((buckets * 50u) + 99u) / 100u - 1u];
+    p_report->p95_kbps = kbps[((buckets * 95u) + 99u) / 100u - 1u];
+    p_report->p99_kbps = kbps[((buckets * 99u) + 99u) / 100u - 1u];
+}
+
+/**
+ * Function Name:
+ * app_tput_stats_mean_kbps
+ *
+ * Function Description:
+ * @brief  Returns the mean throughput of the most recent buckets of the
+ *         window. Unlike app_tput_stats_report(), leaves the statistics
+ *         unchanged.
+ *
+ * @param p_stats    statistics of the stream
+ * @param buckets    number of most recent buckets to cover, capped to the
+ *                   buckets held by the window
+ *
+ * @return uint32_t  mean throughput in kbps, 0 before the first sample
+ */
+uint32_t app_tput_stats_mean_kbps(const app_tput_stats_t *p_stats, uint16_t buckets)
+{
+    uint64_t bytes = 0;
+    uint16_t index = p_stats->head;
+
+    if (buckets > p_stats->count)
+    {
+        buckets = p_stats->count;
+    }
+    if (0 == buckets)
+    {
+        return 0;
+    }
+    for (uint16_t i = 0; i < buckets; i++)
+    {
+        index = (index + APP_TPUT_STATS_WINDOW_BUCKETS - 1) % APP_TPUT_STATS_WINDOW_BUCKETS;
+        bytes += p_stats->bucket[index].bytes;
+    }
+    return (uint32_t)((bytes * 8u) / ((uint64_t)buckets * APP_TPUT_STATS_BUCKET_MS));
+}
+
+/**
+ * Function Name:
+ * app_tput_stats_set_report_period
+ *
+ * Function Description:
+ * @brief  Sets the throughput report period. The period is rounded down to a
+ *         whole number of buckets, at least one; statistics cover at most the
+ *         APP_TPUT_STATS_WINDOW_BUCKETS most recent buckets.
+ *
+ * @param period_ms  report period in milliseconds
+ *
+ * @return void
+ */
+void app_tput_stats_set_report_period(uint32_t period_ms)
+{
+    if (period_ms < APP_TPUT_STATS_BUCKET_MS)
+    {
+        period_ms = APP_TPUT_STATS_BUCKET_MS;
+    }
+    tput_report_period_ms = (period_ms / APP_TPUT_STATS_BUCKET_MS) * APP_TPUT_STATS_BUCKET_MS;
+}
+
+/**
+ * Function Name:
+ * app_tput_stats_get_report_period
+ *
+ * Function Description:
+ * @brief  Returns the throughput report period
+ *
+ * @return uint32_t  report period in milliseconds
+ */
+uint32_t app_tput_stats_get_report_period(void)
+{
+    return tput_report_period_ms;
+}
+
+/**
+ * Function Name:
+ * app_tput_stats_get_report_buckets
+ *
+ * Function Description:
+ * @brief  Returns the number of buckets in one report period
+ *
+ * @return uint16_t  buckets per report, at most APP_TPUT_STATS_WINDOW_BUCKETS
+ */
+uint16_t app_tput_stats_get_report_buckets(void)
+{
+    uint32_t buckets = tput_report_period_ms / APP_TPUT_STATS_BUCKET_MS;
+
+    return (uint16_t)((buckets > APP_TPUT_STATS_WINDOW_BUCKETS) ? APP_TPUT_STATS_WINDOW_BUCKETS : buckets);
+}
+
+
+/* [] END OF FILE */
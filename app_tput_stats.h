@@ -0,0 +1,118 @@
+/******************************************************************************
+* File Name:   app_tput_stats.h
+*
+* Description: This file contains the throughput statistics engine. Byte and
+*              packet counters are sampled into fixed-period buckets kept in
+*              a sliding window, from which the throughput report computes
+*              mean, minimum, maximum and percentile throughput, packet rate
+*              and stalls.
+*
+* Related Document: See README.md
+*
+********************************************************************************
+* Copyright 2021-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef __APP_TPUT_STATS_H__
+#define __APP_TPUT_STATS_H__
+
+/******************************************************************************
+ *                                INCLUDES
+ ******************************************************************************/
+#include <stdint.h>
+#include "wiced_bt_dev.h"
+#include "app_tput_config.h"
+
+/******************************************************************************
+ *                                Constants
+ ******************************************************************************/
+/* Length of one statistics bucket in milliseconds */
+#ifndef APP_TPUT_STATS_BUCKET_MS
+#define APP_TPUT_STATS_BUCKET_MS                (100)
+#endif
+
+/* Number of buckets kept in the sliding window, bounds the report period */
+#ifndef APP_TPUT_STATS_WINDOW_BUCKETS
+#define APP_TPUT_STATS_WINDOW_BUCKETS           (100)
+#endif
+
+/******************************************************************************
+ *                                Structures
+ ******************************************************************************/
+typedef struct
+{
+    uint32_t bytes;                 /* bytes transferred in the bucket */
+    uint32_t packets;               /* packets transferred in the bucket */
+} app_tput_stats_bucket_t;
+
+typedef struct
+{
+    app_tput_stats_bucket_t bucket[APP_TPUT_STATS_WINDOW_BUCKETS];
+    uint16_t     head;              /* next bucket to fill */
+    uint16_t     count;             /* buckets holding a sample */
+    uint64_t     last_bytes;        /* byte counter at the previous sample */
+    uint64_t     last_packets;      /* packet counter at the previous sample */
+    wiced_bool_t stalled;           /* last active bucket carried no data */
+    uint32_t     stalls;            /* stall episodes since connection */
+    uint32_t     reported_stalls;   /* stall episodes at the last report */
+} app_tput_stats_t;
+
+typedef struct
+{
+    uint32_t buckets;               /* buckets covered by the report */
+    uint64_t bytes;                 /* bytes transferred over the report */
+    uint32_t mean_kbps;             /* mean throughput */
+    uint32_t min_kbps;              /* throughput of the slowest bucket */
+    uint32_t max_kbps;              /* throughput of the fastest bucket */
+    uint32_t p50_kbps;              /* median bucket throughput */
+    uint32_t p95_kbps;              /* 95th percentile bucket throughput */
+    uint32_t p99_kbps;              /* 99th percentile bucket throughput */
+    uint32_t packets_per_s;         /* mean packet rate */
+    uint32_t stalls;                /* stall episodes since the previous report */
+} app_tput_stats_report_t;
+
+/****************************************************************************
+ *                              FUNCTION DECLARATIONS
+ ***************************************************************************/
+void     app_tput_stats_sample(app_tput_stats_t *p_stats, uint64_t total_bytes,
+                               uint64_t total_packets, wiced_bool_t active);
+void     app_tput_stats_report(app_tput_stats_t *p_stats, uint16_t buckets,
+                               app_tput_stats_report_t *p_report);
+uint32_t app_tput_stats_mean_kbps(const app_tput_stats_t *p_stats, uint16_t buckets);
+void     app_tput_stats_set_report_period(uint32_t period_ms);
+uint32_t app_tput_stats_get_report_period(void);
+uint16_t app_tput_stats_get_report_buckets(void);
+
+#endif      /* __APP_TPUT_STATS_H__ */
+
+
+/* [] END OF FILE */
@@ -0,0 +1,227 @@
+/******************************************************************************
+* File Name:   app_tput_telemetry.c
+*
+* Description: This file contains the Telemetry characteristic, which
+*              notifies each client of the throughput counters and link
+*              parameters seen by the server. Telemetry is only sent when
+*              the link has spare transmit capacity.
+*
+* Related Document: See README.md
+*
+********************************************************************************
+* Copyright 2021-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/******************************************************************************
+ *                                INCLUDES
+ ******************************************************************************/
+#include "wiced_bt_ble.h"
+#include "GeneratedSource/cycfg_gatt_db.h"
+#include "app_tput_telemetry.h"
+#include "app_bt_conn.h"
+
+/******************************************************************************
+ *                                Constants
+ ******************************************************************************/
+/* The record length is the Telemetry value length in design.cybt */
+_Static_assert(sizeof(app_tput_telemetry_record_t) == 54, "Telemetry record does not match design.cybt");
+
+/****************************************************************************
+ *                              FUNCTION DEFINITIONS
+ ***************************************************************************/
+
+/**
+ * Function Name:
+ * app_tput_telemetry_build
+ *
+ * Function Description:
+ * @brief  Fills the telemetry record of a client
+ *
+ * @param p_conn     client
+ * @param now        current time in ms
+ *
+ * @return void
+ */
+static void app_tput_telemetry_build(conn_state_info_t *p_conn, cy_time_t now)
+{
+    app_tput_telemetry_t *p_tel = &p_conn->telemetry;
+    app_tput_telemetry_record_t *p_rec = &p_tel->record;
+    app_tput_counter_snapshot_t tx_snap, rx_snap;
+    uint16_t buckets = (uint16_t)MAX(p_conn->ctrl.telemetry_period_ms / APP_TPUT_STATS_BUCKET_MS, 1u);
+
+    app_tput_counter_snapshot(&p_conn->tx_ctr, &tx_snap);
+    app_tput_counter_snapshot(&p_conn->rx_ctr, &rx_snap);
+
+    p_rec->version = APP_TPUT_TELEMETRY_VERSION;
+    p_rec->phy = (uint8_t)(((p_conn->tx_phy & 0x0Fu) << 4) | (p_conn->rx_phy & 0x0Fu));
+    p_rec->mtu = p_conn->mtu;
+    p_rec->payload_size = p_conn->payload_size;
+    p_rec->conn_interval = (uint16_t)((p_conn->conn_interval / CONN_INTERVAL_MULTIPLIER) + 0.5);
+    /* Same buckets as the throughput report, over the telemetry period */
+    p_rec->tx_kbps = app_tput_stats_mean_kbps(&p_conn->tx_stats, buckets);
+    p_rec->rx_kbps = app_tput_stats_mean_kbps(&p_conn->rx_stats, buckets);
+    p_rec->timestamp = (uint32_t)now;
+    p_rec->tx_bytes = tx_snap.bytes;
+    p_rec->tx_packets = (uint32_t)tx_snap.packets;
+    p_rec->rx_bytes = rx_snap.bytes;
+    p_rec->rx_packets = (uint32_t)rx_snap.packets;
+    p_rec->congestion_events = p_conn->congestion_events;
+    p_rec->send_failures = p_conn->send_failures;
+    p_rec->burst = p_conn->pacer.burst;
+
+    p_tel->last_time = now;
+}
+
+/**
+ * Function Name:
+ * app_tput_telemetry_poll
+ *
+ * Function Description:
+ * @brief  Sends a telemetry record to every client whose period elapsed. A
+ *         record is deferred while the link is congested, the controller
+ *         is short of TX buffers or the previous record is in flight, so
+ *         telemetry only uses capacity the bulk stream leaves free.
+ *
+ * @param void
+ *
+ * @return void
+ */
+void app_tput_telemetry_poll(void)
+{
+    conn_state_info_t *p_conn;
+    app_tput_telemetry_t *p_tel;
+    wiced_bt_gatt_status_t status;
+    cy_time_t now = 0;
+    uint16_t len;
+
+    cy_rtos_get_time(&now);
+    for (uint8_t index = 0; index < APP_BT_MAX_CONNECTIONS; index++)
+    {
+        p_conn = app_bt_conn_get(index);
+        if (NULL == p_conn)
+        {
+            continue;
+        }
+        p_tel = &p_conn->telemetry;
+        if ((!(p_tel->cccd & GATT_CLIENT_CONFIG_NOTIFICATION)) ||
+            (0 == p_conn->ctrl.telemetry_period_ms) || (p_tel->in_flight) ||
+            ((uint32_t)(now - p_tel->last_time) < p_conn->ctrl.telemetry_period_ms))
+        {
+            continue;
+        }
+        if ((p_conn->congested) ||
+            (wiced_bt_ble_get_available_tx_buffers() < APP_TPUT_TELEMETRY_MIN_FREE_BUFFERS))
+        {
+            continue;
+        }
+
+        app_tput_telemetry_build(p_conn, now);
+        len = sizeof(app_tput_telemetry_record_t);
+        if (len > (p_conn->mtu - APP_BT_ATT_NOTIFY_HDR_LEN))
+        {
+            len = p_conn->mtu - APP_BT_ATT_NOTIFY_HDR_LEN;
+        }
+        p_tel->in_flight = WICED_TRUE;
+        status = wiced_bt_gatt_server_send_notification(p_conn->conn_id,
+                                                        HDLC_THROUGHPUT_MEASUREMENT_TELEMETRY_VALUE,
+                                                        len, (uint8_t *)&p_tel->record,
+                                                        (void *)app_tput_telemetry_release);
+        if (WICED_BT_GATT_SUCCESS != status)
+        {
+            p_tel->in_flight = WICED_FALSE;
+        }
+    }
+}
+
+/**
+ * Function Name:
+ * app_tput_telemetry_release
+ *
+ * Function Description:
+ * @brief  Marks a telemetry record as transmitted. Matches pfn_free_buffer_t
+ *         and is called on GATT_APP_BUFFER_TRANSMITTED_EVT.
+ *
+ * @param p_buf      record transmitted
+ *
+ * @return void
+ */
+void app_tput_telemetry_release(uint8_t *p_buf)
+{
+    conn_state_info_t *p_conn;
+
+    for (uint8_t index = 0; index < APP_BT_MAX_CONNECTIONS; index++)
+    {
+        p_conn = app_bt_conn_get(index);
+        if ((NULL != p_conn) && (p_buf == (uint8_t *)&p_conn->telemetry.record))
+        {
+            p_conn->telemetry.in_flight = WICED_FALSE;
+            return;
+        }
+    }
+}
+
+/**
+ * Function Name:
+ * app_tput_telemetry_cccd_write
+ *
+ * Function Description:
+ * @brief  Write handler of the Telemetry characteristic CCCD, kept per
+ *         client. The first record follows one period after notifications
+ *         are enabled.
+ *
+ * @param conn_id      Connection ID of the client writing the value
+ * @param p_attr       attribute written
+ * @param p_val        written value
+ * @param len          length of the written value
+ *
+ * @return wiced_bt_gatt_status_t  Bluetooth LE GATT status
+ */
+wiced_bt_gatt_status_t app_tput_telemetry_cccd_write(uint16_t conn_id, gatt_db_lookup_table_t *p_attr,
+                                                     uint8_t *p_val, uint16_t len)
+{
+    conn_state_info_t *p_conn = app_bt_conn_find(conn_id);
+
+    if (NULL == p_conn)
+    {
+        return WICED_BT_GATT_SUCCESS;
+    }
+
+    p_conn->telemetry.cccd = p_attr->p_data[0];
+    if (p_conn->telemetry.cccd & GATT_CLIENT_CONFIG_NOTIFICATION)
+    {
+        cy_rtos_get_time(&p_conn->telemetry.last_time);
+    }
+    return WICED_BT_GATT_SUCCESS;
+}
+
+
+/* [] END OF FILE */
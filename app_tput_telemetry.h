@@ -0,0 +1,113 @@
+/******************************************************************************
+* File Name:   app_tput_telemetry.h
+*
+* Description: This file contains the Telemetry characteristic, which
+*              notifies each client of the throughput counters and link
+*              parameters seen by the server. Telemetry is only sent when
+*              the link has spare transmit capacity.
+*
+* Related Document: See README.md
+*
+********************************************************************************
+* Copyright 2021-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef __APP_TPUT_TELEMETRY_H__
+#define __APP_TPUT_TELEMETRY_H__
+
+/******************************************************************************
+ *                                INCLUDES
+ ******************************************************************************/
+#include <stdint.h>
+#include "wiced_bt_dev.h"
+#include "wiced_bt_gatt.h"
+#include "cyabs_rtos.h"
+#include "app_tput_config.h"
+#include "app_bt_attr_table.h"
+
+/******************************************************************************
+ *                                Constants
+ ******************************************************************************/
+#define APP_TPUT_TELEMETRY_VERSION              (1)
+
+/* Free controller TX buffers needed before a telemetry record is sent, so
+ * that telemetry never takes the last buffers from the bulk stream */
+#ifndef APP_TPUT_TELEMETRY_MIN_FREE_BUFFERS
+#define APP_TPUT_TELEMETRY_MIN_FREE_BUFFERS     (2)
+#endif
+
+/******************************************************************************
+ *                                Structures
+ ******************************************************************************/
+/* Telemetry record, little endian. Fields are ordered by importance; a
+ * notification carries as many bytes as the MTU allows and the full record
+ * can be read from the characteristic. */
+typedef struct __attribute__((packed))
+{
+    uint8_t  version;               /* APP_TPUT_TELEMETRY_VERSION */
+    uint8_t  phy;                   /* TX PHY in bits 7..4, RX PHY in bits 3..0 */
+    uint16_t mtu;                   /* ATT MTU */
+    uint16_t payload_size;          /* notification payload size */
+    uint16_t conn_interval;         /* connection interval in 1.25 ms units */
+    uint32_t tx_kbps;               /* mean notification throughput over the telemetry period */
+    uint32_t rx_kbps;               /* mean write throughput over the telemetry period */
+    uint32_t timestamp;             /* server time in ms */
+    uint64_t tx_bytes;              /* notification bytes since connection */
+    uint32_t tx_packets;            /* notifications since connection */
+    uint64_t rx_bytes;              /* write bytes since connection */
+    uint32_t rx_packets;            /* writes since connection */
+    uint32_t congestion_events;     /* congestion reported by the stack */
+    uint32_t send_failures;         /* notifications not accepted by the stack */
+    uint16_t burst;                 /* current notification burst */
+} app_tput_telemetry_record_t;
+
+/* Telemetry state of one client */
+typedef struct
+{
+    app_tput_telemetry_record_t record;         /* last record, owned by the stack while in flight */
+    volatile wiced_bool_t       in_flight;      /* record handed to the stack */
+    uint16_t                    cccd;           /* Telemetry CCCD of this client */
+    cy_time_t                   last_time;      /* time of the previous record */
+} app_tput_telemetry_t;
+
+/****************************************************************************
+ *                              FUNCTION DECLARATIONS
+ ***************************************************************************/
+void                   app_tput_telemetry_poll(void);
+void                   app_tput_telemetry_release(uint8_t *p_buf);
+wiced_bt_gatt_status_t app_tput_telemetry_cccd_write(uint16_t conn_id, gatt_db_lookup_table_t *p_attr,
+                                                     uint8_t *p_val, uint16_t len);
+
+#endif      /* __APP_TPUT_TELEMETRY_H__ */
+
+
+/* [] END OF FILE */
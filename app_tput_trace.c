@@ -0,0 +1,311 @@
+/******************************************************************************
+* File Name:   app_tput_trace.c
+*
+* Description: This file contains the callback tracing. The Bluetooth
+*              stack thread records the duration of each traced handler
+*              call in a slot per handler and event; tput_task prints the
+*              min, mean, max and p99 cycles of every slot on request.
+*
+* Related Document: See README.md
+*
+********************************************************************************
+* Copyright 2021-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/******************************************************************************
+ *                                INCLUDES
+ ******************************************************************************/
+#include <stdio.h>
+#include <string.h>
+#include "app_tput_trace.h"
+
+/******************************************************************************
+ *                                Structures
+ ******************************************************************************/
+/* Durations of one handler and event pair, written by the stack thread */
+typedef struct
+{
+    volatile uint32_t seq;          /* odd while the slot is updated */
+    uint8_t           handler;      /* app_tput_trace_handler_t */
+    uint16_t          code;         /* GATT event, ATT opcode or attribute handle */
+    uint32_t          count;
+    uint32_t          min;          /* cycles */
+    uint32_t          max;          /* cycles */
+    uint64_t          sum;          /* cycles */
+    uint32_t          buckets[APP_TPUT_TRACE_BUCKETS];
+} app_tput_trace_slot_t;
+
+/******************************************************************************
+ *                                Variable Definitions
+ ******************************************************************************/
+static app_tput_trace_slot_t trace_slots[APP_TPUT_TRACE_SLOTS];
+static volatile uint8_t trace_slots_used;
+static volatile uint32_t trace_overflows;
+
+/* Set by app_tput_trace_request(), handled by tput_task */
+static volatile uint8_t trace_request;
+/* Set by tput_task after a dump, the stack thread clears the slots */
+static volatile wiced_bool_t trace_reset_pending;
+
+static const char *const trace_handler_name[APP_TPUT_TRACE_HANDLERS] =
+{
+    [APP_TPUT_TRACE_GATT_EVENT]  = "GATT event ",
+    [APP_TPUT_TRACE_ATT_REQUEST] = "ATT request",
+    [APP_TPUT_TRACE_WRITE]       = "Write      ",
+};
+
+/****************************************************************************
+ *                              FUNCTION DEFINITIONS
+ ***************************************************************************/
+
+/**
+ * Function Name:
+ * app_tput_trace_bucket
+ *
+ * Function Description:
+ * @brief  Returns the histogram bucket of a duration
+ *
+ * @param cycles     duration in cycles
+ *
+ * @return uint32_t  bucket index
+ */
+static uint32_t app_tput_trace_bucket(uint32_t cycles)
+{
+    uint32_t octave;
+    uint32_t index;
+
+    if (cycles < APP_TPUT_TRACE_LINEAR)
+    {
+        return cycles;
+    }
+    octave = 31u - (uint32_t)__builtin_clz(cycles);
+    index = APP_TPUT_TRACE_LINEAR + (octave - 3u) * APP_TPUT_TRACE_SUB_BUCKETS +
+            ((cycles >> (octave - 2u)) & (APP_TPUT_TRACE_SUB_BUCKETS - 1u));
+    return (index < APP_TPUT_TRACE_BUCKETS) ? index : (APP_TPUT_TRACE_BUCKETS - 1u);
+}
+
+/**
+ * Function Name:
+ * app_tput_trace_bucket_limit
+ *
+ * Function Description:
+ * @brief  Returns the upper limit of a histogram bucket
+ *
+ * @param index      bucket index
+ *
+ * @return uint32_t  first duration in cycles above the bucket
+ */
+static uint32_t app_tput_trace_bucket_limit(uint32_t index)
+{
+    uint32_t octave;
+    uint32_t sub;
+
+    if (index < APP_TPUT_TRACE_LINEAR)
+    {
+        return index + 1u;
+    }
+    octave = 3u + (index - APP_TPUT_TRACE_LINEAR) / APP_TPUT_TRACE_SUB_BUCKETS;
+    sub = (index - APP_TPUT_TRACE_LINEAR) % APP_TPUT_TRACE_SUB_BUCKETS;
+    return (APP_TPUT_TRACE_SUB_BUCKETS + sub + 1u) << (octave - 2u);
+}
+
+/**
+ * Function Name:
+ * app_tput_trace_record
+ *
+ * Function Description:
+ * @brief  Records the duration of a handler call. Called in the Bluetooth
+ *         stack thread only, through APP_TPUT_TRACE_EXIT.
+ *
+ * @param handler    app_tput_trace_handler_t
+ * @param code       GATT event, ATT opcode or attribute handle
+ * @param cycles     duration of the call in cycles
+ *
+ * @return void
+ */
+void app_tput_trace_record(uint8_t handler, uint16_t code, uint32_t cycles)
+{
+    app_tput_trace_slot_t *p_slot = NULL;
+    uint8_t used = trace_slots_used;
+
+    if (trace_reset_pending)
+    {
+        /* Cleared by the writer so that no update is lost half way */
+        for (uint8_t i = 0; i < used; i++)
+        {
+            trace_slots[i].seq++;
+            __atomic_thread_fence(__ATOMIC_RELEASE);
+            trace_slots[i].count = 0;
+            memset(trace_slots[i].buckets, 0, sizeof(trace_slots[i].buckets));
+            __atomic_store_n(&trace_slots[i].seq, trace_slots[i].seq + 1u, __ATOMIC_RELEASE);
+        }
+        trace_overflows = 0;
+        trace_reset_pending = WICED_FALSE;
+    }
+
+    for (uint8_t i = 0; i < used; i++)
+    {
+        if ((handler == trace_slots[i].handler) && (code == trace_slots[i].code))
+        {
+            p_slot = &trace_slots[i];
+            break;
+        }
+    }
+    if (NULL == p_slot)
+    {
+        if (used >= APP_TPUT_TRACE_SLOTS)
+        {
+            trace_overflows++;
+            return;
+        }
+        p_slot = &trace_slots[used];
+        p_slot->handler = handler;
+        p_slot->code = code;
+        __atomic_store_n(&trace_slots_used, used + 1u, __ATOMIC_RELEASE);
+    }
+
+    __atomic_store_n(&p_slot->seq, p_slot->seq + 1u, __ATOMIC_RELAXED);
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+    if ((0 == p_slot->count) || (cycles < p_slot->min))
+    {
+        p_slot->min = cycles;
+    }
+    if ((0 == p_slot->count) || (cycles > p_slot->max))
+    {
+        p_slot->max = cycles;
+    }
+    p_slot->sum = (0 == p_slot->count) ? cycles : (p_slot->sum + cycles);
+    p_slot->buckets[app_tput_trace_bucket(cycles)]++;
+    p_slot->count++;
+    __atomic_store_n(&p_slot->seq, p_slot->seq + 1u, __ATOMIC_RELEASE);
+}
+
+/**
+ * Function Name:
+ * app_tput_trace_request
+ *
+ * Function Description:
+ * @brief  Requests the statistics to be printed by tput_task
+ *
+ * @param request    APP_TPUT_TRACE_REQ_DUMP or APP_TPUT_TRACE_REQ_DUMP_RESET
+ *
+ * @return void
+ */
+void app_tput_trace_request(app_tput_trace_req_t request)
+{
+    trace_request = (uint8_t)request;
+}
+
+/**
+ * Function Name:
+ * app_tput_trace_p99
+ *
+ * Function Description:
+ * @brief  Returns the upper limit of the bucket holding the 99th percentile
+ *
+ * @param p_slot     copy of a slot
+ *
+ * @return uint32_t  p99 duration in cycles
+ */
+static uint32_t app_tput_trace_p99(const app_tput_trace_slot_t *p_slot)
+{
+    uint32_t rank = p_slot->count - (p_slot->count / 100u);
+    uint32_t seen = 0;
+
+    for (uint32_t i = 0; i < APP_TPUT_TRACE_BUCKETS; i++)
+    {
+        seen += p_slot->buckets[i];
+        if (seen >= rank)
+        {
+            return app_tput_trace_bucket_limit(i);
+        }
+    }
+    return p_slot->max;
+}
+
+/**
+ * Function Name:
+ * app_tput_trace_poll
+ *
+ * Function Description:
+ * @brief  Prints the statistics of every slot when requested. Called by
+ *         tput_task every statistics bucket.
+ *
+ * @param void
+ *
+ * @return void
+ */
+void app_tput_trace_poll(void)
+{
+    static app_tput_trace_slot_t copy;
+    uint8_t request = __atomic_exchange_n(&trace_request, APP_TPUT_TRACE_REQ_NONE, __ATOMIC_ACQUIRE);
+    uint8_t used = __atomic_load_n(&trace_slots_used, __ATOMIC_ACQUIRE);
+    uint32_t seq;
+
+    if (APP_TPUT_TRACE_REQ_NONE == request)
+    {
+        return;
+    }
+
+    printf("Callback trace, cycles at %lu MHz:\n", (unsigned long)(SystemCoreClock / 1000000u));
+    printf("  handler     code      count      min     mean      max      p99\n");
+    for (uint8_t i = 0; i < used; i++)
+    {
+        do
+        {
+            seq = __atomic_load_n(&trace_slots[i].seq, __ATOMIC_ACQUIRE);
+            memcpy(&copy, &trace_slots[i], sizeof(copy));
+            __atomic_thread_fence(__ATOMIC_ACQUIRE);
+        } while ((seq & 1u) || (seq != __atomic_load_n(&trace_slots[i].seq, __ATOMIC_RELAXED)));
+
+        if (0 == copy.count)
+        {
+            continue;
+        }
+        printf("  %s 0x%04X %9lu %8lu %8lu %8lu %8lu\n",
+               trace_handler_name[copy.handler], copy.code, (unsigned long)copy.count,
+               (unsigned long)copy.min, (unsigned long)(copy.sum / copy.count),
+               (unsigned long)copy.max, (unsigned long)app_tput_trace_p99(&copy));
+    }
+    if (0 != trace_overflows)
+    {
+        printf("Callback trace: %lu calls not traced, no free slot\n", (unsigned long)trace_overflows);
+    }
+
+    if (APP_TPUT_TRACE_REQ_DUMP_RESET == request)
+    {
+        trace_reset_pending = WICED_TRUE;
+    }
+}
+
+
+/* [] END OF FILE */
@@ -0,0 +1,121 @@
+/******************************************************************************
+* File Name:   app_tput_trace.h
+*
+* Description: This file contains the definitions of the callback
+*              tracing, which times the Bluetooth stack callbacks with the
+*              cycle counter and aggregates the durations per handler and
+*              event in fixed memory.
+*
+* Related Document: See README.md
+*
+********************************************************************************
+* Copyright 2021-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef __APP_TPUT_TRACE_H__
+#define __APP_TPUT_TRACE_H__
+
+/******************************************************************************
+ *                                INCLUDES
+ ******************************************************************************/
+#include <stdint.h>
+#include "wiced_bt_dev.h"
+#include "app_tput_config.h"
+#include "app_tput_cycles.h"
+
+/******************************************************************************
+ *                                Constants
+ ******************************************************************************/
+/* Time the GATT callbacks, 0 to compile the tracing out */
+#ifndef APP_TPUT_TRACE
+#define APP_TPUT_TRACE                          (1)
+#endif
+
+/* Handler and event pairs traced, further pairs are counted as overflows */
+#ifndef APP_TPUT_TRACE_SLOTS
+#define APP_TPUT_TRACE_SLOTS                    (24)
+#endif
+
+/* Duration histogram: durations under 8 cycles are counted exactly, longer
+ * ones in four buckets per power of two up to 2^24 cycles, so the p99 is
+ * reported within 25% */
+#define APP_TPUT_TRACE_LINEAR                   (8)
+#define APP_TPUT_TRACE_SUB_BUCKETS              (4)
+#define APP_TPUT_TRACE_MAX_OCTAVE               (24)
+#define APP_TPUT_TRACE_BUCKETS                  (APP_TPUT_TRACE_LINEAR + \
+                                                 (APP_TPUT_TRACE_MAX_OCTAVE - 3) * APP_TPUT_TRACE_SUB_BUCKETS)
+
+/******************************************************************************
+ *                                Enumerations
+ ******************************************************************************/
+/* Traced handlers */
+typedef enum
+{
+    APP_TPUT_TRACE_GATT_EVENT,      /* app_bt_gatt_event_callback, per GATT event */
+    APP_TPUT_TRACE_ATT_REQUEST,     /* app_bt_server_event_handler, per ATT opcode */
+    APP_TPUT_TRACE_WRITE,           /* app_bt_write_handler, per attribute handle */
+    APP_TPUT_TRACE_HANDLERS
+} app_tput_trace_handler_t;
+
+/* Requests handled by tput_task */
+typedef enum
+{
+    APP_TPUT_TRACE_REQ_NONE,
+    APP_TPUT_TRACE_REQ_DUMP,        /* print the statistics */
+    APP_TPUT_TRACE_REQ_DUMP_RESET,  /* print the statistics, then clear them */
+} app_tput_trace_req_t;
+
+/******************************************************************************
+ *                                Macros
+ ******************************************************************************/
+#if APP_TPUT_TRACE
+/* Starts timing a handler, declares the start time variable */
+#define APP_TPUT_TRACE_ENTER(start)             uint32_t start = app_tput_cycles_now()
+/* Stops timing a handler and records the duration */
+#define APP_TPUT_TRACE_EXIT(handler, code, start) \
+    app_tput_trace_record((handler), (uint16_t)(code), app_tput_cycles_now() - (start))
+#else
+#define APP_TPUT_TRACE_ENTER(start)
+#define APP_TPUT_TRACE_EXIT(handler, code, start)
+#endif
+
+/****************************************************************************
+ *                              FUNCTION DECLARATIONS
+ ***************************************************************************/
+void app_tput_trace_record(uint8_t handler, uint16_t code, uint32_t cycles);
+void app_tput_trace_request(app_tput_trace_req_t request);
+void app_tput_trace_poll(void);
+
+#endif      /* __APP_TPUT_TRACE_H__ */
+
+
+/* [] END OF FILE */
@@ -0,0 +1,143 @@
+/******************************************************************************
+* File Name:   cycfg_gatt_db.c
+*
+* Description: Host build equivalent of the GATT database generated from
+*              design.cybt.
+*
+* Related Document: See README.md
+*
+********************************************************************************
+* Copyright 2021-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/******************************************************************************
+ *                                INCLUDES
+ ******************************************************************************/
+#include "cycfg_gatt_db.h"
+
+/******************************************************************************
+ *                                Variables
+ ******************************************************************************/
+const uint8_t gatt_database[] =
+{
+    /* Primary Service: Generic Access */
+    PRIMARY_SERVICE_UUID16(HDLS_GAP, UUID_SERVICE_GAP),
+        /* Characteristic: Device Name */
+        CHARACTERISTIC_UUID16(HDLC_GAP_DEVICE_NAME, HDLC_GAP_DEVICE_NAME_VALUE,
+                              UUID_CHARACTERISTIC_DEVICE_NAME, GATTDB_CHAR_PROP_READ,
+                              GATTDB_PERM_READABLE),
+        /* Characteristic: Appearance */
+        CHARACTERISTIC_UUID16(HDLC_GAP_APPEARANCE, HDLC_GAP_APPEARANCE_VALUE,
+                              UUID_CHARACTERISTIC_APPEARANCE, GATTDB_CHAR_PROP_READ,
+                              GATTDB_PERM_READABLE),
+
+    /* Primary Service: Throughput Measurement */
+    PRIMARY_SERVICE_UUID128(HDLS_THROUGHPUT_MEASUREMENT, __UUID_SERVICE_THROUGHPUT_MEASUREMENT),
+        /* Characteristic: Notify */
+        CHARACTERISTIC_UUID128_WRITABLE(HDLC_THROUGHPUT_MEASUREMENT_NOTIFY, HDLC_THROUGHPUT_MEASUREMENT_NOTIFY_VALUE,
+                                        __UUID_CHARACTERISTIC_THROUGHPUT_MEASUREMENT_NOTIFY,
+                                        GATTDB_CHAR_PROP_READ | GATTDB_CHAR_PROP_NOTIFY | GATTDB_CHAR_PROP_INDICATE,
+                                        GATTDB_PERM_READABLE),
+            /* Descriptor: Client Characteristic Configuration */
+            CHAR_DESCRIPTOR_UUID16_WRITABLE(HDLD_THROUGHPUT_MEASUREMENT_NOTIFY_CLIENT_CHAR_CONFIG,
+                                            UUID_DESCRIPTOR_CLIENT_CHARACTERISTIC_CONFIGURATION,
+                                            GATTDB_PERM_READABLE | GATTDB_PERM_WRITE_REQ),
+        /* Characteristic: WriteMe */
+        CHARACTERISTIC_UUID128_WRITABLE(HDLC_THROUGHPUT_MEASUREMENT_WRITEME, HDLC_THROUGHPUT_MEASUREMENT_WRITEME_VALUE,
+                                        __UUID_CHARACTERISTIC_THROUGHPUT_MEASUREMENT_WRITEME,
+                                        GATTDB_CHAR_PROP_READ | GATTDB_CHAR_PROP_WRITE |
+                                        GATTDB_CHAR_PROP_WRITE_NO_RESPONSE | GATTDB_CHAR_PROP_EXTENDED,
+                                        GATTDB_PERM_READABLE | GATTDB_PERM_WRITABLE | GATTDB_PERM_RELIABLE_WRITE),
+            /* Descriptor: Characteristic Extended Properties */
+            CHAR_DESCRIPTOR_UUID16(HDLD_THROUGHPUT_MEASUREMENT_WRITEME_CHAR_EXTENDED_PROPERTIES,
+                                   UUID_DESCRIPTOR_CHARACTERISTIC_EXTENDED_PROPERTIES,
+                                   GATTDB_PERM_READABLE),
+        /* Characteristic: Control */
+        CHARACTERISTIC_UUID128_WRITABLE(HDLC_THROUGHPUT_MEASUREMENT_CONTROL, HDLC_THROUGHPUT_MEASUREMENT_CONTROL_VALUE,
+                                        __UUID_CHARACTERISTIC_THROUGHPUT_MEASUREMENT_CONTROL,
+                                        GATTDB_CHAR_PROP_READ | GATTDB_CHAR_PROP_WRITE,
+                                        GATTDB_PERM_READABLE | GATTDB_PERM_WRITE_REQ),
+        /* Characteristic: Telemetry */
+        CHARACTERISTIC_UUID128_WRITABLE(HDLC_THROUGHPUT_MEASUREMENT_TELEMETRY, HDLC_THROUGHPUT_MEASUREMENT_TELEMETRY_VALUE,
+                                        __UUID_CHARACTERISTIC_THROUGHPUT_MEASUREMENT_TELEMETRY,
+                                        GATTDB_CHAR_PROP_READ | GATTDB_CHAR_PROP_NOTIFY,
+                                        GATTDB_PERM_READABLE),
+            /* Descriptor: Client Characteristic Configuration */
+            CHAR_DESCRIPTOR_UUID16_WRITABLE(HDLD_THROUGHPUT_MEASUREMENT_TELEMETRY_CLIENT_CHAR_CONFIG,
+                                            UUID_DESCRIPTOR_CLIENT_CHARACTERISTIC_CONFIGURATION,
+                                            GATTDB_PERM_READABLE | GATTDB_PERM_WRITE_REQ),
+        /* Characteristic: Ping */
+        CHARACTERISTIC_UUID128_WRITABLE(HDLC_THROUGHPUT_MEASUREMENT_PING, HDLC_THROUGHPUT_MEASUREMENT_PING_VALUE,
+                                        __UUID_CHARACTERISTIC_THROUGHPUT_MEASUREMENT_PING,
+                                        GATTDB_CHAR_PROP_READ | GATTDB_CHAR_PROP_WRITE |
+                                        GATTDB_CHAR_PROP_WRITE_NO_RESPONSE | GATTDB_CHAR_PROP_NOTIFY,
+                                        GATTDB_PERM_READABLE | GATTDB_PERM_WRITABLE),
+            /* Descriptor: Client Characteristic Configuration */
+            CHAR_DESCRIPTOR_UUID16_WRITABLE(HDLD_THROUGHPUT_MEASUREMENT_PING_CLIENT_CHAR_CONFIG,
+                                            UUID_DESCRIPTOR_CLIENT_CHARACTERISTIC_CONFIGURATION,
+                                            GATTDB_PERM_READABLE | GATTDB_PERM_WRITE_REQ),
+};
+
+const uint16_t gatt_database_len = sizeof(gatt_database);
+
+uint8_t app_gap_device_name[]                                     = {'T', 'P', 'U', 'T'};
+uint8_t app_gap_appearance[]                                      = {0x00, 0x00};
+uint8_t app_throughput_measurement_notify[495]                    = {0};
+uint8_t app_throughput_measurement_notify_client_char_config[]    = {0x00, 0x00};
+uint8_t app_throughput_measurement_writeme[495]                   = {0};
+uint8_t app_throughput_measurement_writeme_char_extended_properties[] = {0x01, 0x00};
+uint8_t app_throughput_measurement_control[20]                    = {0};
+uint8_t app_throughput_measurement_telemetry[54]                  = {0};
+uint8_t app_throughput_measurement_telemetry_client_char_config[] = {0x00, 0x00};
+uint8_t app_throughput_measurement_ping[20]                       = {0};
+uint8_t app_throughput_measurement_ping_client_char_config[]      = {0x00, 0x00};
+
+gatt_db_lookup_table_t app_gatt_db_ext_attr_tbl[] =
+{
+    /* { attribute handle, maxlen, curlen, attribute data } */
+    { HDLC_GAP_DEVICE_NAME_VALUE,                               4,   4,   app_gap_device_name },
+    { HDLC_GAP_APPEARANCE_VALUE,                                2,   2,   app_gap_appearance },
+    { HDLC_THROUGHPUT_MEASUREMENT_NOTIFY_VALUE,                 495, 495, app_throughput_measurement_notify },
+    { HDLD_THROUGHPUT_MEASUREMENT_NOTIFY_CLIENT_CHAR_CONFIG,    2,   2,   app_throughput_measurement_notify_client_char_config },
+    { HDLC_THROUGHPUT_MEASUREMENT_WRITEME_VALUE,                495, 495, app_throughput_measurement_writeme },
+    { HDLD_THROUGHPUT_MEASUREMENT_WRITEME_CHAR_EXTENDED_PROPERTIES, 2, 2, app_throughput_measurement_writeme_char_extended_properties },
+    { HDLC_THROUGHPUT_MEASUREMENT_CONTROL_VALUE,                20,  0,   app_throughput_measurement_control },
+    { HDLC_THROUGHPUT_MEASUREMENT_TELEMETRY_VALUE,              54,  54,  app_throughput_measurement_telemetry },
+    { HDLD_THROUGHPUT_MEASUREMENT_TELEMETRY_CLIENT_CHAR_CONFIG, 2,   2,   app_throughput_measurement_telemetry_client_char_config },
+    { HDLC_THROUGHPUT_MEASUREMENT_PING_VALUE,                   20,  0,   app_throughput_measurement_ping },
+    { HDLD_THROUGHPUT_MEASUREMENT_PING_CLIENT_CHAR_CONFIG,      2,   2,   app_throughput_measurement_ping_client_char_config },
+};
+
+const uint16_t app_gatt_db_ext_attr_tbl_size = (sizeof(app_gatt_db_ext_attr_tbl) / sizeof(gatt_db_lookup_table_t));
+
+
+/* [] END OF FILE */
@@ -0,0 +1,119 @@
+/******************************************************************************
+* File Name:   cycfg_gatt_db.h
+*
+* Description: Host build equivalent of the GATT database generated from
+*              design.cybt. Keep the handles and value lengths in step with
+*              the Bluetooth Configurator output.
+*
+* Related Document: See README.md
+*
+********************************************************************************
+* Copyright 2021-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef __CYCFG_GATT_DB_H__
+#define __CYCFG_GATT_DB_H__
+
+/******************************************************************************
+ *                                INCLUDES
+ ******************************************************************************/
+#include "wiced_bt_gatt.h"
+
+/******************************************************************************
+ *                                Constants
+ ******************************************************************************/
+#define __UUID_SERVICE_THROUGHPUT_MEASUREMENT              0xBD, 0x3F, 0xC3, 0x4A, 0x79, 0xD3, 0xB5, 0x9E, 0x2A, 0x4C, 0x0B, 0x5F, 0x77, 0x9D, 0xA6, 0x5B
+#define __UUID_CHARACTERISTIC_THROUGHPUT_MEASUREMENT_NOTIFY 0x7A, 0xB8, 0xF5, 0x4C, 0xCC, 0xF7, 0x60, 0x8B, 0xD6, 0x4C, 0x25, 0xC6, 0x2C, 0xE9, 0xF2, 0xE0
+#define __UUID_CHARACTERISTIC_THROUGHPUT_MEASUREMENT_WRITEME 0x6B, 0x33, 0xDC, 0x8F, 0x0F, 0xC8, 0xF5, 0x86, 0x1F, 0x48, 0xC4, 0xCC, 0xC7, 0xCC, 0xFC, 0x33
+#define __UUID_CHARACTERISTIC_THROUGHPUT_MEASUREMENT_CONTROL 0x40, 0x2B, 0x9A, 0x7F, 0x5D, 0x3C, 0x1E, 0x9B, 0x6A, 0x4F, 0x43, 0x6D, 0x2B, 0x0E, 0x1C, 0x8A
+#define __UUID_CHARACTERISTIC_THROUGHPUT_MEASUREMENT_TELEMETRY 0x40, 0x2B, 0x9A, 0x7F, 0x5D, 0x3C, 0x1E, 0x9B, 0x6A, 0x4F, 0x43, 0x6D, 0x2C, 0x0E, 0x1C, 0x8A
+#define __UUID_CHARACTERISTIC_THROUGHPUT_MEASUREMENT_PING   0x40, 0x2B, 0x9A, 0x7F, 0x5D, 0x3C, 0x1E, 0x9B, 0x6A, 0x4F, 0x43, 0x6D, 0x2D, 0x0E, 0x1C, 0x8A
+
+/* Service Generic Access */
+#define HDLS_GAP                                                    0x0001
+#define HDLC_GAP_DEVICE_NAME                                        0x0002
+#define HDLC_GAP_DEVICE_NAME_VALUE                                  0x0003
+#define HDLC_GAP_APPEARANCE                                         0x0004
+#define HDLC_GAP_APPEARANCE_VALUE                                   0x0005
+
+/* Service Throughput Measurement */
+#define HDLS_THROUGHPUT_MEASUREMENT                                 0x0028
+#define HDLC_THROUGHPUT_MEASUREMENT_NOTIFY                          0x0029
+#define HDLC_THROUGHPUT_MEASUREMENT_NOTIFY_VALUE                    0x002A
+#define HDLD_THROUGHPUT_MEASUREMENT_NOTIFY_CLIENT_CHAR_CONFIG       0x002B
+#define HDLC_THROUGHPUT_MEASUREMENT_WRITEME                         0x002C
+#define HDLC_THROUGHPUT_MEASUREMENT_WRITEME_VALUE                   0x002D
+#define HDLD_THROUGHPUT_MEASUREMENT_WRITEME_CHAR_EXTENDED_PROPERTIES 0x002E
+#define HDLC_THROUGHPUT_MEASUREMENT_CONTROL                         0x002F
+#define HDLC_THROUGHPUT_MEASUREMENT_CONTROL_VALUE                   0x0030
+#define HDLC_THROUGHPUT_MEASUREMENT_TELEMETRY                       0x0031
+#define HDLC_THROUGHPUT_MEASUREMENT_TELEMETRY_VALUE                 0x0032
+#define HDLD_THROUGHPUT_MEASUREMENT_TELEMETRY_CLIENT_CHAR_CONFIG    0x0033
+#define HDLC_THROUGHPUT_MEASUREMENT_PING                            0x0034
+#define HDLC_THROUGHPUT_MEASUREMENT_PING_VALUE                      0x0035
+#define HDLD_THROUGHPUT_MEASUREMENT_PING_CLIENT_CHAR_CONFIG         0x0036
+
+/******************************************************************************
+ *                                Structures
+ ******************************************************************************/
+typedef struct
+{
+    uint16_t handle;        /* Attribute handle */
+    uint16_t max_len;       /* Maximum value length */
+    uint16_t cur_len;       /* Current value length */
+    uint8_t  *p_data;       /* Value */
+} gatt_db_lookup_table_t;
+
+/******************************************************************************
+ *                                Variables
+ ******************************************************************************/
+extern const uint8_t  gatt_database[];
+extern const uint16_t gatt_database_len;
+extern gatt_db_lookup_table_t app_gatt_db_ext_attr_tbl[];
+extern const uint16_t app_gatt_db_ext_attr_tbl_size;
+
+extern uint8_t app_gap_device_name[];
+extern uint8_t app_gap_appearance[];
+extern uint8_t app_throughput_measurement_notify[];
+extern uint8_t app_throughput_measurement_notify_client_char_config[];
+extern uint8_t app_throughput_measurement_writeme[];
+extern uint8_t app_throughput_measurement_writeme_char_extended_properties[];
+extern uint8_t app_throughput_measurement_control[];
+extern uint8_t app_throughput_measurement_telemetry[];
+extern uint8_t app_throughput_measurement_telemetry_client_char_config[];
+extern uint8_t app_throughput_measurement_ping[];
+extern uint8_t app_throughput_measurement_ping_client_char_config[];
+
+#endif      /* __CYCFG_GATT_DB_H__ */
+
+
+/* [] END OF FILE */
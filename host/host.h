@@ -0,0 +1,81 @@
+/******************************************************************************
+* File Name:   host.h
+*
+* Description: Interfaces shared by the host build sources: thread CPU
+*              accounting, the simulated Bluetooth stack and its virtual link.
+*
+* Related Document: See README.md
+*
+********************************************************************************
+* Copyright 2021-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef __HOST_H__
+#define __HOST_H__
+
+/******************************************************************************
+ *                                INCLUDES
+ ******************************************************************************/
+#include <stdint.h>
+#include "cyabs_rtos.h"
+
+/******************************************************************************
+ *                                Constants
+ ******************************************************************************/
+/* Threads tracked for the CPU cost summary */
+#define HOST_MAX_THREADS                        (16)
+
+/****************************************************************************
+ *                              FUNCTION DECLARATIONS
+ ***************************************************************************/
+/* Monotonic time in nanoseconds */
+uint64_t host_rtos_now_ns(void);
+
+/* Prints the CPU time of every thread and the process per byte moved */
+void     host_rtos_print_cpu(uint64_t bytes);
+
+/* Reads the HOST_LINK_* and HOST_PEER_* settings from the environment */
+void     host_bt_stack_configure(void);
+
+/* Disconnects the peers and stops the stack thread */
+void     host_bt_stack_shutdown(void);
+
+/* Prints the bytes the virtual peers received and sent, returns their sum */
+uint64_t host_bt_stack_print_summary(uint32_t run_ms);
+
+/* Unsigned integer setting from the environment, dflt if unset */
+uint32_t host_env_u32(const char *p_name, uint32_t dflt);
+
+#endif      /* __HOST_H__ */
+
+
+/* [] END OF FILE */
@@ -0,0 +1,2231 @@
+/******************************************************************************
+* File Name:   host_bt_stack.c
+*
+* Description: Simulated Bluetooth stack for the host build. A stack thread
+*              delivers the management, GATT and L2CAP callbacks of the
+*              application, a link thread runs the connection events of a
+*              virtual LE link and plays the peers: GATT clients that exchange
+*              the MTU, discover the device name, enable notifications and
+*              optionally write, read and open an L2CAP channel. The link is
+*              configured by the HOST_LINK_* and HOST_PEER_* environment
+*              variables described in README.md.
+*
+* Related Document: See README.md
+*
+********************************************************************************
+* Copyright 2021-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/******************************************************************************
+ *                                INCLUDES
+ ******************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <time.h>
+#include <pthread.h>
+#include "wiced_bt_stack.h"
+#include "wiced_bt_ble.h"
+#include "wiced_bt_gatt.h"
+#include "wiced_bt_l2c.h"
+#include "cycfg_bt_settings.h"
+#include "cycfg_gatt_db.h"
+#include "host.h"
+
+/******************************************************************************
+ *                                Constants
+ ******************************************************************************/
+#define HOST_MAX_CONN                           (8)
+/* Largest ATT MTU of a peer */
+#define HOST_PEER_MAX_MTU                       (517)
+
+/* Inter frame space between the PDUs of a connection event, in us */
+#define HOST_LINK_T_IFS_US                      (150)
+/* ATT opcode and handle plus the L2CAP header of an ATT PDU */
+#define HOST_LINK_ATT_OVERHEAD                  (7)
+/* L2CAP header of a K-frame and SDU length field of the first one */
+#define HOST_LINK_KFRAME_OVERHEAD               (4)
+#define HOST_LINK_SDU_LEN_FIELD                 (2)
+/* LL payload of a PDU before data length extension */
+#define HOST_LINK_DEFAULT_OCTETS                (27)
+/* Delay between the start of the advertisements and a peer connecting */
+#define HOST_LINK_CONNECT_DELAY_MS              (50)
+/* Local channel ID of the first L2CAP channel */
+#define HOST_LINK_FIRST_CID                     (0x0040)
+/* SDU MTU of the L2CAP channel of a peer */
+#define HOST_PEER_COC_MTU                       (512)
+
+/* Coded PHY reported by BTM_BLE_PHY_UPDATE_EVT */
+#define HOST_PHY_1M                             (1)
+#define HOST_PHY_2M                             (2)
+#define HOST_PHY_CODED                          (3)
+
+/******************************************************************************
+ *                                Structures
+ ******************************************************************************/
+/* Settings of the virtual link and peers */
+typedef struct
+{
+    uint16_t interval;          /* 1.25 ms units, 0 to grant the server requests */
+    uint8_t  phy;               /* HOST_PHY_*, 0 to grant the server requests */
+    uint16_t phy_opts;          /* BTM_BLE_PREFER_LELR_* of a forced coded PHY */
+    uint16_t pdu_size;          /* largest LL payload the peer accepts */
+    uint16_t packets_per_event; /* PDUs per connection event, 0 for no limit */
+    int8_t   rssi;              /* reported RSSI in dBm */
+    uint16_t tx_buffers;        /* controller TX buffers shared by the links */
+    uint16_t rx_buffers;        /* peer PDUs a link holds until the stack takes them */
+    uint16_t peer_mtu;          /* MTU the peers request */
+    uint8_t  peers;             /* peers that connect */
+    uint16_t peer_cccd;         /* value the peers write to the Notify CCCD */
+    wiced_bool_t peer_writes;   /* peers stream write commands to WriteMe */
+    wiced_bool_t peer_reads;    /* peers read the Notify value back to back */
+    wiced_bool_t peer_coc;      /* peers open an L2CAP channel */
+    uint8_t  control[20];       /* Control value the peers write after the CCCD */
+    uint8_t  control_len;
+} host_link_cfg_t;
+
+/* Packet queued by the server for a peer */
+typedef enum
+{
+    HOST_PKT_NOTIFICATION,
+    HOST_PKT_INDICATION,
+    HOST_PKT_RESPONSE,
+    HOST_PKT_COC
+} host_pkt_kind_t;
+
+typedef struct host_pkt
+{
+    struct host_pkt *p_next;
+    host_pkt_kind_t  kind;
+    uint8_t          opcode;        /* response opcode */
+    uint16_t         handle;
+    uint16_t         len;           /* value or SDU length */
+    uint16_t         air_len;       /* LL payload bytes of all its PDUs */
+    uint8_t         *p_data;
+    void            *p_ctx;         /* application context, NULL if p_data is a copy */
+    uint8_t          copy[];
+} host_pkt_t;
+
+/* Script of a peer */
+typedef enum
+{
+    HOST_PEER_MTU,
+    HOST_PEER_DISCOVER,
+    HOST_PEER_CCCD,
+    HOST_PEER_CONTROL,
+    HOST_PEER_READY
+} host_peer_state_t;
+
+/* PDU the peer is sending */
+typedef struct
+{
+    wiced_bool_t      busy;
+    wiced_bt_gatt_opcode_t opcode;
+    uint16_t          handle;
+    uint16_t          offset;
+    uint16_t          len;          /* value length */
+    uint16_t          air_left;     /* LL payload bytes still to send */
+    const uint8_t    *p_value;
+} host_peer_pdu_t;
+
+typedef struct
+{
+    wiced_bool_t      in_use;
+    wiced_bool_t      connected;
+    uint16_t          conn_id;
+    wiced_bt_device_address_t bda;
+    uint16_t          mtu;
+    uint16_t          interval;
+    uint8_t           phy;
+    uint16_t          phy_opts;
+    uint16_t          tx_octets;
+    uint64_t          next_ce_ns;
+    uint64_t          up_ns;
+    uint64_t          down_ns;
+
+    /* Server to peer */
+    host_pkt_t       *p_head;
+    host_pkt_t       *p_tail;
+    uint16_t          head_sent;    /* LL payload bytes of the head packet sent */
+    wiced_bool_t      congested;
+    wiced_bool_t      ind_outstanding;
+    wiced_bool_t      answered;     /* the request being handled got a response */
+
+    /* Peer */
+    host_peer_state_t state;
+    wiced_bool_t      rsp_pending;
+    wiced_bool_t      conf_due;
+    wiced_bool_t      coc_requested;
+    uint16_t          rx_pending;   /* peer PDUs queued for the stack thread */
+    uint16_t          read_offset;
+    host_peer_pdu_t   out;
+
+    /* L2CAP channel */
+    uint16_t          coc_cid;
+    wiced_bool_t      coc_congested;
+
+    /* Peer totals */
+    uint64_t          notified;
+    uint64_t          indicated;
+    uint64_t          read;
+    uint64_t          written;
+    uint64_t          coc;
+    uint64_t          events;
+    uint64_t          pdus;
+} host_conn_t;
+
+/* Events of the stack thread */
+typedef enum
+{
+    HOST_EVT_MANAGEMENT,
+    HOST_EVT_GATT,
+    HOST_EVT_RSSI,
+    HOST_EVT_COC_CONNECT,
+    HOST_EVT_COC_CONGESTION,
+    HOST_EVT_COC_TX_COMPLETE
+} host_evt_type_t;
+
+typedef struct host_evt
+{
+    struct host_evt *p_next;
+    host_evt_type_t  type;
+    host_conn_t     *p_conn;        /* peer PDU to release from rx_pending, or NULL */
+    union
+    {
+        struct
+        {
+            wiced_bt_management_evt_t      event;
+            wiced_bt_management_evt_data_t data;
+        } mgmt;
+        struct
+        {
+            wiced_bt_gatt_evt_t            event;
+            wiced_bt_gatt_event_data_t     data;
+        } gatt;
+        struct
+        {
+            wiced_bt_dev_cmpl_cback_t     *p_cb;
+            wiced_bt_dev_rssi_result_t     result;
+        } rssi;
+        struct
+        {
+            uint16_t                       cid;
+            uint16_t                       value;
+        } coc;
+    } u;
+    uint8_t          value[];
+} host_evt_t;
+
+/******************************************************************************
+ *                                Variables
+ ******************************************************************************/
+static host_link_cfg_t host_cfg =
+{
+    .pdu_size = 251,
+    .packets_per_event = 6,
+    .rssi = -60,
+    .tx_buffers = 12,
+    .rx_buffers = 8,
+    .peer_mtu = 247,
+    .peers = 1,
+    .peer_cccd = GATT_CLIENT_CONFIG_NOTIFICATION,
+};
+
+static wiced_bt_management_cback_t *host_mgmt_cb;
+static wiced_bt_gatt_cback_t *host_gatt_cb;
+static const uint8_t *host_gatt_db;
+static uint32_t host_gatt_db_len;
+static wiced_bt_l2cap_le_appl_information_t host_coc_info;
+static void *host_coc_context;
+static uint16_t host_coc_psm;
+
+/* Link state, guarded by host_link_mutex */
+static pthread_mutex_t host_link_mutex = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t host_link_cond;
+static host_conn_t host_conns[HOST_MAX_CONN];
+static uint16_t host_tx_used;
+static uint8_t host_peers_connected;
+static uint64_t host_connect_ns;
+static wiced_bool_t host_stopping;
+
+/* Event queue of the stack thread */
+static pthread_mutex_t host_evt_mutex = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t host_evt_cond;
+static host_evt_t *host_evt_head, *host_evt_tail;
+static wiced_bool_t host_evt_busy;
+
+static cy_thread_t host_stack_thread, host_link_thread;
+static wiced_bt_device_address_t host_local_bda;
+static uint8_t host_write_value[HOST_PEER_MAX_MTU];
+
+/******************************************************************************
+ *                          Function Definitions
+ ******************************************************************************/
+
+/**
+ * Function Name:
+ * host_evt_alloc
+ *
+ * Function Description:
+ * @brief  Allocates a zeroed stack thread event
+ *
+ * @param type       event type
+ * @param value_len  bytes of written value carried by the event
+ *
+ * @return host_evt_t*  the event, the process exits when out of memory
+ */
+static host_evt_t *host_evt_alloc(host_evt_type_t type, uint16_t value_len)
+{
+    host_evt_t *p_evt = (host_evt_t *)calloc(1, sizeof(host_evt_t) + value_len);
+
+    if (NULL == p_evt)
+    {
+        printf("Host stack: out of memory\n");
+        exit(1);
+    }
+    p_evt->type = type;
+    return p_evt;
+}
+
+/**
+ * Function Name:
+ * host_evt_post
+ *
+ * Function Description:
+ * @brief  Appends an event to the queue of the stack thread
+ *
+ * @param p_evt      event
+ *
+ * @return void
+ */
+static void host_evt_post(host_evt_t *p_evt)
+{
+    pthread_mutex_lock(&host_evt_mutex);
+    if (NULL == host_evt_tail)
+    {
+        host_evt_head = p_evt;
+    }
+    else
+    {
+        host_evt_tail->p_next = p_evt;
+    }
+    host_evt_tail = p_evt;
+    pthread_cond_broadcast(&host_evt_cond);
+    pthread_mutex_unlock(&host_evt_mutex);
+}
+
+/**
+ * Function Name:
+ * host_evt_post_mgmt
+ *
+ * Function Description:
+ * @brief  Queues a management event
+ *
+ * @param event      management event
+ * @param p_data     event data, copied
+ *
+ * @return void
+ */
+static void host_evt_post_mgmt(wiced_bt_management_evt_t event, const wiced_bt_management_evt_data_t *p_data)
+{
+    host_evt_t *p_evt = host_evt_alloc(HOST_EVT_MANAGEMENT, 0);
+
+    p_evt->u.mgmt.event = event;
+    p_evt->u.mgmt.data = *p_data;
+    host_evt_post(p_evt);
+}
+
+/**
+ * Function Name:
+ * host_evt_post_congestion
+ *
+ * Function Description:
+ * @brief  Queues a GATT congestion change of a link
+ *
+ * @param p_conn     link
+ * @param congested  new congestion state
+ *
+ * @return void
+ */
+static void host_evt_post_congestion(host_conn_t *p_conn, wiced_bool_t congested)
+{
+    host_evt_t *p_evt = host_evt_alloc(HOST_EVT_GATT, 0);
+
+    p_conn->congested = congested;
+    p_evt->u.gatt.event = GATT_CONGESTION_EVT;
+    p_evt->u.gatt.data.congestion.conn_id = p_conn->conn_id;
+    p_evt->u.gatt.data.congestion.congested = congested;
+    host_evt_post(p_evt);
+}
+
+/**
+ * Function Name:
+ * host_evt_post_coc
+ *
+ * Function Description:
+ * @brief  Queues an L2CAP channel event
+ *
+ * @param type       HOST_EVT_COC_*
+ * @param cid        local channel ID
+ * @param value      MTU, congestion state or buffer count
+ *
+ * @return void
+ */
+static void host_evt_post_coc(host_evt_type_t type, uint16_t cid, uint16_t value)
+{
+    host_evt_t *p_evt = host_evt_alloc(type, 0);
+
+    p_evt->u.coc.cid = cid;
+    p_evt->u.coc.value = value;
+    host_evt_post(p_evt);
+}
+
+/**
+ * Function Name:
+ * host_conn_find
+ *
+ * Function Description:
+ * @brief  Returns the connected link of a connection ID
+ *
+ * @param conn_id    connection ID
+ *
+ * @return host_conn_t*  the link or NULL
+ */
+static host_conn_t *host_conn_find(uint16_t conn_id)
+{
+    for (uint8_t i = 0; i < HOST_MAX_CONN; i++)
+    {
+        if ((host_conns[i].connected) && (conn_id == host_conns[i].conn_id))
+        {
+            return &host_conns[i];
+        }
+    }
+    return NULL;
+}
+
+/**
+ * Function Name:
+ * host_conn_find_bda
+ *
+ * Function Description:
+ * @brief  Returns the connected link of a peer address
+ *
+ * @param bda        peer address
+ *
+ * @return host_conn_t*  the link or NULL
+ */
+static host_conn_t *host_conn_find_bda(const uint8_t *bda)
+{
+    for (uint8_t i = 0; i < HOST_MAX_CONN; i++)
+    {
+        if ((host_conns[i].connected) && (0 == memcmp(bda, host_conns[i].bda, BD_ADDR_LEN)))
+        {
+            return &host_conns[i];
+        }
+    }
+    return NULL;
+}
+
+/**
+ * Function Name:
+ * host_conn_find_cid
+ *
+ * Function Description:
+ * @brief  Returns the connected link of an L2CAP channel
+ *
+ * @param cid        local channel ID
+ *
+ * @return host_conn_t*  the link or NULL
+ */
+static host_conn_t *host_conn_find_cid(uint16_t cid)
+{
+    for (uint8_t i = 0; i < HOST_MAX_CONN; i++)
+    {
+        if ((host_conns[i].connected) && (0 != cid) && (cid == host_conns[i].coc_cid))
+        {
+            return &host_conns[i];
+        }
+    }
+    return NULL;
+}
+
+/**
+ * Function Name:
+ * host_link_air_us
+ *
+ * Function Description:
+ * @brief  Returns the air time of an LL data PDU on the PHY of a link
+ *
+ * @param p_conn     link
+ * @param len        LL payload bytes
+ *
+ * @return uint32_t  microseconds
+ */
+static uint32_t host_link_air_us(const host_conn_t *p_conn, uint16_t len)
+{
+    switch (p_conn->phy)
+    {
+    case HOST_PHY_2M:
+        return 44u + (4u * len);
+    case HOST_PHY_CODED:
+        return (BTM_BLE_PREFER_LELR_512K == p_conn->phy_opts) ? (462u + (16u * len)) : (720u + (64u * len));
+    default:
+        return 80u + (8u * len);
+    }
+}
+
+/**
+ * Function Name:
+ * host_link_phy_name
+ *
+ * Function Description:
+ * @brief  Returns the name of the PHY of a link
+ *
+ * @param p_conn     link
+ *
+ * @return const char*  name of the PHY
+ */
+static const char *host_link_phy_name(const host_conn_t *p_conn)
+{
+    switch (p_conn->phy)
+    {
+    case HOST_PHY_2M:
+        return "2M";
+    case HOST_PHY_CODED:
+        return (BTM_BLE_PREFER_LELR_512K == p_conn->phy_opts) ? "Coded S2" : "Coded S8";
+    default:
+        return "1M";
+    }
+}
+
+/**
+ * Function Name:
+ * host_link_queue
+ *
+ * Function Description:
+ * @brief  Queues a packet of the server for the peer of a link. Without an
+ *         application context the data is copied, with one it stays in the
+ *         application buffer until GATT_APP_BUFFER_TRANSMITTED_EVT.
+ *         Called with host_link_mutex held.
+ *
+ * @param p_conn     link
+ * @param kind       packet kind
+ * @param opcode     response opcode
+ * @param handle     attribute handle
+ * @param p_data     value or SDU
+ * @param len        value or SDU length
+ * @param hdr_len    LL payload bytes besides the value
+ * @param p_ctx      application context
+ *
+ * @return void
+ */
+static void host_link_queue(host_conn_t *p_conn, host_pkt_kind_t kind, uint8_t opcode, uint16_t handle,
+                            uint8_t *p_data, uint16_t len, uint16_t hdr_len, void *p_ctx)
+{
+    host_pkt_t *p_pkt = (host_pkt_t *)calloc(1, sizeof(host_pkt_t) + ((NULL == p_ctx) ? len : 0));
+
+    if (NULL == p_pkt)
+    {
+        printf("Host stack: out of memory\n");
+        exit(1);
+    }
+    p_pkt->kind = kind;
+    p_pkt->opcode = opcode;
+    p_pkt->handle = handle;
+    p_pkt->len = len;
+    p_pkt->air_len = (uint16_t)(len + hdr_len);
+    p_pkt->p_ctx = p_ctx;
+    p_pkt->p_data = p_data;
+    if (NULL == p_ctx)
+    {
+        if (0 != len)
+        {
+            memcpy(p_pkt->copy, p_data, len);
+        }
+        p_pkt->p_data = p_pkt->copy;
+    }
+    if (NULL == p_conn->p_tail)
+    {
+        p_conn->p_head = p_pkt;
+    }
+    else
+    {
+        p_conn->p_tail->p_next = p_pkt;
+    }
+    p_conn->p_tail = p_pkt;
+    host_tx_used++;
+}
+
+/**
+ * Function Name:
+ * host_link_release
+ *
+ * Function Description:
+ * @brief  Frees a transmitted or flushed packet and tells the application
+ *         its buffer is free. Called with host_link_mutex held.
+ *
+ * @param p_conn     link
+ * @param p_pkt      packet, unlinked
+ *
+ * @return void
+ */
+static void host_link_release(host_conn_t *p_conn, host_pkt_t *p_pkt)
+{
+    host_evt_t *p_evt;
+
+    host_tx_used--;
+    if (HOST_PKT_COC == p_pkt->kind)
+    {
+        host_evt_post_coc(HOST_EVT_COC_TX_COMPLETE, p_conn->coc_cid, 1);
+    }
+    else if (NULL != p_pkt->p_ctx)
+    {
+        p_evt = host_evt_alloc(HOST_EVT_GATT, 0);
+        p_evt->u.gatt.event = GATT_APP_BUFFER_TRANSMITTED_EVT;
+        p_evt->u.gatt.data.buffer_xmitted.p_app_data = p_pkt->p_data;
+        p_evt->u.gatt.data.buffer_xmitted.p_app_ctxt = p_pkt->p_ctx;
+        host_evt_post(p_evt);
+    }
+    free(p_pkt);
+}
+
+/**
+ * Function Name:
+ * host_link_pop
+ *
+ * Function Description:
+ * @brief  Unlinks the head packet of a link. Called with host_link_mutex held.
+ *
+ * @param p_conn     link
+ *
+ * @return host_pkt_t*  the packet
+ */
+static host_pkt_t *host_link_pop(host_conn_t *p_conn)
+{
+    host_pkt_t *p_pkt = p_conn->p_head;
+
+    p_conn->p_head = p_pkt->p_next;
+    if (NULL == p_conn->p_head)
+    {
+        p_conn->p_tail = NULL;
+    }
+    p_conn->head_sent = 0;
+    return p_pkt;
+}
+
+/**
+ * Function Name:
+ * host_link_disconnect
+ *
+ * Function Description:
+ * @brief  Drops a link: flushes the packets queued for the peer, returning
+ *         their buffers, and reports the disconnection. Called with
+ *         host_link_mutex held.
+ *
+ * @param p_conn     link
+ * @param reason     disconnection reason
+ *
+ * @return void
+ */
+static void host_link_disconnect(host_conn_t *p_conn, wiced_bt_gatt_disconn_reason_t reason)
+{
+    host_evt_t *p_evt;
+
+    while (NULL != p_conn->p_head)
+    {
+        host_link_release(p_conn, host_link_pop(p_conn));
+    }
+    p_conn->connected = WICED_FALSE;
+    p_conn->down_ns = host_rtos_now_ns();
+
+    p_evt = host_evt_alloc(HOST_EVT_GATT, 0);
+    p_evt->u.gatt.event = GATT_CONNECTION_STATUS_EVT;
+    p_evt->u.gatt.data.connection_status.bd_addr = p_conn->bda;
+    p_evt->u.gatt.data.connection_status.conn_id = p_conn->conn_id;
+    p_evt->u.gatt.data.connection_status.connected = WICED_FALSE;
+    p_evt->u.gatt.data.connection_status.reason = reason;
+    p_evt->u.gatt.data.connection_status.transport = BT_TRANSPORT_LE;
+    host_evt_post(p_evt);
+}
+
+/**
+ * Function Name:
+ * host_link_check_congestion
+ *
+ * Function Description:
+ * @brief  Clears the congestion of the links once the controller buffers
+ *         drained to half. Called with host_link_mutex held.
+ *
+ * @return void
+ */
+static void host_link_check_congestion(void)
+{
+    if (host_tx_used > (host_cfg.tx_buffers / 2))
+    {
+        return;
+    }
+    for (uint8_t i = 0; i < HOST_MAX_CONN; i++)
+    {
+        if (!host_conns[i].connected)
+        {
+            continue;
+        }
+        if (host_conns[i].congested)
+        {
+            host_evt_post_congestion(&host_conns[i], WICED_FALSE);
+        }
+        if (host_conns[i].coc_congested)
+        {
+            host_conns[i].coc_congested = WICED_FALSE;
+            host_evt_post_coc(HOST_EVT_COC_CONGESTION, host_conns[i].coc_cid, WICED_FALSE);
+        }
+    }
+}
+
+/**
+ * Function Name:
+ * host_peer_receive
+ *
+ * Function Description:
+ * @brief  Handles a packet received by the peer of a link: counts the data
+ *         and advances the script of the peer on responses. Called with
+ *         host_link_mutex held.
+ *
+ * @param p_conn     link
+ * @param p_pkt      received packet
+ *
+ * @return void
+ */
+static void host_peer_receive(host_conn_t *p_conn, const host_pkt_t *p_pkt)
+{
+    switch (p_pkt->kind)
+    {
+    case HOST_PKT_NOTIFICATION:
+        p_conn->notified += p_pkt->len;
+        return;
+
+    case HOST_PKT_INDICATION:
+        p_conn->indicated += p_pkt->len;
+        p_conn->conf_due = WICED_TRUE;
+        return;
+
+    case HOST_PKT_COC:
+        p_conn->coc += p_pkt->len;
+        return;
+
+    case HOST_PKT_RESPONSE:
+        break;
+    }
+
+    p_conn->rsp_pending = WICED_FALSE;
+    switch (p_pkt->opcode)
+    {
+    case GATT_RSP_READ:
+    case GATT_RSP_READ_BLOB:
+        p_conn->read += p_pkt->len;
+        p_conn->read_offset = (p_pkt->len < (p_conn->mtu - 1)) ? 0 : (uint16_t)(p_conn->read_offset + p_pkt->len);
+        break;
+
+    case GATT_RSP_ERROR:
+        p_conn->read_offset = 0;
+        /* Fall through, a failed script step is skipped */
+    case GATT_RSP_MTU:
+    case GATT_RSP_READ_BY_TYPE:
+    case GATT_RSP_WRITE:
+        if (HOST_PEER_READY != p_conn->state)
+        {
+            p_conn->state++;
+        }
+        if ((HOST_PEER_CONTROL == p_conn->state) && (0 == host_cfg.control_len))
+        {
+            p_conn->state = HOST_PEER_READY;
+        }
+        break;
+
+    default:
+        break;
+    }
+}
+
+/**
+ * Function Name:
+ * host_peer_next
+ *
+ * Function Description:
+ * @brief  Picks the next PDU of the peer of a link: a pending confirmation,
+ *         the next request of its script or a read, else a write command
+ *         while the link has room for it. Called with host_link_mutex held.
+ *
+ * @param p_conn     link
+ *
+ * @return void
+ */
+static void host_peer_next(host_conn_t *p_conn)
+{
+    host_peer_pdu_t *p_out = &p_conn->out;
+    static uint8_t cccd[2];
+
+    memset(p_out, 0, sizeof(host_peer_pdu_t));
+    if (p_conn->conf_due)
+    {
+        p_conn->conf_due = WICED_FALSE;
+        p_out->opcode = GATT_HANDLE_VALUE_CONF;
+        p_out->handle = HDLC_THROUGHPUT_MEASUREMENT_NOTIFY_VALUE;
+        p_out->air_left = 1 + 4;
+        p_out->busy = WICED_TRUE;
+        return;
+    }
+
+    if ((HOST_PEER_READY == p_conn->state) && (host_cfg.peer_coc) && (0 != host_coc_psm) &&
+        (!p_conn->coc_requested))
+    {
+        p_conn->coc_requested = WICED_TRUE;
+        host_evt_post_coc(HOST_EVT_COC_CONNECT, (uint16_t)(HOST_LINK_FIRST_CID + (p_conn - host_conns)),
+                          (uint16_t)(p_conn - host_conns));
+    }
+
+    if (!p_conn->rsp_pending)
+    {
+        p_out->busy = WICED_TRUE;
+        switch (p_conn->state)
+        {
+        case HOST_PEER_MTU:
+            p_out->opcode = GATT_REQ_MTU;
+            p_out->air_left = 3 + 4;
+            break;
+
+        case HOST_PEER_DISCOVER:
+            p_out->opcode = GATT_REQ_READ_BY_TYPE;
+            p_out->air_left = 7 + 4;
+            break;
+
+        case HOST_PEER_CCCD:
+            cccd[0] = (uint8_t)(host_cfg.peer_cccd & 0xFF);
+            cccd[1] = (uint8_t)(host_cfg.peer_cccd >> 8);
+            p_out->opcode = GATT_REQ_WRITE;
+            p_out->handle = HDLD_THROUGHPUT_MEASUREMENT_NOTIFY_CLIENT_CHAR_CONFIG;
+            p_out->len = sizeof(cccd);
+            p_out->p_value = cccd;
+            p_out->air_left = (uint16_t)(3 + sizeof(cccd) + 4);
+            break;
+
+        case HOST_PEER_CONTROL:
+            p_out->opcode = GATT_REQ_WRITE;
+            p_out->handle = HDLC_THROUGHPUT_MEASUREMENT_CONTROL_VALUE;
+            p_out->len = host_cfg.control_len;
+            p_out->p_value = host_cfg.control;
+            p_out->air_left = (uint16_t)(3 + host_cfg.control_len + 4);
+            break;
+
+        case HOST_PEER_READY:
+            p_out->busy = host_cfg.peer_reads;
+            p_out->opcode = (0 == p_conn->read_offset) ? GATT_REQ_READ : GATT_REQ_READ_BLOB;
+            p_out->handle = HDLC_THROUGHPUT_MEASUREMENT_NOTIFY_VALUE;
+            p_out->offset = p_conn->read_offset;
+            p_out->air_left = (0 == p_conn->read_offset) ? (3 + 4) : (5 + 4);
+            break;
+        }
+        if (p_out->busy)
+        {
+            p_conn->rsp_pending = WICED_TRUE;
+            return;
+        }
+    }
+
+    if ((HOST_PEER_READY == p_conn->state) && (host_cfg.peer_writes) &&
+        (p_conn->rx_pending < host_cfg.rx_buffers))
+    {
+        p_out->opcode = GATT_CMD_WRITE;
+        p_out->handle = HDLC_THROUGHPUT_MEASUREMENT_WRITEME_VALUE;
+        p_out->len = (uint16_t)(p_conn->mtu - 3);
+        p_out->p_value = host_write_value;
+        p_out->air_left = (uint16_t)(p_out->len + HOST_LINK_ATT_OVERHEAD);
+        p_out->busy = WICED_TRUE;
+    }
+}
+
+/**
+ * Function Name:
+ * host_peer_send
+ *
+ * Function Description:
+ * @brief  Hands a PDU the peer finished sending to the stack thread as an
+ *         attribute request. Called with host_link_mutex held.
+ *
+ * @param p_conn     link
+ *
+ * @return void
+ */
+static void host_peer_send(host_conn_t *p_conn)
+{
+    host_peer_pdu_t *p_out = &p_conn->out;
+    host_evt_t *p_evt = host_evt_alloc(HOST_EVT_GATT, p_out->len);
+    wiced_bt_gatt_attribute_request_t *p_req = &p_evt->u.gatt.data.attribute_request;
+
+    p_evt->p_conn = p_conn;
+    p_evt->u.gatt.event = GATT_ATTRIBUTE_REQUEST_EVT;
+    p_req->conn_id = p_conn->conn_id;
+    p_req->opcode = p_out->opcode;
+    switch (p_out->opcode)
+    {
+    case GATT_REQ_MTU:
+        p_req->data.remote_mtu = host_cfg.peer_mtu;
+        break;
+
+    case GATT_REQ_READ_BY_TYPE:
+        p_req->len_requested = (uint16_t)(p_conn->mtu - 2);
+        p_req->data.read_by_type.s_handle = 0x0001;
+        p_req->data.read_by_type.e_handle = 0xFFFF;
+        p_req->data.read_by_type.uuid.len = 2;
+        p_req->data.read_by_type.uuid.uu.uuid16 = UUID_CHARACTERISTIC_DEVICE_NAME;
+        break;
+
+    case GATT_REQ_READ:
+    case GATT_REQ_READ_BLOB:
+        p_req->len_requested = (uint16_t)(p_conn->mtu - 1);
+        p_req->data.read_req.handle = p_out->handle;
+        p_req->data.read_req.offset = p_out->offset;
+        break;
+
+    case GATT_REQ_WRITE:
+    case GATT_CMD_WRITE:
+        memcpy(p_evt->value, p_out->p_value, p_out->len);
+        p_req->data.write_req.handle = p_out->handle;
+        p_req->data.write_req.val_len = p_out->len;
+        p_req->data.write_req.p_val = p_evt->value;
+        if (GATT_CMD_WRITE == p_out->opcode)
+        {
+            p_conn->written += p_out->len;
+        }
+        break;
+
+    case GATT_HANDLE_VALUE_CONF:
+        p_conn->ind_outstanding = WICED_FALSE;
+        p_req->data.confirm = p_out->handle;
+        break;
+
+    default:
+        break;
+    }
+    p_conn->rx_pending++;
+    p_out->busy = WICED_FALSE;
+    host_evt_post(p_evt);
+}
+
+/**
+ * Function Name:
+ * host_link_run_event
+ *
+ * Function Description:
+ * @brief  Runs one connection event of a link. Each exchange carries one PDU
+ *         of the server and one of the peer, either may be empty, and the
+ *         event ends when both sides have nothing left, the packets per
+ *         event limit is hit or the next exchange would overrun the share of
+ *         the connection interval of the link. Called with host_link_mutex
+ *         held.
+ *
+ * @param p_conn     link
+ * @param budget_us  air time of the connection event
+ *
+ * @return void
+ */
+static void host_link_run_event(host_conn_t *p_conn, uint32_t budget_us)
+{
+    uint32_t max_pdus = (0 != host_cfg.packets_per_event) ? host_cfg.packets_per_event : UINT32_MAX;
+    uint32_t elapsed_us = 0, exchange_us;
+    uint16_t server_len, peer_len;
+    host_pkt_t *p_pkt;
+
+    p_conn->events++;
+    for (uint32_t pdus = 0; pdus < max_pdus; pdus++)
+    {
+        if (!p_conn->out.busy)
+        {
+            host_peer_next(p_conn);
+        }
+        server_len = (NULL != p_conn->p_head) ?
+                     MIN((uint16_t)(p_conn->p_head->air_len - p_conn->head_sent), p_conn->tx_octets) : 0;
+        peer_len = (p_conn->out.busy) ? MIN(p_conn->out.air_left, p_conn->tx_octets) : 0;
+
+        exchange_us = host_link_air_us(p_conn, server_len) + host_link_air_us(p_conn, peer_len) +
+                      (2u * HOST_LINK_T_IFS_US);
+        if ((0 != pdus) && (elapsed_us + exchange_us > budget_us))
+        {
+            break;
+        }
+        elapsed_us += exchange_us;
+        p_conn->pdus++;
+
+        if (0 != server_len)
+        {
+            p_conn->head_sent += server_len;
+            if (p_conn->head_sent == p_conn->p_head->air_len)
+            {
+                p_pkt = host_link_pop(p_conn);
+                host_peer_receive(p_conn, p_pkt);
+                host_link_release(p_conn, p_pkt);
+            }
+        }
+        if (0 != peer_len)
+        {
+            p_conn->out.air_left -= peer_len;
+            if (0 == p_conn->out.air_left)
+            {
+                host_peer_send(p_conn);
+            }
+        }
+        if ((0 == server_len) && (0 == peer_len))
+        {
+            break;
+        }
+    }
+}
+
+/**
+ * Function Name:
+ * host_link_connect
+ *
+ * Function Description:
+ * @brief  Connects the next peer to the advertising server. Called with
+ *         host_link_mutex held.
+ *
+ * @param now_ns     current time
+ *
+ * @return void
+ */
+static void host_link_connect(uint64_t now_ns)
+{
+    wiced_bt_management_evt_data_t mgmt = {0};
+    host_conn_t *p_conn = NULL;
+    host_evt_t *p_evt;
+    uint8_t index;
+
+    host_connect_ns = 0;
+    for (index = 0; index < HOST_MAX_CONN; index++)
+    {
+        if (!host_conns[index].in_use)
+        {
+            p_conn = &host_conns[index];
+            break;
+        }
+    }
+    if (NULL == p_conn)
+    {
+        return;
+    }
+
+    memset(p_conn, 0, sizeof(host_conn_t));
+    p_conn->in_use = WICED_TRUE;
+    p_conn->connected = WICED_TRUE;
+    p_conn->conn_id = (uint16_t)(index + 1);
+    p_conn->bda[0] = 0x00;
+    p_conn->bda[1] = 0x50;
+    p_conn->bda[2] = 0xC2;
+    p_conn->bda[3] = 0x70;
+    p_conn->bda[4] = 0x00;
+    p_conn->bda[5] = (uint8_t)(index + 1);
+    p_conn->mtu = 23;
+    p_conn->interval = (0 != host_cfg.interval) ? host_cfg.interval : 24;
+    p_conn->phy = HOST_PHY_1M;
+    p_conn->tx_octets = HOST_LINK_DEFAULT_OCTETS;
+    p_conn->state = HOST_PEER_MTU;
+    p_conn->up_ns = now_ns;
+    p_conn->next_ce_ns = now_ns + ((uint64_t)p_conn->interval * 1250000u);
+    host_peers_connected++;
+
+    /* Advertising stops when the peer connects */
+    mgmt.ble_advert_state_changed = BTM_BLE_ADVERT_OFF;
+    host_evt_post_mgmt(BTM_BLE_ADVERT_STATE_CHANGED_EVT, &mgmt);
+
+    p_evt = host_evt_alloc(HOST_EVT_GATT, 0);
+    p_evt->u.gatt.event = GATT_CONNECTION_STATUS_EVT;
+    p_evt->u.gatt.data.connection_status.bd_addr = p_conn->bda;
+    p_evt->u.gatt.data.connection_status.addr_type = BLE_ADDR_PUBLIC;
+    p_evt->u.gatt.data.connection_status.conn_id = p_conn->conn_id;
+    p_evt->u.gatt.data.connection_status.connected = WICED_TRUE;
+    p_evt->u.gatt.data.connection_status.transport = BT_TRANSPORT_LE;
+    host_evt_post(p_evt);
+}
+
+/**
+ * Function Name:
+ * host_link_task
+ *
+ * Function Description:
+ * @brief  Runs the connection events of every link on their interval, the
+ *         interval shared between the links, and connects the peers while
+ *         the server advertises
+ *
+ * @param arg        unused
+ *
+ * @return void
+ */
+static void host_link_task(cy_thread_arg_t arg)
+{
+    struct timespec deadline;
+    uint64_t now_ns, next_ns, interval_ns;
+    uint32_t active;
+
+    pthread_mutex_lock(&host_link_mutex);
+    while (!host_stopping)
+    {
+        now_ns = host_rtos_now_ns();
+        if ((0 != host_connect_ns) && (now_ns >= host_connect_ns))
+        {
+            host_link_connect(now_ns);
+        }
+
+        active = 0;
+        for (uint8_t i = 0; i < HOST_MAX_CONN; i++)
+        {
+            active += host_conns[i].connected ? 1u : 0u;
+        }
+
+        next_ns = (0 != host_connect_ns) ? host_connect_ns : UINT64_MAX;
+        for (uint8_t i = 0; i < HOST_MAX_CONN; i++)
+        {
+            host_conn_t *p_conn = &host_conns[i];
+
+            if (!p_conn->connected)
+            {
+                continue;
+            }
+            interval_ns = (uint64_t)p_conn->interval * 1250000u;
+            if (now_ns >= p_conn->next_ce_ns)
+            {
+                host_link_run_event(p_conn, (uint32_t)(interval_ns / 1000u / active));
+                p_conn->next_ce_ns += interval_ns;
+                if (p_conn->next_ce_ns <= now_ns)
+                {
+                    p_conn->next_ce_ns = now_ns + interval_ns;
+                }
+            }
+            next_ns = MIN(next_ns, p_conn->next_ce_ns);
+        }
+        host_link_check_congestion();
+
+        if (UINT64_MAX == next_ns)
+        {
+            pthread_cond_wait(&host_link_cond, &host_link_mutex);
+        }
+        else
+        {
+            deadline.tv_sec = (time_t)(next_ns / 1000000000u);
+            deadline.tv_nsec = (long)(next_ns % 1000000000u);
+            pthread_cond_timedwait(&host_link_cond, &host_link_mutex, &deadline);
+        }
+    }
+    pthread_mutex_unlock(&host_link_mutex);
+    cy_rtos_exit_thread();
+}
+
+/**
+ * Function Name:
+ * host_stack_is_request
+ *
+ * Function Description:
+ * @brief  Tells whether an ATT opcode expects a response
+ *
+ * @param opcode     ATT opcode
+ *
+ * @return wiced_bool_t  WICED_TRUE for requests
+ */
+static wiced_bool_t host_stack_is_request(wiced_bt_gatt_opcode_t opcode)
+{
+    switch (opcode)
+    {
+    case GATT_REQ_MTU:
+    case GATT_REQ_READ_BY_TYPE:
+    case GATT_REQ_READ:
+    case GATT_REQ_READ_BLOB:
+    case GATT_REQ_WRITE:
+    case GATT_REQ_PREPARE_WRITE:
+    case GATT_REQ_EXECUTE_WRITE:
+        return WICED_TRUE;
+    default:
+        return WICED_FALSE;
+    }
+}
+
+/**
+ * Function Name:
+ * host_stack_dispatch
+ *
+ * Function Description:
+ * @brief  Delivers one event to the application. A request the application
+ *         rejected without responding gets an error response, as the stack
+ *         sends one.
+ *
+ * @param p_evt      event
+ *
+ * @return void
+ */
+static void host_stack_dispatch(host_evt_t *p_evt)
+{
+    wiced_bt_gatt_attribute_request_t *p_req = &p_evt->u.gatt.data.attribute_request;
+    host_conn_t *p_conn = p_evt->p_conn;
+    wiced_bt_gatt_status_t status;
+    wiced_bool_t request;
+
+    switch (p_evt->type)
+    {
+    case HOST_EVT_MANAGEMENT:
+        host_mgmt_cb(p_evt->u.mgmt.event, &p_evt->u.mgmt.data);
+        break;
+
+    case HOST_EVT_GATT:
+        request = (GATT_ATTRIBUTE_REQUEST_EVT == p_evt->u.gatt.event) && host_stack_is_request(p_req->opcode);
+        if ((request) && (NULL != p_conn))
+        {
+            pthread_mutex_lock(&host_link_mutex);
+            p_conn->answered = WICED_FALSE;
+            pthread_mutex_unlock(&host_link_mutex);
+        }
+        status = host_gatt_cb(p_evt->u.gatt.event, &p_evt->u.gatt.data);
+        if ((request) && (NULL != p_conn))
+        {
+            pthread_mutex_lock(&host_link_mutex);
+            if ((p_conn->connected) && (!p_conn->answered))
+            {
+                if (WICED_BT_GATT_SUCCESS != status)
+                {
+                    host_link_queue(p_conn, HOST_PKT_RESPONSE, GATT_RSP_ERROR, 0, NULL, 0, 5 + 4, NULL);
+                }
+                else
+                {
+                    printf("Host stack: request 0x%02X not answered [conn_id %d]\n", p_req->opcode,
+                           p_conn->conn_id);
+                    p_conn->rsp_pending = WICED_FALSE;
+                }
+            }
+            pthread_mutex_unlock(&host_link_mutex);
+        }
+        break;
+
+    case HOST_EVT_RSSI:
+        p_evt->u.rssi.p_cb(&p_evt->u.rssi.result);
+        break;
+
+    case HOST_EVT_COC_CONNECT:
+        if (NULL != host_coc_info.le_connect_ind_cb)
+        {
+            host_coc_info.le_connect_ind_cb(host_coc_context, host_conns[p_evt->u.coc.value].bda,
+                                            p_evt->u.coc.cid, host_coc_psm, 1, HOST_PEER_COC_MTU);
+        }
+        break;
+
+    case HOST_EVT_COC_CONGESTION:
+        if (NULL != host_coc_info.congestion_status_cb)
+        {
+            host_coc_info.congestion_status_cb(host_coc_context, p_evt->u.coc.cid, p_evt->u.coc.value);
+        }
+        break;
+
+    case HOST_EVT_COC_TX_COMPLETE:
+        if (NULL != host_coc_info.tx_complete_cb)
+        {
+            host_coc_info.tx_complete_cb(host_coc_context, p_evt->u.coc.cid, p_evt->u.coc.value);
+        }
+        break;
+    }
+
+    if (NULL != p_conn)
+    {
+        pthread_mutex_lock(&host_link_mutex);
+        p_conn->rx_pending--;
+        pthread_mutex_unlock(&host_link_mutex);
+    }
+}
+
+/**
+ * Function Name:
+ * host_stack_task
+ *
+ * Function Description:
+ * @brief  The Bluetooth stack thread, delivers the queued events to the
+ *         application callbacks in order
+ *
+ * @param arg        unused
+ *
+ * @return void
+ */
+static void host_stack_task(cy_thread_arg_t arg)
+{
+    host_evt_t *p_evt;
+
+    while (true)
+    {
+        pthread_mutex_lock(&host_evt_mutex);
+        host_evt_busy = WICED_FALSE;
+        pthread_cond_broadcast(&host_evt_cond);
+        while (NULL == host_evt_head)
+        {
+            pthread_cond_wait(&host_evt_cond, &host_evt_mutex);
+        }
+        p_evt = host_evt_head;
+        host_evt_head = p_evt->p_next;
+        if (NULL == host_evt_head)
+        {
+            host_evt_tail = NULL;
+        }
+        host_evt_busy = WICED_TRUE;
+        pthread_mutex_unlock(&host_evt_mutex);
+
+        host_stack_dispatch(p_evt);
+        free(p_evt);
+    }
+}
+
+/****************************************************************************
+ *                          Stack interface
+ ***************************************************************************/
+
+/**
+ * Function Name:
+ * wiced_bt_stack_init
+ *
+ * Function Description:
+ * @brief  Starts the stack and link threads and reports the stack enabled
+ *
+ * @return wiced_result_t WICED_BT_SUCCESS
+ */
+wiced_result_t wiced_bt_stack_init(wiced_bt_management_cback_t *p_bt_management_cback,
+                                   const wiced_bt_cfg_settings_t *p_bt_cfg_settings)
+{
+    wiced_bt_management_evt_data_t mgmt = {0};
+    pthread_condattr_t attr;
+
+    host_mgmt_cb = p_bt_management_cback;
+    pthread_condattr_init(&attr);
+    pthread_condattr_setclock(&attr, CLOCK_MONOTONIC);
+    pthread_cond_init(&host_link_cond, &attr);
+    pthread_condattr_destroy(&attr);
+    pthread_cond_init(&host_evt_cond, NULL);
+    for (uint32_t i = 0; i < sizeof(host_write_value); i++)
+    {
+        host_write_value[i] = (uint8_t)i;
+    }
+
+    if ((CY_RSLT_SUCCESS != cy_rtos_thread_create(&host_stack_thread, host_stack_task, "BT Stack", NULL, 0,
+                                                  CY_RTOS_PRIORITY_HIGH, NULL)) ||
+        (CY_RSLT_SUCCESS != cy_rtos_thread_create(&host_link_thread, host_link_task, "Virtual Link", NULL, 0,
+                                                  CY_RTOS_PRIORITY_REALTIME, NULL)))
+    {
+        return WICED_BT_ERROR;
+    }
+
+    mgmt.enabled.status = WICED_BT_SUCCESS;
+    host_evt_post_mgmt(BTM_ENABLED_EVT, &mgmt);
+    return WICED_BT_SUCCESS;
+}
+
+/**
+ * Function Name:
+ * wiced_bt_set_local_bdaddr
+ *
+ * Function Description:
+ * @brief  Sets the local address
+ *
+ * @return void
+ */
+void wiced_bt_set_local_bdaddr(wiced_bt_device_address_t bda, wiced_bt_ble_address_type_t addr_type)
+{
+    memcpy(host_local_bda, bda, BD_ADDR_LEN);
+}
+
+/**
+ * Function Name:
+ * wiced_bt_dev_read_local_addr
+ *
+ * Function Description:
+ * @brief  Returns the local address
+ *
+ * @return void
+ */
+void wiced_bt_dev_read_local_addr(wiced_bt_device_address_t bd_addr)
+{
+    memcpy(bd_addr, host_local_bda, BD_ADDR_LEN);
+}
+
+/**
+ * Function Name:
+ * wiced_bt_set_pairable_mode
+ *
+ * Function Description:
+ * @brief  The virtual peers do not pair
+ *
+ * @return void
+ */
+void wiced_bt_set_pairable_mode(uint8_t allow_pairing, uint8_t connect_only_paired)
+{
+}
+
+/**
+ * Function Name:
+ * wiced_bt_dev_register_hci_trace
+ *
+ * Function Description:
+ * @brief  There is no HCI on the host
+ *
+ * @return void
+ */
+void wiced_bt_dev_register_hci_trace(wiced_bt_hci_trace_cback_t *p_cback)
+{
+}
+
+/**
+ * Function Name:
+ * wiced_bt_dev_read_rssi
+ *
+ * Function Description:
+ * @brief  Reports HOST_LINK_RSSI to the completion callback
+ *
+ * @return wiced_bt_dev_status_t WICED_BT_PENDING
+ */
+wiced_bt_dev_status_t wiced_bt_dev_read_rssi(wiced_bt_device_address_t remote_bda, wiced_bt_transport_t transport,
+                                             wiced_bt_dev_cmpl_cback_t *p_cback)
+{
+    host_evt_t *p_evt;
+
+    if (NULL == p_cback)
+    {
+        return WICED_BADARG;
+    }
+    p_evt = host_evt_alloc(HOST_EVT_RSSI, 0);
+    p_evt->u.rssi.p_cb = p_cback;
+    p_evt->u.rssi.result.status = WICED_BT_SUCCESS;
+    p_evt->u.rssi.result.rssi = host_cfg.rssi;
+    memcpy(p_evt->u.rssi.result.rem_bda, remote_bda, BD_ADDR_LEN);
+    host_evt_post(p_evt);
+    return WICED_BT_PENDING;
+}
+
+/**
+ * Function Name:
+ * wiced_bt_ble_set_raw_advertisement_data
+ *
+ * Function Description:
+ * @brief  The advertisement data is not used by the virtual peers
+ *
+ * @return wiced_result_t WICED_BT_SUCCESS
+ */
+wiced_result_t wiced_bt_ble_set_raw_advertisement_data(uint8_t num_elem, wiced_bt_ble_advert_elem_t *p_data)
+{
+    return WICED_BT_SUCCESS;
+}
+
+/**
+ * Function Name:
+ * wiced_bt_start_advertisements
+ *
+ * Function Description:
+ * @brief  Reports the advertising state and, while peers are left to
+ *         connect, connects the next one shortly after
+ *
+ * @return wiced_result_t WICED_BT_SUCCESS
+ */
+wiced_result_t wiced_bt_start_advertisements(wiced_bt_ble_advert_mode_t advert_mode,
+                                             wiced_bt_ble_address_type_t directed_advertisement_bdaddr_type,
+                                             wiced_bt_device_address_t directed_advertisement_bdaddr_ptr)
+{
+    wiced_bt_management_evt_data_t mgmt = {0};
+
+    mgmt.ble_advert_state_changed = advert_mode;
+    host_evt_post_mgmt(BTM_BLE_ADVERT_STATE_CHANGED_EVT, &mgmt);
+
+    pthread_mutex_lock(&host_link_mutex);
+    if ((BTM_BLE_ADVERT_OFF != advert_mode) && (host_peers_connected < host_cfg.peers) && (!host_stopping))
+    {
+        host_connect_ns = host_rtos_now_ns() + (HOST_LINK_CONNECT_DELAY_MS * 1000000ull);
+        pthread_cond_broadcast(&host_link_cond);
+    }
+    pthread_mutex_unlock(&host_link_mutex);
+    return WICED_BT_SUCCESS;
+}
+
+/**
+ * Function Name:
+ * wiced_bt_ble_set_phy
+ *
+ * Function Description:
+ * @brief  Switches a link to the requested PHY, or to HOST_LINK_PHY when set
+ *
+ * @return wiced_bt_dev_status_t WICED_BT_ERROR for an unknown peer
+ */
+wiced_bt_dev_status_t wiced_bt_ble_set_phy(wiced_bt_ble_phy_preferences_t *p_phy_preferences)
+{
+    wiced_bt_management_evt_data_t mgmt = {0};
+    host_conn_t *p_conn;
+    uint8_t phy = HOST_PHY_1M;
+    uint16_t phy_opts = BTM_BLE_PREFER_LELR_125K;
+
+    if (0 != host_cfg.phy)
+    {
+        phy = host_cfg.phy;
+        phy_opts = host_cfg.phy_opts;
+    }
+    else if (p_phy_preferences->tx_phys & BTM_BLE_PREFER_2M_PHY)
+    {
+        phy = HOST_PHY_2M;
+    }
+    else if (p_phy_preferences->tx_phys & BTM_BLE_PREFER_LELR_PHY)
+    {
+        phy = HOST_PHY_CODED;
+        phy_opts = (BTM_BLE_PREFER_LELR_512K == p_phy_preferences->phy_opts) ? BTM_BLE_PREFER_LELR_512K :
+                                                                             BTM_BLE_PREFER_LELR_125K;
+    }
+
+    pthread_mutex_lock(&host_link_mutex);
+    p_conn = host_conn_find_bda(p_phy_preferences->remote_bd_addr);
+    if (NULL == p_conn)
+    {
+        pthread_mutex_unlock(&host_link_mutex);
+        return WICED_BT_ERROR;
+    }
+    p_conn->phy = phy;
+    p_conn->phy_opts = phy_opts;
+    memcpy(mgmt.ble_phy_update_event.bd_address, p_conn->bda, BD_ADDR_LEN);
+    mgmt.ble_phy_update_event.tx_phy = phy;
+    mgmt.ble_phy_update_event.rx_phy = phy;
+    host_evt_post_mgmt(BTM_BLE_PHY_UPDATE_EVT, &mgmt);
+    pthread_mutex_unlock(&host_link_mutex);
+    return WICED_BT_SUCCESS;
+}
+
+/**
+ * Function Name:
+ * wiced_bt_ble_set_data_packet_length
+ *
+ * Function Description:
+ * @brief  Sets the LL payload of a link, limited by HOST_LINK_PDU_SIZE
+ *
+ * @return wiced_bt_dev_status_t WICED_BT_ERROR for an unknown peer
+ */
+wiced_bt_dev_status_t wiced_bt_ble_set_data_packet_length(wiced_bt_device_address_t bd_addr,
+                                                          uint16_t tx_pdu_length, uint16_t tx_time)
+{
+    wiced_bt_management_evt_data_t mgmt = {0};
+    host_conn_t *p_conn;
+
+    pthread_mutex_lock(&host_link_mutex);
+    p_conn = host_conn_find_bda(bd_addr);
+    if (NULL == p_conn)
+    {
+        pthread_mutex_unlock(&host_link_mutex);
+        return WICED_BT_ERROR;
+    }
+    p_conn->tx_octets = MAX(HOST_LINK_DEFAULT_OCTETS, MIN(tx_pdu_length, host_cfg.pdu_size));
+    memcpy(mgmt.ble_data_length_update_event.bd_address, p_conn->bda, BD_ADDR_LEN);
+    mgmt.ble_data_length_update_event.max_tx_octets = p_conn->tx_octets;
+    mgmt.ble_data_length_update_event.max_rx_octets = p_conn->tx_octets;
+    mgmt.ble_data_length_update_event.max_tx_time = tx_time;
+    mgmt.ble_data_length_update_event.max_rx_time = tx_time;
+    host_evt_post_mgmt(BTM_BLE_DATA_LENGTH_UPDATE_EVENT, &mgmt);
+    pthread_mutex_unlock(&host_link_mutex);
+    return WICED_BT_SUCCESS;
+}
+
+/**
+ * Function Name:
+ * wiced_bt_l2cap_update_ble_conn_params
+ *
+ * Function Description:
+ * @brief  Grants the minimum requested interval, or HOST_LINK_INTERVAL when set
+ *
+ * @return wiced_bool_t WICED_FALSE for an unknown peer or an interval range
+ *                      outside 6 to 3200
+ */
+wiced_bool_t wiced_bt_l2cap_update_ble_conn_params(wiced_bt_device_address_t rem_bdRa,
+                                                   uint16_t min_int, uint16_t max_int,
+                                                   uint16_t latency, uint16_t timeout)
+{
+    wiced_bt_management_evt_data_t mgmt = {0};
+    host_conn_t *p_conn;
+
+    pthread_mutex_lock(&host_link_mutex);
+    p_conn = host_conn_find_bda(rem_bdRa);
+    if ((NULL == p_conn) || (min_int < 6) || (max_int > 3200) || (min_int > max_int))
+    {
+        pthread_mutex_unlock(&host_link_mutex);
+        return WICED_FALSE;
+    }
+    p_conn->interval = (0 != host_cfg.interval) ? host_cfg.interval : min_int;
+    memcpy(mgmt.ble_connection_param_update.bd_addr, p_conn->bda, BD_ADDR_LEN);
+    mgmt.ble_connection_param_update.conn_interval = p_conn->interval;
+    mgmt.ble_connection_param_update.conn_latency = latency;
+    mgmt.ble_connection_param_update.supervision_timeout = timeout;
+    host_evt_post_mgmt(BTM_BLE_CONNECTION_PARAM_UPDATE, &mgmt);
+    pthread_mutex_unlock(&host_link_mutex);
+    return WICED_TRUE;
+}
+
+/**
+ * Function Name:
+ * wiced_bt_ble_get_connection_parameters
+ *
+ * Function Description:
+ * @brief  Returns the current parameters of a link
+ *
+ * @return wiced_bool_t WICED_FALSE for an unknown peer
+ */
+wiced_bool_t wiced_bt_ble_get_connection_parameters(wiced_bt_device_address_t remote_bda,
+                                                    wiced_bt_ble_conn_params_t *p_conn_parameters)
+{
+    host_conn_t *p_conn;
+
+    pthread_mutex_lock(&host_link_mutex);
+    p_conn = host_conn_find_bda(remote_bda);
+    if (NULL != p_conn)
+    {
+        memset(p_conn_parameters, 0, sizeof(wiced_bt_ble_conn_params_t));
+        p_conn_parameters->role = 1;
+        p_conn_parameters->conn_interval = p_conn->interval;
+        p_conn_parameters->supervision_timeout = CY_BT_SUPERVISION_TIMEOUT;
+    }
+    pthread_mutex_unlock(&host_link_mutex);
+    return (NULL != p_conn) ? WICED_TRUE : WICED_FALSE;
+}
+
+/**
+ * Function Name:
+ * wiced_bt_ble_get_available_tx_buffers
+ *
+ * Function Description:
+ * @brief  Returns the free controller TX buffers shared by the links
+ *
+ * @return int       free buffers
+ */
+int wiced_bt_ble_get_available_tx_buffers(void)
+{
+    int available;
+
+    pthread_mutex_lock(&host_link_mutex);
+    available = (host_tx_used < host_cfg.tx_buffers) ? (int)(host_cfg.tx_buffers - host_tx_used) : 0;
+    pthread_mutex_unlock(&host_link_mutex);
+    return available;
+}
+
+/**
+ * Function Name:
+ * wiced_bt_gatt_register
+ *
+ * Function Description:
+ * @brief  Registers the GATT callback of the application
+ *
+ * @return wiced_bt_gatt_status_t WICED_BT_GATT_SUCCESS
+ */
+wiced_bt_gatt_status_t wiced_bt_gatt_register(wiced_bt_gatt_cback_t *p_gatt_cback)
+{
+    host_gatt_cb = p_gatt_cback;
+    return WICED_BT_GATT_SUCCESS;
+}
+
+/**
+ * Function Name:
+ * wiced_bt_gatt_db_init
+ *
+ * Function Description:
+ * @brief  Keeps the GATT database for the read-by-type searches
+ *
+ * @return wiced_bt_gatt_status_t WICED_BT_GATT_SUCCESS
+ */
+wiced_bt_gatt_status_t wiced_bt_gatt_db_init(const uint8_t *p_gatt_db, uint32_t gatt_db_size, void *hash)
+{
+    host_gatt_db = p_gatt_db;
+    host_gatt_db_len = gatt_db_size;
+    return WICED_BT_GATT_SUCCESS;
+}
+
+/**
+ * Function Name:
+ * wiced_bt_gatt_disconnect
+ *
+ * Function Description:
+ * @brief  Disconnects a peer on request of the server
+ *
+ * @return wiced_bt_gatt_status_t WICED_BT_GATT_ILLEGAL_PARAMETER for an unknown connection
+ */
+wiced_bt_gatt_status_t wiced_bt_gatt_disconnect(uint16_t conn_id)
+{
+    host_conn_t *p_conn;
+
+    pthread_mutex_lock(&host_link_mutex);
+    p_conn = host_conn_find(conn_id);
+    if (NULL != p_conn)
+    {
+        host_link_disconnect(p_conn, GATT_CONN_TERMINATE_LOCAL_HOST);
+    }
+    pthread_mutex_unlock(&host_link_mutex);
+    return (NULL != p_conn) ? WICED_BT_GATT_SUCCESS : WICED_BT_GATT_ILLEGAL_PARAMETER;
+}
+
+/**
+ * Function Name:
+ * host_gatt_send_value
+ *
+ * Function Description:
+ * @brief  Queues a notification or an indication. A send that finds the
+ *         controller buffers full is refused with WICED_BT_GATT_CONGESTED,
+ *         the send that fills them is accepted and reports the congestion.
+ *
+ * @return wiced_bt_gatt_status_t  status of the send
+ */
+static wiced_bt_gatt_status_t host_gatt_send_value(host_pkt_kind_t kind, uint16_t conn_id, uint16_t attr_handle,
+                                                   uint16_t attr_len, uint8_t *p_attr_val, void *p_app_ctx)
+{
+    wiced_bt_gatt_status_t status = WICED_BT_GATT_SUCCESS;
+    host_conn_t *p_conn;
+
+    pthread_mutex_lock(&host_link_mutex);
+    p_conn = host_conn_find(conn_id);
+    if (NULL == p_conn)
+    {
+        status = WICED_BT_GATT_ILLEGAL_PARAMETER;
+    }
+    else if (attr_len > (p_conn->mtu - 3))
+    {
+        status = WICED_BT_GATT_ILLEGAL_PARAMETER;
+    }
+    else if ((HOST_PKT_INDICATION == kind) && (p_conn->ind_outstanding))
+    {
+        status = WICED_BT_GATT_BUSY;
+    }
+    else if (host_tx_used >= host_cfg.tx_buffers)
+    {
+        if (!p_conn->congested)
+        {
+            host_evt_post_congestion(p_conn, WICED_TRUE);
+        }
+        status = WICED_BT_GATT_CONGESTED;
+    }
+    else
+    {
+        host_link_queue(p_conn, kind, 0, attr_handle, p_attr_val, attr_len, HOST_LINK_ATT_OVERHEAD, p_app_ctx);
+        p_conn->ind_outstanding |= (HOST_PKT_INDICATION == kind);
+        if ((host_tx_used >= host_cfg.tx_buffers) && (!p_conn->congested))
+        {
+            host_evt_post_congestion(p_conn, WICED_TRUE);
+        }
+    }
+    pthread_mutex_unlock(&host_link_mutex);
+    return status;
+}
+
+/**
+ * Function Name:
+ * wiced_bt_gatt_server_send_notification
+ *
+ * Function Description:
+ * @brief  Queues a notification for a peer
+ *
+ * @return wiced_bt_gatt_status_t  status of the send
+ */
+wiced_bt_gatt_status_t wiced_bt_gatt_server_send_notification(uint16_t conn_id, uint16_t attr_handle,
+                                                               uint16_t attr_len, uint8_t *p_attr_val,
+                                                               void *p_app_ctx)
+{
+    return host_gatt_send_value(HOST_PKT_NOTIFICATION, conn_id, attr_handle, attr_len, p_attr_val, p_app_ctx);
+}
+
+/**
+ * Function Name:
+ * wiced_bt_gatt_server_send_indication
+ *
+ * Function Description:
+ * @brief  Queues an indication for a peer, one at a time until confirmed
+ *
+ * @return wiced_bt_gatt_status_t  status of the send
+ */
+wiced_bt_gatt_status_t wiced_bt_gatt_server_send_indication(uint16_t conn_id, uint16_t attr_handle,
+                                                             uint16_t attr_len, uint8_t *p_attr_val,
+                                                             void *p_app_ctx)
+{
+    return host_gatt_send_value(HOST_PKT_INDICATION, conn_id, attr_handle, attr_len, p_attr_val, p_app_ctx);
+}
+
+/**
+ * Function Name:
+ * host_gatt_respond
+ *
+ * Function Description:
+ * @brief  Queues the response to the request of a peer. Responses are
+ *         accepted even with the controller buffers full.
+ *
+ * @return wiced_bt_gatt_status_t  WICED_BT_GATT_ILLEGAL_PARAMETER for an unknown connection
+ */
+static wiced_bt_gatt_status_t host_gatt_respond(uint16_t conn_id, uint8_t rsp_opcode, uint16_t handle,
+                                                uint8_t *p_data, uint16_t len, uint16_t hdr_len, void *p_app_ctx)
+{
+    host_conn_t *p_conn;
+
+    pthread_mutex_lock(&host_link_mutex);
+    p_conn = host_conn_find(conn_id);
+    if (NULL != p_conn)
+    {
+        host_link_queue(p_conn, HOST_PKT_RESPONSE, rsp_opcode, handle, p_data, len, hdr_len, p_app_ctx);
+        p_conn->answered = WICED_TRUE;
+    }
+    pthread_mutex_unlock(&host_link_mutex);
+    return (NULL != p_conn) ? WICED_BT_GATT_SUCCESS : WICED_BT_GATT_ILLEGAL_PARAMETER;
+}
+
+/**
+ * Function Name:
+ * wiced_bt_gatt_server_send_mtu_rsp
+ *
+ * Function Description:
+ * @brief  Answers the MTU exchange, the smaller MTU applies from now on
+ *
+ * @return wiced_bt_gatt_status_t  status of the send
+ */
+wiced_bt_gatt_status_t wiced_bt_gatt_server_send_mtu_rsp(uint16_t conn_id, uint16_t remote_mtu, uint16_t my_mtu)
+{
+    host_conn_t *p_conn;
+
+    pthread_mutex_lock(&host_link_mutex);
+    p_conn = host_conn_find(conn_id);
+    if (NULL != p_conn)
+    {
+        p_conn->mtu = MAX(23, MIN(MIN(remote_mtu, my_mtu), HOST_PEER_MAX_MTU));
+    }
+    pthread_mutex_unlock(&host_link_mutex);
+    return host_gatt_respond(conn_id, GATT_RSP_MTU, 0, NULL, 0, 3 + 4, NULL);
+}
+
+/**
+ * Function Name:
+ * wiced_bt_gatt_server_send_write_rsp
+ *
+ * Function Description:
+ * @brief  Answers a write request
+ *
+ * @return wiced_bt_gatt_status_t  status of the send
+ */
+wiced_bt_gatt_status_t wiced_bt_gatt_server_send_write_rsp(uint16_t conn_id, wiced_bt_gatt_opcode_t opcode,
+                                                            uint16_t handle)
+{
+    return host_gatt_respond(conn_id, GATT_RSP_WRITE, handle, NULL, 0, 1 + 4, NULL);
+}
+
+/**
+ * Function Name:
+ * wiced_bt_gatt_server_send_error_rsp
+ *
+ * Function Description:
+ * @brief  Answers a request with an error
+ *
+ * @return wiced_bt_gatt_status_t  status of the send
+ */
+wiced_bt_gatt_status_t wiced_bt_gatt_server_send_error_rsp(uint16_t conn_id, wiced_bt_gatt_opcode_t opcode,
+                                                            uint16_t handle, wiced_bt_gatt_status_t status)
+{
+    return host_gatt_respond(conn_id, GATT_RSP_ERROR, handle, NULL, 0, 5 + 4, NULL);
+}
+
+/**
+ * Function Name:
+ * wiced_bt_gatt_server_send_read_handle_rsp
+ *
+ * Function Description:
+ * @brief  Answers a read or read blob request
+ *
+ * @return wiced_bt_gatt_status_t  status of the send
+ */
+wiced_bt_gatt_status_t wiced_bt_gatt_server_send_read_handle_rsp(uint16_t conn_id, wiced_bt_gatt_opcode_t opcode,
+                                                                  uint16_t len, uint8_t *p_attr, void *p_app_ctx)
+{
+    return host_gatt_respond(conn_id, (uint8_t)(opcode + 1), 0, p_attr, len, 1 + 4, p_app_ctx);
+}
+
+/**
+ * Function Name:
+ * wiced_bt_gatt_server_send_read_by_type_rsp
+ *
+ * Function Description:
+ * @brief  Answers a read-by-type request
+ *
+ * @return wiced_bt_gatt_status_t  status of the send
+ */
+wiced_bt_gatt_status_t wiced_bt_gatt_server_send_read_by_type_rsp(uint16_t conn_id, wiced_bt_gatt_opcode_t opcode,
+                                                                   uint8_t type_len, uint16_t data_len,
+                                                                   uint8_t *p_data, void *p_app_ctx)
+{
+    return host_gatt_respond(conn_id, GATT_RSP_READ_BY_TYPE, 0, p_data, data_len, 2 + 4, p_app_ctx);
+}
+
+/**
+ * Function Name:
+ * wiced_bt_gatt_server_send_prepare_write_rsp
+ *
+ * Function Description:
+ * @brief  Echoes a prepared write segment
+ *
+ * @return wiced_bt_gatt_status_t  status of the send
+ */
+wiced_bt_gatt_status_t wiced_bt_gatt_server_send_prepare_write_rsp(uint16_t conn_id, wiced_bt_gatt_opcode_t opcode,
+                                                                    uint16_t handle, uint16_t offset, uint16_t len,
+                                                                    uint8_t *p_data, void *p_app_ctx)
+{
+    return host_gatt_respond(conn_id, GATT_RSP_PREPARE_WRITE, handle, p_data, len, 5 + 4, p_app_ctx);
+}
+
+/**
+ * Function Name:
+ * wiced_bt_gatt_server_send_execute_write_rsp
+ *
+ * Function Description:
+ * @brief  Answers an execute write request
+ *
+ * @return wiced_bt_gatt_status_t  status of the send
+ */
+wiced_bt_gatt_status_t wiced_bt_gatt_server_send_execute_write_rsp(uint16_t conn_id, wiced_bt_gatt_opcode_t opcode)
+{
+    return host_gatt_respond(conn_id, GATT_RSP_EXECUTE_WRITE, 0, NULL, 0, 1 + 4, NULL);
+}
+
+/**
+ * Function Name:
+ * wiced_bt_gatt_find_handle_by_type
+ *
+ * Function Description:
+ * @brief  Returns the first attribute of a type in a handle range, walking
+ *         the records of the GATT database
+ *
+ * @return uint16_t  attribute handle, 0 if none
+ */
+uint16_t wiced_bt_gatt_find_handle_by_type(uint16_t s_handle, uint16_t e_handle, wiced_bt_uuid_t *p_uuid)
+{
+    uint32_t pos = 0;
+    uint16_t handle;
+    uint8_t perm, len;
+
+    while ((NULL != host_gatt_db) && (pos + 4 <= host_gatt_db_len))
+    {
+        handle = (uint16_t)(host_gatt_db[pos] | (host_gatt_db[pos + 1] << 8));
+        perm = host_gatt_db[pos + 2];
+        len = host_gatt_db[pos + 3];
+        if ((handle >= s_handle) && (handle <= e_handle))
+        {
+            if ((perm & GATTDB_PERM_SERVICE_UUID_128) && (16 == p_uuid->len) &&
+                (0 == memcmp(&host_gatt_db[pos + 4], p_uuid->uu.uuid128, 16)))
+            {
+                return handle;
+            }
+            if ((!(perm & GATTDB_PERM_SERVICE_UUID_128)) && (2 == p_uuid->len) &&
+                (p_uuid->uu.uuid16 == (uint16_t)(host_gatt_db[pos + 4] | (host_gatt_db[pos + 5] << 8))))
+            {
+                return handle;
+            }
+        }
+        pos += 4u + len;
+    }
+    return 0;
+}
+
+/**
+ * Function Name:
+ * wiced_bt_gatt_put_read_by_type_rsp_in_stream
+ *
+ * Function Description:
+ * @brief  Appends a handle and value pair to a read-by-type response. Every
+ *         pair of a response has the length of the first one.
+ *
+ * @return int       bytes appended, 0 if the pair does not fit
+ */
+int wiced_bt_gatt_put_read_by_type_rsp_in_stream(uint8_t *p_stream, int stream_len, uint8_t *p_pair_len,
+                                                 uint16_t attr_handle, uint16_t attr_len, uint8_t *p_attr)
+{
+    int pair_len = 2 + MIN(attr_len, 253);
+
+    if ((0 != *p_pair_len) && (pair_len != *p_pair_len))
+    {
+        return 0;
+    }
+    if (pair_len > stream_len)
+    {
+        return 0;
+    }
+    p_stream[0] = (uint8_t)(attr_handle & 0xFF);
+    p_stream[1] = (uint8_t)(attr_handle >> 8);
+    memcpy(&p_stream[2], p_attr, (size_t)(pair_len - 2));
+    *p_pair_len = (uint8_t)pair_len;
+    return pair_len;
+}
+
+/**
+ * Function Name:
+ * wiced_bt_l2cap_le_register
+ *
+ * Function Description:
+ * @brief  Registers the L2CAP callbacks of a PSM, one PSM on the host
+ *
+ * @return uint16_t  the PSM
+ */
+uint16_t wiced_bt_l2cap_le_register(uint16_t le_psm, wiced_bt_l2cap_le_appl_information_t *p_cb_info, void *context)
+{
+    host_coc_info = *p_cb_info;
+    host_coc_context = context;
+    host_coc_psm = le_psm;
+    return le_psm;
+}
+
+/**
+ * Function Name:
+ * wiced_bt_l2cap_le_connect_rsp
+ *
+ * Function Description:
+ * @brief  Opens the channel a peer requested when accepted
+ *
+ * @return wiced_bool_t  WICED_FALSE for an unknown peer
+ */
+wiced_bool_t wiced_bt_l2cap_le_connect_rsp(wiced_bt_device_address_t p_bd_addr, uint8_t id, uint16_t lcid,
+                                           uint16_t result, uint16_t mtu_size)
+{
+    host_conn_t *p_conn;
+
+    pthread_mutex_lock(&host_link_mutex);
+    p_conn = host_conn_find_bda(p_bd_addr);
+    if ((NULL != p_conn) && (L2CAP_CONN_OK == result))
+    {
+        p_conn->coc_cid = lcid;
+    }
+    pthread_mutex_unlock(&host_link_mutex);
+    return (NULL != p_conn) ? WICED_TRUE : WICED_FALSE;
+}
+
+/**
+ * Function Name:
+ * wiced_bt_l2cap_le_disconnect_rsp
+ *
+ * Function Description:
+ * @brief  Completes the closing of a channel
+ *
+ * @return wiced_bool_t  WICED_TRUE
+ */
+wiced_bool_t wiced_bt_l2cap_le_disconnect_rsp(uint16_t lcid)
+{
+    return WICED_TRUE;
+}
+
+/**
+ * Function Name:
+ * wiced_bt_l2cap_le_data_write
+ *
+ * Function Description:
+ * @brief  Queues an SDU, segmented into K-frames of the registered MPS. A
+ *         write that fills the controller buffers is queued and reported
+ *         congested.
+ *
+ * @return uint8_t   L2CAP_DATAWRITE_*
+ */
+uint8_t wiced_bt_l2cap_le_data_write(uint16_t cid, uint8_t *p_data, uint16_t buf_len, uint16_t flags)
+{
+    uint16_t mps = (0 != host_coc_info.le_mps) ? host_coc_info.le_mps : 23;
+    uint16_t frames = (uint16_t)((buf_len + HOST_LINK_SDU_LEN_FIELD + mps - 1) / mps);
+    uint8_t result = L2CAP_DATAWRITE_SUCCESS;
+    host_conn_t *p_conn;
+
+    pthread_mutex_lock(&host_link_mutex);
+    p_conn = host_conn_find_cid(cid);
+    if (NULL == p_conn)
+    {
+        result = L2CAP_DATAWRITE_FAILED;
+    }
+    else
+    {
+        host_link_queue(p_conn, HOST_PKT_COC, 0, 0, p_data, buf_len,
+                        (uint16_t)(HOST_LINK_SDU_LEN_FIELD + (frames * HOST_LINK_KFRAME_OVERHEAD)), NULL);
+        if (host_tx_used >= host_cfg.tx_buffers)
+        {
+            if (!p_conn->coc_congested)
+            {
+                p_conn->coc_congested = WICED_TRUE;
+                host_evt_post_coc(HOST_EVT_COC_CONGESTION, cid, WICED_TRUE);
+            }
+            result = L2CAP_DATAWRITE_CONGESTED;
+        }
+    }
+    pthread_mutex_unlock(&host_link_mutex);
+    return result;
+}
+
+/****************************************************************************
+ *                          Host control
+ ***************************************************************************/
+
+/**
+ * Function Name:
+ * host_bt_stack_configure
+ *
+ * Function Description:
+ * @brief  Reads the virtual link and peer settings from the environment
+ *
+ * @return void
+ */
+void host_bt_stack_configure(void)
+{
+    const char *p_phy = getenv("HOST_LINK_PHY");
+    const char *p_control = getenv("HOST_PEER_CONTROL");
+    unsigned int byte;
+
+    host_cfg.interval = (uint16_t)host_env_u32("HOST_LINK_INTERVAL", host_cfg.interval);
+    if (0 != host_cfg.interval)
+    {
+        host_cfg.interval = (uint16_t)MAX(6, MIN(host_cfg.interval, 3200));
+    }
+    host_cfg.pdu_size = (uint16_t)MAX(HOST_LINK_DEFAULT_OCTETS,
+                                      MIN(host_env_u32("HOST_LINK_PDU_SIZE", host_cfg.pdu_size), 251));
+    host_cfg.packets_per_event = (uint16_t)host_env_u32("HOST_LINK_PACKETS_PER_EVENT", host_cfg.packets_per_event);
+    host_cfg.rssi = (int8_t)(NULL != getenv("HOST_LINK_RSSI") ? atoi(getenv("HOST_LINK_RSSI")) : host_cfg.rssi);
+    host_cfg.tx_buffers = (uint16_t)MAX(1, host_env_u32("HOST_LINK_TX_BUFFERS", host_cfg.tx_buffers));
+    host_cfg.rx_buffers = (uint16_t)MAX(1, host_env_u32("HOST_LINK_RX_BUFFERS", host_cfg.rx_buffers));
+    host_cfg.peers = (uint8_t)MAX(1, MIN(host_env_u32("HOST_PEERS", host_cfg.peers), HOST_MAX_CONN));
+    host_cfg.peer_mtu = (uint16_t)MAX(23, MIN(host_env_u32("HOST_PEER_MTU", host_cfg.peer_mtu), HOST_PEER_MAX_MTU));
+    host_cfg.peer_cccd = (uint16_t)host_env_u32("HOST_PEER_CCCD", host_cfg.peer_cccd);
+    host_cfg.peer_writes = (0 != host_env_u32("HOST_PEER_WRITES", 0)) ? WICED_TRUE : WICED_FALSE;
+    host_cfg.peer_reads = (0 != host_env_u32("HOST_PEER_READS", 0)) ? WICED_TRUE : WICED_FALSE;
+    host_cfg.peer_coc = (0 != host_env_u32("HOST_PEER_COC", 0)) ? WICED_TRUE : WICED_FALSE;
+
+    if (NULL != p_phy)
+    {
+        host_cfg.phy_opts = BTM_BLE_PREFER_LELR_125K;
+        if (0 == strcmp(p_phy, "2M"))
+        {
+            host_cfg.phy = HOST_PHY_2M;
+        }
+        else if (0 == strcmp(p_phy, "S2"))
+        {
+            host_cfg.phy = HOST_PHY_CODED;
+            host_cfg.phy_opts = BTM_BLE_PREFER_LELR_512K;
+        }
+        else if (0 == strcmp(p_phy, "S8"))
+        {
+            host_cfg.phy = HOST_PHY_CODED;
+        }
+        else
+        {
+            host_cfg.phy = HOST_PHY_1M;
+        }
+    }
+
+    /* Control value as hex bytes, e.g. "0302" selects the RX direction */
+    while ((NULL != p_control) && (host_cfg.control_len < sizeof(host_cfg.control)) &&
+           (1 == sscanf(p_control, "%2x", &byte)))
+    {
+        host_cfg.control[host_cfg.control_len++] = (uint8_t)byte;
+        p_control += (p_control[1] != '\0') ? 2 : 1;
+    }
+}
+
+/**
+ * Function Name:
+ * host_bt_stack_shutdown
+ *
+ * Function Description:
+ * @brief  Disconnects every peer, disables the stack and waits until the
+ *         application handled the resulting events
+ *
+ * @return void
+ */
+void host_bt_stack_shutdown(void)
+{
+    wiced_bt_management_evt_data_t mgmt = {0};
+
+    pthread_mutex_lock(&host_link_mutex);
+    host_stopping = WICED_TRUE;
+    for (uint8_t i = 0; i < HOST_MAX_CONN; i++)
+    {
+        if (host_conns[i].connected)
+        {
+            host_link_disconnect(&host_conns[i], GATT_CONN_TERMINATE_PEER_USER);
+        }
+    }
+    pthread_cond_broadcast(&host_link_cond);
+    pthread_mutex_unlock(&host_link_mutex);
+
+    host_evt_post_mgmt(BTM_DISABLED_EVT, &mgmt);
+
+    pthread_mutex_lock(&host_evt_mutex);
+    while ((NULL != host_evt_head) || (host_evt_busy))
+    {
+        pthread_cond_wait(&host_evt_cond, &host_evt_mutex);
+    }
+    pthread_mutex_unlock(&host_evt_mutex);
+}
+
+/**
+ * Function Name:
+ * host_bt_stack_print_summary
+ *
+ * Function Description:
+ * @brief  Prints the link settings and the data each peer received and sent
+ *
+ * @param run_ms     length of the run
+ *
+ * @return uint64_t  bytes received and sent by all peers
+ */
+uint64_t host_bt_stack_print_summary(uint32_t run_ms)
+{
+    uint64_t total = 0, bytes, connected_ms;
+    host_conn_t *p_conn;
+
+    printf("\nVirtual link: interval %s, PHY %s, PDU %d bytes, %d packets per event, %d TX buffers\n",
+           (0 != host_cfg.interval) ? "forced" : "as requested",
+           (0 != host_cfg.phy) ? "forced" : "as requested", host_cfg.pdu_size, host_cfg.packets_per_event,
+           host_cfg.tx_buffers);
+    for (uint8_t i = 0; i < HOST_MAX_CONN; i++)
+    {
+        p_conn = &host_conns[i];
+        if (!p_conn->in_use)
+        {
+            continue;
+        }
+        bytes = p_conn->notified + p_conn->indicated + p_conn->read + p_conn->written + p_conn->coc;
+        connected_ms = MAX(1, ((0 != p_conn->down_ns) ? p_conn->down_ns : host_rtos_now_ns()) - p_conn->up_ns) /
+                       1000000u;
+        printf("Peer %d: interval %.2f ms, PHY %s, PDU %d, MTU %d, %llu events, %llu exchanges\n",
+               p_conn->conn_id, p_conn->interval * 1.25, host_link_phy_name(p_conn), p_conn->tx_octets,
+               p_conn->mtu, (unsigned long long)p_conn->events, (unsigned long long)p_conn->pdus);
+        printf("Peer %d: notified %llu, indicated %llu, read %llu, written %llu, CoC %llu bytes, %llu kbps\n",
+               p_conn->conn_id, (unsigned long long)p_conn->notified, (unsigned long long)p_conn->indicated,
+               (unsigned long long)p_conn->read, (unsigned long long)p_conn->written,
+               (unsigned long long)p_conn->coc, (unsigned long long)((bytes * 8u) / connected_ms));
+        total += bytes;
+    }
+    printf("Total: %llu bytes in %lu ms, %llu kbps\n", (unsigned long long)total, (unsigned long)run_ms,
+           (unsigned long long)((total * 8u) / MAX(1, run_ms)));
+    return total;
+}
+
+
+/* [] END OF FILE */
@@ -0,0 +1,298 @@
+/******************************************************************************
+* File Name:   host_hal.c
+*
+* Description: Board support, retarget-io and HAL timer for the host build.
+*              A timer runs as a thread raising the terminal count event every
+*              period while started.
+*
+* Related Document: See README.md
+*
+********************************************************************************
+* Copyright 2021-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/******************************************************************************
+ *                                INCLUDES
+ ******************************************************************************/
+#include <stdio.h>
+#include <time.h>
+#include <errno.h>
+#include "cybsp.h"
+#include "cyhal.h"
+#include "cy_retarget_io.h"
+#include "host.h"
+
+/******************************************************************************
+ *                                Variables
+ ******************************************************************************/
+uint32_t SystemCoreClock = 1000000000u;
+
+/******************************************************************************
+ *                          Function Definitions
+ ******************************************************************************/
+
+/**
+ * Function Name:
+ * cybsp_init
+ *
+ * Function Description:
+ * @brief  Nothing to initialize on the host
+ *
+ * @return cy_rslt_t CY_RSLT_SUCCESS
+ */
+cy_rslt_t cybsp_init(void)
+{
+    return CY_RSLT_SUCCESS;
+}
+
+/**
+ * Function Name:
+ * __enable_irq
+ *
+ * Function Description:
+ * @brief  Nothing to enable on the host
+ *
+ * @return void
+ */
+void __enable_irq(void)
+{
+}
+
+/**
+ * Function Name:
+ * cy_retarget_io_init
+ *
+ * Function Description:
+ * @brief  Makes stdout line buffered so that the reports of the threads do
+ *         not interleave mid-line
+ *
+ * @return cy_rslt_t CY_RSLT_SUCCESS
+ */
+cy_rslt_t cy_retarget_io_init(cyhal_gpio_t tx, cyhal_gpio_t rx, uint32_t baudrate)
+{
+    setvbuf(stdout, NULL, _IOLBF, 0);
+    return CY_RSLT_SUCCESS;
+}
+
+/**
+ * Function Name:
+ * cyhal_timer_thread
+ *
+ * Function Description:
+ * @brief  Raises the terminal count event of a timer every period while the
+ *         timer is started. Periods are scheduled on absolute times so that
+ *         the callback run time does not add up.
+ *
+ * @param p_arg      timer object
+ *
+ * @return void*     never returns
+ */
+static void *cyhal_timer_thread(void *p_arg)
+{
+    cyhal_timer_t *obj = (cyhal_timer_t *)p_arg;
+    struct timespec next;
+    uint64_t period_ns;
+    bool fire;
+
+    pthread_mutex_lock(&obj->mutex);
+    while (true)
+    {
+        while (!obj->running)
+        {
+            pthread_cond_wait(&obj->cond, &obj->mutex);
+        }
+        period_ns = ((uint64_t)obj->cfg.period * 1000000000u) / obj->frequency;
+        clock_gettime(CLOCK_MONOTONIC, &next);
+        while (obj->running)
+        {
+            next.tv_nsec += (long)(period_ns % 1000000000u);
+            next.tv_sec += (time_t)(period_ns / 1000000000u);
+            if (next.tv_nsec >= 1000000000L)
+            {
+                next.tv_sec++;
+                next.tv_nsec -= 1000000000L;
+            }
+            while ((obj->running) && (ETIMEDOUT != pthread_cond_timedwait(&obj->cond, &obj->mutex, &next)))
+            {
+            }
+            fire = obj->running && (NULL != obj->callback) && (obj->events & CYHAL_TIMER_IRQ_TERMINAL_COUNT);
+            if (fire)
+            {
+                pthread_mutex_unlock(&obj->mutex);
+                obj->callback(obj->callback_arg, CYHAL_TIMER_IRQ_TERMINAL_COUNT);
+                pthread_mutex_lock(&obj->mutex);
+            }
+            if (!obj->cfg.is_continuous)
+            {
+                obj->running = false;
+            }
+        }
+    }
+    return NULL;
+}
+
+/**
+ * Function Name:
+ * cyhal_timer_init
+ *
+ * Function Description:
+ * @brief  Initializes a stopped timer and its thread
+ *
+ * @return cy_rslt_t CY_RSLT_SUCCESS
+ */
+cy_rslt_t cyhal_timer_init(cyhal_timer_t *obj, cyhal_gpio_t pin, const void *clk)
+{
+    pthread_condattr_t attr;
+
+    pthread_mutex_init(&obj->mutex, NULL);
+    pthread_condattr_init(&attr);
+    pthread_condattr_setclock(&attr, CLOCK_MONOTONIC);
+    pthread_cond_init(&obj->cond, &attr);
+    pthread_condattr_destroy(&attr);
+    obj->frequency = 1000000u;
+    obj->cfg.period = 1000000u;
+    obj->cfg.is_continuous = true;
+    obj->callback = NULL;
+    obj->events = CYHAL_TIMER_IRQ_NONE;
+    obj->running = false;
+    return (0 == pthread_create(&obj->thread, NULL, cyhal_timer_thread, obj)) ? CY_RSLT_SUCCESS :
+                                                                              CY_RTOS_GENERAL_ERROR;
+}
+
+/**
+ * Function Name:
+ * cyhal_timer_configure
+ *
+ * Function Description:
+ * @brief  Sets the period of a timer, in counts of the timer frequency
+ *
+ * @return cy_rslt_t CY_RSLT_SUCCESS
+ */
+cy_rslt_t cyhal_timer_configure(cyhal_timer_t *obj, const cyhal_timer_cfg_t *cfg)
+{
+    pthread_mutex_lock(&obj->mutex);
+    obj->cfg = *cfg;
+    pthread_mutex_unlock(&obj->mutex);
+    return CY_RSLT_SUCCESS;
+}
+
+/**
+ * Function Name:
+ * cyhal_timer_set_frequency
+ *
+ * Function Description:
+ * @brief  Sets the counting frequency of a timer
+ *
+ * @return cy_rslt_t CY_RSLT_SUCCESS
+ */
+cy_rslt_t cyhal_timer_set_frequency(cyhal_timer_t *obj, uint32_t hz)
+{
+    pthread_mutex_lock(&obj->mutex);
+    obj->frequency = (0 != hz) ? hz : 1u;
+    pthread_mutex_unlock(&obj->mutex);
+    return CY_RSLT_SUCCESS;
+}
+
+/**
+ * Function Name:
+ * cyhal_timer_register_callback
+ *
+ * Function Description:
+ * @brief  Sets the function called on the timer events
+ *
+ * @return void
+ */
+void cyhal_timer_register_callback(cyhal_timer_t *obj, cyhal_timer_event_callback_t callback,
+                                   void *callback_arg)
+{
+    pthread_mutex_lock(&obj->mutex);
+    obj->callback = callback;
+    obj->callback_arg = callback_arg;
+    pthread_mutex_unlock(&obj->mutex);
+}
+
+/**
+ * Function Name:
+ * cyhal_timer_enable_event
+ *
+ * Function Description:
+ * @brief  Enables or disables timer events, the priority is ignored
+ *
+ * @return void
+ */
+void cyhal_timer_enable_event(cyhal_timer_t *obj, cyhal_timer_event_t event, uint8_t intr_priority,
+                              bool enable)
+{
+    pthread_mutex_lock(&obj->mutex);
+    obj->events = enable ? (cyhal_timer_event_t)(obj->events | event) :
+                           (cyhal_timer_event_t)(obj->events & ~event);
+    pthread_mutex_unlock(&obj->mutex);
+}
+
+/**
+ * Function Name:
+ * cyhal_timer_start
+ *
+ * Function Description:
+ * @brief  Starts a timer, a running timer keeps its period
+ *
+ * @return cy_rslt_t CY_RSLT_SUCCESS
+ */
+cy_rslt_t cyhal_timer_start(cyhal_timer_t *obj)
+{
+    pthread_mutex_lock(&obj->mutex);
+    obj->running = true;
+    pthread_cond_broadcast(&obj->cond);
+    pthread_mutex_unlock(&obj->mutex);
+    return CY_RSLT_SUCCESS;
+}
+
+/**
+ * Function Name:
+ * cyhal_timer_stop
+ *
+ * Function Description:
+ * @brief  Stops a timer
+ *
+ * @return cy_rslt_t CY_RSLT_SUCCESS
+ */
+cy_rslt_t cyhal_timer_stop(cyhal_timer_t *obj)
+{
+    pthread_mutex_lock(&obj->mutex);
+    obj->running = false;
+    pthread_cond_broadcast(&obj->cond);
+    pthread_mutex_unlock(&obj->mutex);
+    return CY_RSLT_SUCCESS;
+}
+
+
+/* [] END OF FILE */
@@ -0,0 +1,176 @@
+/******************************************************************************
+* File Name:   host_main.c
+*
+* Description: Entry point of the host build. Configures the virtual link, runs
+*              the application for HOST_RUN_SECONDS and prints the throughput
+*              of each peer and the CPU cost per byte moved.
+*
+* Related Document: See README.md
+*
+********************************************************************************
+* Copyright 2021-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/******************************************************************************
+ *                                INCLUDES
+ ******************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include "cyabs_rtos.h"
+#include "app_tput_payload.h"
+#include "host.h"
+
+/******************************************************************************
+ *                                Constants
+ ******************************************************************************/
+#define HOST_RUN_SECONDS_DEFAULT                (10)
+
+/****************************************************************************
+ *                              FUNCTION DECLARATIONS
+ ***************************************************************************/
+/* main() of the application, renamed by the host Makefile */
+int app_main(void);
+
+/******************************************************************************
+ *                          Function Definitions
+ ******************************************************************************/
+
+/**
+ * Function Name:
+ * host_env_u32
+ *
+ * Function Description:
+ * @brief  Reads an unsigned integer setting from the environment, decimal or
+ *         0x prefixed hex
+ *
+ * @param p_name     variable name
+ * @param dflt       value when unset or not a number
+ *
+ * @return uint32_t  the setting
+ */
+uint32_t host_env_u32(const char *p_name, uint32_t dflt)
+{
+    const char *p_value = getenv(p_name);
+    char *p_end;
+    unsigned long value;
+
+    if ((NULL == p_value) || ('\0' == *p_value))
+    {
+        return dflt;
+    }
+    value = strtoul(p_value, &p_end, 0);
+    if ('\0' != *p_end)
+    {
+        printf("Host: ignoring %s=%s\n", p_name, p_value);
+        return dflt;
+    }
+    return (uint32_t)value;
+}
+
+/**
+ * Function Name:
+ * host_load_payload_file
+ *
+ * Function Description:
+ * @brief  Registers the file named by HOST_PAYLOAD_FILE, for example a
+ *         capture of real traffic, as the data of APP_TPUT_PAYLOAD_REPLAY
+ *
+ * @return void
+ */
+static void host_load_payload_file(void)
+{
+    const char *p_path = getenv("HOST_PAYLOAD_FILE");
+    FILE *p_file;
+    uint8_t *p_data;
+    long len;
+
+    if ((NULL == p_path) || ('\0' == *p_path))
+    {
+        return;
+    }
+    p_file = fopen(p_path, "rb");
+    if (NULL == p_file)
+    {
+        printf("Host: cannot open HOST_PAYLOAD_FILE %s\n", p_path);
+        return;
+    }
+    if ((0 != fseek(p_file, 0, SEEK_END)) || ((len = ftell(p_file)) <= 0) ||
+        (0 != fseek(p_file, 0, SEEK_SET)))
+    {
+        printf("Host: HOST_PAYLOAD_FILE %s is empty\n", p_path);
+        fclose(p_file);
+        return;
+    }
+    /* Kept for the whole run, as app_tput_payload_set_replay() requires */
+    p_data = malloc((size_t)len);
+    if ((NULL == p_data) || (fread(p_data, 1, (size_t)len, p_file) != (size_t)len))
+    {
+        printf("Host: failed to read HOST_PAYLOAD_FILE %s\n", p_path);
+        free(p_data);
+        fclose(p_file);
+        return;
+    }
+    fclose(p_file);
+    app_tput_payload_set_replay(p_data, (uint32_t)len);
+    printf("Host: replay payload of %ld bytes from %s\n", len, p_path);
+}
+
+/**
+ * Function Name:
+ * main
+ *
+ * Function Description:
+ * @brief  Runs the application against the virtual link, then disconnects
+ *         the peers and prints the summary
+ *
+ * @return int       exit status
+ */
+int main(void)
+{
+    uint32_t run_ms = host_env_u32("HOST_RUN_SECONDS", HOST_RUN_SECONDS_DEFAULT) * 1000u;
+    uint64_t start_ns, bytes;
+
+    host_bt_stack_configure();
+    host_load_payload_file();
+
+    start_ns = host_rtos_now_ns();
+    (void)app_main();
+    cy_rtos_delay_milliseconds(run_ms);
+
+    host_bt_stack_shutdown();
+    bytes = host_bt_stack_print_summary((uint32_t)((host_rtos_now_ns() - start_ns) / 1000000u));
+    host_rtos_print_cpu(bytes);
+    return 0;
+}
+
+
+/* [] END OF FILE */
@@ -0,0 +1,600 @@
+/******************************************************************************
+* File Name:   host_rtos.c
+*
+* Description: RTOS abstraction on pthreads for the host build. Each thread
+*              carries a binary notification, event groups and queues are a
+*              mutex and a condition variable, and the CPU time of every
+*              thread is kept for the cost summary printed on exit.
+*
+* Related Document: See README.md
+*
+********************************************************************************
+* Copyright 2021-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/******************************************************************************
+ *                                INCLUDES
+ ******************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <time.h>
+#include "cyabs_rtos.h"
+#include "host.h"
+
+/******************************************************************************
+ *                                Structures
+ ******************************************************************************/
+struct host_thread
+{
+    pthread_t            tid;
+    pthread_mutex_t      mutex;
+    pthread_cond_t       cond;
+    bool                 notified;
+    bool                 exited;
+    uint64_t             cpu_ns;        /* CPU time, set when the thread exits */
+    cy_thread_entry_fn_t entry;
+    cy_thread_arg_t      arg;
+    char                 name[32];
+};
+
+/******************************************************************************
+ *                                Variables
+ ******************************************************************************/
+static struct host_thread host_threads[HOST_MAX_THREADS];
+static uint8_t host_thread_count;
+static pthread_mutex_t host_threads_mutex = PTHREAD_MUTEX_INITIALIZER;
+static __thread struct host_thread *host_current;
+static uint64_t host_start_ns;
+
+/******************************************************************************
+ *                          Function Definitions
+ ******************************************************************************/
+
+/**
+ * Function Name:
+ * host_rtos_now_ns
+ *
+ * Function Description:
+ * @brief  Returns the monotonic time in nanoseconds
+ *
+ * @return uint64_t  nanoseconds
+ */
+uint64_t host_rtos_now_ns(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ((uint64_t)ts.tv_sec * 1000000000u) + (uint64_t)ts.tv_nsec;
+}
+
+/**
+ * Function Name:
+ * host_rtos_deadline
+ *
+ * Function Description:
+ * @brief  Converts a timeout in milliseconds into an absolute monotonic time
+ *         for pthread_cond_timedwait
+ *
+ * @param timeout_ms  timeout in milliseconds
+ * @param p_ts        absolute time, returned
+ *
+ * @return void
+ */
+static void host_rtos_deadline(cy_time_t timeout_ms, struct timespec *p_ts)
+{
+    clock_gettime(CLOCK_MONOTONIC, p_ts);
+    p_ts->tv_sec += timeout_ms / 1000u;
+    p_ts->tv_nsec += (long)(timeout_ms % 1000u) * 1000000L;
+    if (p_ts->tv_nsec >= 1000000000L)
+    {
+        p_ts->tv_sec++;
+        p_ts->tv_nsec -= 1000000000L;
+    }
+}
+
+/**
+ * Function Name:
+ * host_rtos_cond_init
+ *
+ * Function Description:
+ * @brief  Initializes a mutex and a condition variable timed on the
+ *         monotonic clock
+ *
+ * @param p_mutex    mutex
+ * @param p_cond     condition variable
+ *
+ * @return void
+ */
+static void host_rtos_cond_init(pthread_mutex_t *p_mutex, pthread_cond_t *p_cond)
+{
+    pthread_condattr_t attr;
+
+    pthread_mutex_init(p_mutex, NULL);
+    pthread_condattr_init(&attr);
+    pthread_condattr_setclock(&attr, CLOCK_MONOTONIC);
+    pthread_cond_init(p_cond, &attr);
+    pthread_condattr_destroy(&attr);
+}
+
+/**
+ * Function Name:
+ * host_rtos_cond_wait
+ *
+ * Function Description:
+ * @brief  Waits on a condition variable with the mutex held
+ *
+ * @param p_mutex    mutex, held
+ * @param p_cond     condition variable
+ * @param p_deadline absolute timeout, NULL to wait forever
+ *
+ * @return bool      false on timeout
+ */
+static bool host_rtos_cond_wait(pthread_mutex_t *p_mutex, pthread_cond_t *p_cond,
+                                const struct timespec *p_deadline)
+{
+    if (NULL == p_deadline)
+    {
+        pthread_cond_wait(p_cond, p_mutex);
+        return true;
+    }
+    return (ETIMEDOUT != pthread_cond_timedwait(p_cond, p_mutex, p_deadline));
+}
+
+/**
+ * Function Name:
+ * host_rtos_thread_cpu_ns
+ *
+ * Function Description:
+ * @brief  Returns the CPU time a thread used so far
+ *
+ * @param p_thread   thread
+ *
+ * @return uint64_t  nanoseconds
+ */
+static uint64_t host_rtos_thread_cpu_ns(struct host_thread *p_thread)
+{
+    clockid_t clock;
+    struct timespec ts;
+
+    if (p_thread->exited)
+    {
+        return p_thread->cpu_ns;
+    }
+    if ((0 != pthread_getcpuclockid(p_thread->tid, &clock)) || (0 != clock_gettime(clock, &ts)))
+    {
+        return 0;
+    }
+    return ((uint64_t)ts.tv_sec * 1000000000u) + (uint64_t)ts.tv_nsec;
+}
+
+/**
+ * Function Name:
+ * host_rtos_thread_main
+ *
+ * Function Description:
+ * @brief  Entry of every host thread, runs the RTOS thread function
+ *
+ * @param p_arg      the host thread
+ *
+ * @return void*     NULL
+ */
+static void *host_rtos_thread_main(void *p_arg)
+{
+    host_current = (struct host_thread *)p_arg;
+    host_current->entry(host_current->arg);
+    return NULL;
+}
+
+/**
+ * Function Name:
+ * cy_rtos_thread_create
+ *
+ * Function Description:
+ * @brief  Creates a thread. The stack and priority are ignored on the host.
+ *
+ * @return cy_rslt_t CY_RTOS_NO_MEMORY when HOST_MAX_THREADS are running
+ */
+cy_rslt_t cy_rtos_thread_create(cy_thread_t *thread, cy_thread_entry_fn_t entry_function,
+                                const char *name, void *stack, uint32_t stack_size,
+                                cy_thread_priority_t priority, cy_thread_arg_t arg)
+{
+    struct host_thread *p_thread;
+
+    pthread_mutex_lock(&host_threads_mutex);
+    if (0 == host_start_ns)
+    {
+        host_start_ns = host_rtos_now_ns();
+    }
+    if (host_thread_count >= HOST_MAX_THREADS)
+    {
+        pthread_mutex_unlock(&host_threads_mutex);
+        return CY_RTOS_NO_MEMORY;
+    }
+    p_thread = &host_threads[host_thread_count++];
+    pthread_mutex_unlock(&host_threads_mutex);
+
+    host_rtos_cond_init(&p_thread->mutex, &p_thread->cond);
+    p_thread->entry = entry_function;
+    p_thread->arg = arg;
+    snprintf(p_thread->name, sizeof(p_thread->name), "%s", (NULL != name) ? name : "?");
+    *thread = p_thread;
+    if (0 != pthread_create(&p_thread->tid, NULL, host_rtos_thread_main, p_thread))
+    {
+        return CY_RTOS_GENERAL_ERROR;
+    }
+    return CY_RSLT_SUCCESS;
+}
+
+/**
+ * Function Name:
+ * cy_rtos_exit_thread
+ *
+ * Function Description:
+ * @brief  Ends the calling thread, keeping its CPU time for the summary
+ *
+ * @return cy_rslt_t does not return for RTOS threads
+ */
+cy_rslt_t cy_rtos_exit_thread(void)
+{
+    if (NULL != host_current)
+    {
+        host_current->cpu_ns = host_rtos_thread_cpu_ns(host_current);
+        host_current->exited = true;
+        pthread_exit(NULL);
+    }
+    return CY_RTOS_GENERAL_ERROR;
+}
+
+/**
+ * Function Name:
+ * cy_rtos_thread_set_notification
+ *
+ * Function Description:
+ * @brief  Wakes up a thread waiting for a notification, or lets its next wait
+ *         return at once
+ *
+ * @return cy_rslt_t CY_RSLT_SUCCESS
+ */
+cy_rslt_t cy_rtos_thread_set_notification(cy_thread_t *thread)
+{
+    struct host_thread *p_thread = *thread;
+
+    if (NULL == p_thread)
+    {
+        return CY_RTOS_BAD_PARAM;
+    }
+    pthread_mutex_lock(&p_thread->mutex);
+    p_thread->notified = true;
+    pthread_cond_signal(&p_thread->cond);
+    pthread_mutex_unlock(&p_thread->mutex);
+    return CY_RSLT_SUCCESS;
+}
+
+/**
+ * Function Name:
+ * cy_rtos_thread_wait_notification
+ *
+ * Function Description:
+ * @brief  Waits for a notification of the calling thread
+ *
+ * @return cy_rslt_t CY_RTOS_TIMEOUT if none arrived in time
+ */
+cy_rslt_t cy_rtos_thread_wait_notification(cy_time_t timeout_ms)
+{
+    struct host_thread *p_thread = host_current;
+    struct timespec deadline;
+    bool in_time = true;
+
+    if (NULL == p_thread)
+    {
+        return CY_RTOS_BAD_PARAM;
+    }
+    host_rtos_deadline(timeout_ms, &deadline);
+    pthread_mutex_lock(&p_thread->mutex);
+    while ((!p_thread->notified) && (in_time))
+    {
+        in_time = host_rtos_cond_wait(&p_thread->mutex, &p_thread->cond,
+                                      (CY_RTOS_NEVER_TIMEOUT == timeout_ms) ? NULL : &deadline);
+    }
+    in_time = p_thread->notified;
+    p_thread->notified = false;
+    pthread_mutex_unlock(&p_thread->mutex);
+    return in_time ? CY_RSLT_SUCCESS : CY_RTOS_TIMEOUT;
+}
+
+/**
+ * Function Name:
+ * cy_rtos_delay_milliseconds
+ *
+ * Function Description:
+ * @brief  Sleeps the calling thread
+ *
+ * @return cy_rslt_t CY_RSLT_SUCCESS
+ */
+cy_rslt_t cy_rtos_delay_milliseconds(cy_time_t num_ms)
+{
+    struct timespec ts = { .tv_sec = num_ms / 1000u, .tv_nsec = (long)(num_ms % 1000u) * 1000000L };
+
+    while (0 != nanosleep(&ts, &ts))
+    {
+    }
+    return CY_RSLT_SUCCESS;
+}
+
+/**
+ * Function Name:
+ * cy_rtos_get_time
+ *
+ * Function Description:
+ * @brief  Returns the milliseconds since the first thread was created
+ *
+ * @return cy_rslt_t CY_RSLT_SUCCESS
+ */
+cy_rslt_t cy_rtos_get_time(cy_time_t *tval)
+{
+    *tval = (cy_time_t)((host_rtos_now_ns() - host_start_ns) / 1000000u);
+    return CY_RSLT_SUCCESS;
+}
+
+/**
+ * Function Name:
+ * cy_rtos_event_init
+ *
+ * Function Description:
+ * @brief  Initializes an event group with every bit clear
+ *
+ * @return cy_rslt_t CY_RSLT_SUCCESS
+ */
+cy_rslt_t cy_rtos_event_init(cy_event_t *event)
+{
+    host_rtos_cond_init(&event->mutex, &event->cond);
+    event->bits = 0;
+    return CY_RSLT_SUCCESS;
+}
+
+/**
+ * Function Name:
+ * cy_rtos_event_setbits
+ *
+ * Function Description:
+ * @brief  Sets bits of an event group and wakes up its waiters
+ *
+ * @return cy_rslt_t CY_RSLT_SUCCESS
+ */
+cy_rslt_t cy_rtos_event_setbits(cy_event_t *event, uint32_t bits)
+{
+    pthread_mutex_lock(&event->mutex);
+    event->bits |= bits;
+    pthread_cond_broadcast(&event->cond);
+    pthread_mutex_unlock(&event->mutex);
+    return CY_RSLT_SUCCESS;
+}
+
+/**
+ * Function Name:
+ * cy_rtos_event_clearbits
+ *
+ * Function Description:
+ * @brief  Clears bits of an event group
+ *
+ * @return cy_rslt_t CY_RSLT_SUCCESS
+ */
+cy_rslt_t cy_rtos_event_clearbits(cy_event_t *event, uint32_t bits)
+{
+    pthread_mutex_lock(&event->mutex);
+    event->bits &= ~bits;
+    pthread_mutex_unlock(&event->mutex);
+    return CY_RSLT_SUCCESS;
+}
+
+/**
+ * Function Name:
+ * cy_rtos_event_getbits
+ *
+ * Function Description:
+ * @brief  Reads the bits of an event group
+ *
+ * @return cy_rslt_t CY_RSLT_SUCCESS
+ */
+cy_rslt_t cy_rtos_event_getbits(cy_event_t *event, uint32_t *bits)
+{
+    pthread_mutex_lock(&event->mutex);
+    *bits = event->bits;
+    pthread_mutex_unlock(&event->mutex);
+    return CY_RSLT_SUCCESS;
+}
+
+/**
+ * Function Name:
+ * cy_rtos_event_waitbits
+ *
+ * Function Description:
+ * @brief  Waits until any, or all, of the requested bits are set
+ *
+ * @param bits       requested bits, returns the bits set when the wait ended
+ * @param clear      clear the requested bits on return
+ * @param all        wait for all of the requested bits
+ *
+ * @return cy_rslt_t CY_RTOS_TIMEOUT if the bits were not set in time
+ */
+cy_rslt_t cy_rtos_event_waitbits(cy_event_t *event, uint32_t *bits, bool clear, bool all,
+                                 cy_time_t timeout)
+{
+    struct timespec deadline;
+    uint32_t wanted = *bits;
+    bool done = false;
+    bool in_time = true;
+
+    host_rtos_deadline(timeout, &deadline);
+    pthread_mutex_lock(&event->mutex);
+    while (true)
+    {
+        done = all ? ((event->bits & wanted) == wanted) : (0 != (event->bits & wanted));
+        if ((done) || (!in_time))
+        {
+            break;
+        }
+        in_time = host_rtos_cond_wait(&event->mutex, &event->cond,
+                                      (CY_RTOS_NEVER_TIMEOUT == timeout) ? NULL : &deadline);
+    }
+    *bits = event->bits;
+    if ((done) && (clear))
+    {
+        event->bits &= ~wanted;
+    }
+    pthread_mutex_unlock(&event->mutex);
+    return done ? CY_RSLT_SUCCESS : CY_RTOS_TIMEOUT;
+}
+
+/**
+ * Function Name:
+ * cy_rtos_queue_init
+ *
+ * Function Description:
+ * @brief  Initializes a queue of length items of itemsize bytes
+ *
+ * @return cy_rslt_t CY_RTOS_NO_MEMORY if the items cannot be allocated
+ */
+cy_rslt_t cy_rtos_queue_init(cy_queue_t *queue, size_t length, size_t itemsize)
+{
+    host_rtos_cond_init(&queue->mutex, &queue->cond);
+    queue->p_items = (uint8_t *)calloc(length, itemsize);
+    queue->length = length;
+    queue->itemsize = itemsize;
+    queue->head = 0;
+    queue->count = 0;
+    return (NULL != queue->p_items) ? CY_RSLT_SUCCESS : CY_RTOS_NO_MEMORY;
+}
+
+/**
+ * Function Name:
+ * cy_rtos_queue_put
+ *
+ * Function Description:
+ * @brief  Appends an item, waiting for room up to the timeout
+ *
+ * @return cy_rslt_t CY_RTOS_QUEUE_FULL if there was no room in time
+ */
+cy_rslt_t cy_rtos_queue_put(cy_queue_t *queue, const void *item_ptr, cy_time_t timeout_ms)
+{
+    struct timespec deadline;
+    bool in_time = (0 != timeout_ms);
+
+    host_rtos_deadline(timeout_ms, &deadline);
+    pthread_mutex_lock(&queue->mutex);
+    while ((queue->count == queue->length) && (in_time))
+    {
+        in_time = host_rtos_cond_wait(&queue->mutex, &queue->cond,
+                                      (CY_RTOS_NEVER_TIMEOUT == timeout_ms) ? NULL : &deadline);
+    }
+    if (queue->count == queue->length)
+    {
+        pthread_mutex_unlock(&queue->mutex);
+        return CY_RTOS_QUEUE_FULL;
+    }
+    memcpy(&queue->p_items[((queue->head + queue->count) % queue->length) * queue->itemsize],
+           item_ptr, queue->itemsize);
+    queue->count++;
+    pthread_cond_broadcast(&queue->cond);
+    pthread_mutex_unlock(&queue->mutex);
+    return CY_RSLT_SUCCESS;
+}
+
+/**
+ * Function Name:
+ * cy_rtos_queue_get
+ *
+ * Function Description:
+ * @brief  Removes the oldest item, waiting for one up to the timeout
+ *
+ * @return cy_rslt_t CY_RTOS_QUEUE_EMPTY if no item arrived in time
+ */
+cy_rslt_t cy_rtos_queue_get(cy_queue_t *queue, void *item_ptr, cy_time_t timeout_ms)
+{
+    struct timespec deadline;
+    bool in_time = (0 != timeout_ms);
+
+    host_rtos_deadline(timeout_ms, &deadline);
+    pthread_mutex_lock(&queue->mutex);
+    while ((0 == queue->count) && (in_time))
+    {
+        in_time = host_rtos_cond_wait(&queue->mutex, &queue->cond,
+                                      (CY_RTOS_NEVER_TIMEOUT == timeout_ms) ? NULL : &deadline);
+    }
+    if (0 == queue->count)
+    {
+        pthread_mutex_unlock(&queue->mutex);
+        return CY_RTOS_QUEUE_EMPTY;
+    }
+    memcpy(item_ptr, &queue->p_items[queue->head * queue->itemsize], queue->itemsize);
+    queue->head = (queue->head + 1) % queue->length;
+    queue->count--;
+    pthread_cond_broadcast(&queue->cond);
+    pthread_mutex_unlock(&queue->mutex);
+    return CY_RSLT_SUCCESS;
+}
+
+/**
+ * Function Name:
+ * host_rtos_print_cpu
+ *
+ * Function Description:
+ * @brief  Prints the CPU time of every thread and of the whole process, and
+ *         the process CPU time per byte moved over the virtual link
+ *
+ * @param bytes      bytes the virtual peers received and sent
+ *
+ * @return void
+ */
+void host_rtos_print_cpu(uint64_t bytes)
+{
+    struct timespec ts;
+    uint64_t process_ns;
+    uint64_t thread_ns;
+
+    printf("CPU time per thread:\n");
+    for (uint8_t i = 0; i < host_thread_count; i++)
+    {
+        thread_ns = host_rtos_thread_cpu_ns(&host_threads[i]);
+        printf("  %-20s %8.1f ms  %7.1f ns/byte\n", host_threads[i].name, (double)thread_ns / 1e6,
+               (0 != bytes) ? (double)thread_ns / (double)bytes : 0.0);
+    }
+    clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &ts);
+    process_ns = ((uint64_t)ts.tv_sec * 1000000000u) + (uint64_t)ts.tv_nsec;
+    printf("  %-20s %8.1f ms  %7.1f ns/byte\n", "process", (double)process_ns / 1e6,
+           (0 != bytes) ? (double)process_ns / (double)bytes : 0.0);
+}
+
+
+/* [] END OF FILE */
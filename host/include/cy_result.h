@@ -0,0 +1,64 @@
+/******************************************************************************
+* File Name:   cy_result.h
+*
+* Description: Host build stand-in for the result type of the Cypress
+*              libraries.
+*
+* Related Document: See README.md
+*
+********************************************************************************
+* Copyright 2021-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef __CY_RESULT_H__
+#define __CY_RESULT_H__
+
+/******************************************************************************
+ *                                INCLUDES
+ ******************************************************************************/
+#include <stdint.h>
+
+/******************************************************************************
+ *                                Constants
+ ******************************************************************************/
+typedef uint32_t cy_rslt_t;
+
+#define CY_RSLT_SUCCESS                         ((cy_rslt_t)0x00000000U)
+#define CY_RSLT_TYPE_ERROR                      (2U)
+#define CY_RSLT_CREATE(type, module, code)      ((cy_rslt_t)((((uint32_t)(module) & 0x3FFFU) << 18) | \
+                                                             (((uint32_t)(code) & 0xFFFFU) << 0) | \
+                                                             (((uint32_t)(type) & 0x3U) << 16)))
+
+#endif      /* __CY_RESULT_H__ */
+
+
+/* [] END OF FILE */
@@ -0,0 +1,134 @@
+/******************************************************************************
+* File Name:   cyabs_rtos.h
+*
+* Description: Host build stand-in for the RTOS abstraction layer. Threads,
+*              notifications, event groups and queues map onto pthreads in
+*              host/host_rtos.c; time is the monotonic clock in milliseconds.
+*
+* Related Document: See README.md
+*
+********************************************************************************
+* Copyright 2021-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef __CYABS_RTOS_H__
+#define __CYABS_RTOS_H__
+
+/******************************************************************************
+ *                                INCLUDES
+ ******************************************************************************/
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <pthread.h>
+#include "cy_result.h"
+
+/******************************************************************************
+ *                                Constants
+ ******************************************************************************/
+#define CY_RTOS_NEVER_TIMEOUT                   (0xFFFFFFFFUL)
+
+#define CY_RTOS_TIMEOUT                         CY_RSLT_CREATE(CY_RSLT_TYPE_ERROR, 0x0100, 0)
+#define CY_RTOS_NO_MEMORY                       CY_RSLT_CREATE(CY_RSLT_TYPE_ERROR, 0x0100, 1)
+#define CY_RTOS_GENERAL_ERROR                   CY_RSLT_CREATE(CY_RSLT_TYPE_ERROR, 0x0100, 2)
+#define CY_RTOS_BAD_PARAM                       CY_RSLT_CREATE(CY_RSLT_TYPE_ERROR, 0x0100, 5)
+#define CY_RTOS_QUEUE_FULL                      CY_RSLT_CREATE(CY_RSLT_TYPE_ERROR, 0x0100, 7)
+#define CY_RTOS_QUEUE_EMPTY                     CY_RSLT_CREATE(CY_RSLT_TYPE_ERROR, 0x0100, 8)
+
+/* Priorities are accepted and ignored, host threads share the scheduler */
+typedef enum
+{
+    CY_RTOS_PRIORITY_MIN,
+    CY_RTOS_PRIORITY_LOW,
+    CY_RTOS_PRIORITY_BELOWNORMAL,
+    CY_RTOS_PRIORITY_NORMAL,
+    CY_RTOS_PRIORITY_ABOVENORMAL,
+    CY_RTOS_PRIORITY_HIGH,
+    CY_RTOS_PRIORITY_REALTIME,
+    CY_RTOS_PRIORITY_MAX
+} cy_thread_priority_t;
+
+/******************************************************************************
+ *                                Structures
+ ******************************************************************************/
+typedef uint32_t cy_time_t;
+typedef void *cy_thread_arg_t;
+typedef void (*cy_thread_entry_fn_t)(cy_thread_arg_t arg);
+
+/* Thread handle, owned by host_rtos.c */
+typedef struct host_thread *cy_thread_t;
+
+typedef struct
+{
+    pthread_mutex_t mutex;
+    pthread_cond_t  cond;
+    uint32_t        bits;
+} cy_event_t;
+
+typedef struct
+{
+    pthread_mutex_t mutex;
+    pthread_cond_t  cond;
+    uint8_t        *p_items;
+    size_t          length;
+    size_t          itemsize;
+    size_t          head;
+    size_t          count;
+} cy_queue_t;
+
+/****************************************************************************
+ *                              FUNCTION DECLARATIONS
+ ***************************************************************************/
+cy_rslt_t cy_rtos_thread_create(cy_thread_t *thread, cy_thread_entry_fn_t entry_function,
+                                const char *name, void *stack, uint32_t stack_size,
+                                cy_thread_priority_t priority, cy_thread_arg_t arg);
+cy_rslt_t cy_rtos_exit_thread(void);
+cy_rslt_t cy_rtos_thread_set_notification(cy_thread_t *thread);
+cy_rslt_t cy_rtos_thread_wait_notification(cy_time_t timeout_ms);
+cy_rslt_t cy_rtos_delay_milliseconds(cy_time_t num_ms);
+cy_rslt_t cy_rtos_get_time(cy_time_t *tval);
+
+cy_rslt_t cy_rtos_event_init(cy_event_t *event);
+cy_rslt_t cy_rtos_event_setbits(cy_event_t *event, uint32_t bits);
+cy_rslt_t cy_rtos_event_clearbits(cy_event_t *event, uint32_t bits);
+cy_rslt_t cy_rtos_event_getbits(cy_event_t *event, uint32_t *bits);
+cy_rslt_t cy_rtos_event_waitbits(cy_event_t *event, uint32_t *bits, bool clear, bool all,
+                                 cy_time_t timeout);
+
+cy_rslt_t cy_rtos_queue_init(cy_queue_t *queue, size_t length, size_t itemsize);
+cy_rslt_t cy_rtos_queue_put(cy_queue_t *queue, const void *item_ptr, cy_time_t timeout_ms);
+cy_rslt_t cy_rtos_queue_get(cy_queue_t *queue, void *item_ptr, cy_time_t timeout_ms);
+
+#endif      /* __CYABS_RTOS_H__ */
+
+
+/* [] END OF FILE */
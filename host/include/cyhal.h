@@ -0,0 +1,117 @@
+/******************************************************************************
+* File Name:   cyhal.h
+*
+* Description: Host build stand-in for the hardware abstraction layer. Only
+*              the timer is provided, as a periodic thread in host/host_hal.c.
+*
+* Related Document: See README.md
+*
+********************************************************************************
+* Copyright 2021-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef __CYHAL_H__
+#define __CYHAL_H__
+
+/******************************************************************************
+ *                                INCLUDES
+ ******************************************************************************/
+#include <stdint.h>
+#include <stdbool.h>
+#include <pthread.h>
+#include "cy_result.h"
+#include "cyhal_gpio.h"
+
+/******************************************************************************
+ *                                Constants
+ ******************************************************************************/
+typedef enum
+{
+    CYHAL_TIMER_DIR_UP,
+    CYHAL_TIMER_DIR_DOWN,
+    CYHAL_TIMER_DIR_UP_DOWN
+} cyhal_timer_direction_t;
+
+typedef enum
+{
+    CYHAL_TIMER_IRQ_NONE            = 0,
+    CYHAL_TIMER_IRQ_TERMINAL_COUNT  = 1 << 0,
+    CYHAL_TIMER_IRQ_CAPTURE_COMPARE = 1 << 1,
+    CYHAL_TIMER_IRQ_ALL             = (1 << 2) - 1
+} cyhal_timer_event_t;
+
+/******************************************************************************
+ *                                Structures
+ ******************************************************************************/
+typedef struct
+{
+    bool                    is_continuous;
+    cyhal_timer_direction_t direction;
+    bool                    is_compare;
+    uint32_t                period;
+    uint32_t                compare_value;
+    uint32_t                value;
+} cyhal_timer_cfg_t;
+
+typedef void (*cyhal_timer_event_callback_t)(void *callback_arg, cyhal_timer_event_t event);
+
+/* Timer object, the terminal count is raised by a host thread */
+typedef struct
+{
+    pthread_t                    thread;
+    pthread_mutex_t              mutex;
+    pthread_cond_t               cond;
+    cyhal_timer_cfg_t            cfg;
+    uint32_t                     frequency;
+    cyhal_timer_event_callback_t callback;
+    void                        *callback_arg;
+    cyhal_timer_event_t          events;
+    bool                         running;
+} cyhal_timer_t;
+
+/****************************************************************************
+ *                              FUNCTION DECLARATIONS
+ ***************************************************************************/
+cy_rslt_t cyhal_timer_init(cyhal_timer_t *obj, cyhal_gpio_t pin, const void *clk);
+cy_rslt_t cyhal_timer_configure(cyhal_timer_t *obj, const cyhal_timer_cfg_t *cfg);
+cy_rslt_t cyhal_timer_set_frequency(cyhal_timer_t *obj, uint32_t hz);
+void      cyhal_timer_register_callback(cyhal_timer_t *obj, cyhal_timer_event_callback_t callback,
+                                        void *callback_arg);
+void      cyhal_timer_enable_event(cyhal_timer_t *obj, cyhal_timer_event_t event, uint8_t intr_priority,
+                                   bool enable);
+cy_rslt_t cyhal_timer_start(cyhal_timer_t *obj);
+cy_rslt_t cyhal_timer_stop(cyhal_timer_t *obj);
+
+#endif      /* __CYHAL_H__ */
+
+
+/* [] END OF FILE */
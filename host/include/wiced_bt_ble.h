@@ -0,0 +1,112 @@
+/******************************************************************************
+* File Name:   wiced_bt_ble.h
+*
+* Description: Host build stand-in for the AIROC Bluetooth stack LE interface:
+*              advertising, PHY, data length and connection parameters.
+*
+* Related Document: See README.md
+*
+********************************************************************************
+* Copyright 2021-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef __WICED_BT_BLE_H__
+#define __WICED_BT_BLE_H__
+
+/******************************************************************************
+ *                                INCLUDES
+ ******************************************************************************/
+#include "wiced_bt_dev.h"
+
+/******************************************************************************
+ *                                Constants
+ ******************************************************************************/
+/* PHY preferences */
+#define BTM_BLE_PREFER_1M_PHY                   (0x01)
+#define BTM_BLE_PREFER_2M_PHY                   (0x02)
+#define BTM_BLE_PREFER_LELR_PHY                 (0x04)
+
+/* Coded PHY options */
+#define BTM_BLE_PREFER_NO_LELR                  (0x0000)
+#define BTM_BLE_PREFER_LELR_125K                (0x0001)
+#define BTM_BLE_PREFER_LELR_512K                (0x0002)
+
+/******************************************************************************
+ *                                Structures
+ ******************************************************************************/
+typedef uint16_t wiced_bt_ble_lecoc_phy_options_t;
+
+typedef struct
+{
+    wiced_bt_device_address_t             remote_bd_addr;
+    wiced_bt_ble_host_phy_preferences_t   tx_phys;
+    wiced_bt_ble_host_phy_preferences_t   rx_phys;
+    wiced_bt_ble_lecoc_phy_options_t      phy_opts;
+} wiced_bt_ble_phy_preferences_t;
+
+typedef struct
+{
+    uint8_t                               role;
+    uint16_t                              conn_interval;
+    uint16_t                              conn_latency;
+    uint16_t                              supervision_timeout;
+} wiced_bt_ble_conn_params_t;
+
+typedef struct
+{
+    uint8_t                               advert_type;
+    uint8_t                               len;
+    uint8_t                              *p_data;
+} wiced_bt_ble_advert_elem_t;
+
+/****************************************************************************
+ *                              FUNCTION DECLARATIONS
+ ***************************************************************************/
+wiced_result_t        wiced_bt_ble_set_raw_advertisement_data(uint8_t num_elem,
+                                                              wiced_bt_ble_advert_elem_t *p_data);
+wiced_result_t        wiced_bt_start_advertisements(wiced_bt_ble_advert_mode_t advert_mode,
+                                                    wiced_bt_ble_address_type_t directed_advertisement_bdaddr_type,
+                                                    wiced_bt_device_address_t directed_advertisement_bdaddr_ptr);
+wiced_bt_dev_status_t wiced_bt_ble_set_phy(wiced_bt_ble_phy_preferences_t *p_phy_preferences);
+wiced_bt_dev_status_t wiced_bt_ble_set_data_packet_length(wiced_bt_device_address_t bd_addr,
+                                                          uint16_t tx_pdu_length, uint16_t tx_time);
+wiced_bool_t          wiced_bt_ble_get_connection_parameters(wiced_bt_device_address_t remote_bda,
+                                                             wiced_bt_ble_conn_params_t *p_conn_parameters);
+int                   wiced_bt_ble_get_available_tx_buffers(void);
+wiced_bool_t          wiced_bt_l2cap_update_ble_conn_params(wiced_bt_device_address_t rem_bdRa,
+                                                            uint16_t min_int, uint16_t max_int,
+                                                            uint16_t latency, uint16_t timeout);
+
+#endif      /* __WICED_BT_BLE_H__ */
+
+
+/* [] END OF FILE */
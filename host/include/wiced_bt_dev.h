@@ -0,0 +1,184 @@
+/******************************************************************************
+* File Name:   wiced_bt_dev.h
+*
+* Description: Host build stand-in for the AIROC Bluetooth stack device
+*              management interface, implemented by host/host_bt_stack.c.
+*
+* Related Document: See README.md
+*
+********************************************************************************
+* Copyright 2021-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef __WICED_BT_DEV_H__
+#define __WICED_BT_DEV_H__
+
+/******************************************************************************
+ *                                INCLUDES
+ ******************************************************************************/
+#include "wiced_bt_types.h"
+#include "wiced_bt_cfg.h"
+
+/******************************************************************************
+ *                                Enumerations
+ ******************************************************************************/
+typedef enum
+{
+    BTM_ENABLED_EVT,
+    BTM_DISABLED_EVT,
+    BTM_POWER_MANAGEMENT_STATUS_EVT,
+    BTM_PIN_REQUEST_EVT,
+    BTM_USER_CONFIRMATION_REQUEST_EVT,
+    BTM_PASSKEY_NOTIFICATION_EVT,
+    BTM_PASSKEY_REQUEST_EVT,
+    BTM_KEYPRESS_NOTIFICATION_EVT,
+    BTM_PAIRING_IO_CAPABILITIES_BR_EDR_REQUEST_EVT,
+    BTM_PAIRING_IO_CAPABILITIES_BR_EDR_RESPONSE_EVT,
+    BTM_PAIRING_IO_CAPABILITIES_BLE_REQUEST_EVT,
+    BTM_PAIRING_COMPLETE_EVT,
+    BTM_ENCRYPTION_STATUS_EVT,
+    BTM_SECURITY_REQUEST_EVT,
+    BTM_SECURITY_FAILED_EVT,
+    BTM_SECURITY_ABORTED_EVT,
+    BTM_READ_LOCAL_OOB_DATA_COMPLETE_EVT,
+    BTM_REMOTE_OOB_DATA_REQUEST_EVT,
+    BTM_PAIRED_DEVICE_LINK_KEYS_UPDATE_EVT,
+    BTM_PAIRED_DEVICE_LINK_KEYS_REQUEST_EVT,
+    BTM_LOCAL_IDENTITY_KEYS_UPDATE_EVT,
+    BTM_LOCAL_IDENTITY_KEYS_REQUEST_EVT,
+    BTM_BLE_SCAN_STATE_CHANGED_EVT,
+    BTM_BLE_ADVERT_STATE_CHANGED_EVT,
+    BTM_SMP_REMOTE_OOB_DATA_REQUEST_EVT,
+    BTM_SMP_SC_REMOTE_OOB_DATA_REQUEST_EVT,
+    BTM_SMP_SC_LOCAL_OOB_DATA_NOTIFICATION_EVT,
+    BTM_SCO_CONNECTED_EVT,
+    BTM_SCO_DISCONNECTED_EVT,
+    BTM_SCO_CONNECTION_REQUEST_EVT,
+    BTM_SCO_CONNECTION_CHANGE_EVT,
+    BTM_BLE_CONNECTION_PARAM_UPDATE,
+    BTM_BLE_PHY_UPDATE_EVT,
+    BTM_BLE_DATA_LENGTH_UPDATE_EVENT
+} wiced_bt_management_evt_t;
+
+typedef enum
+{
+    BTM_BLE_ADVERT_OFF,
+    BTM_BLE_ADVERT_DIRECTED_HIGH,
+    BTM_BLE_ADVERT_DIRECTED_LOW,
+    BTM_BLE_ADVERT_UNDIRECTED_HIGH,
+    BTM_BLE_ADVERT_UNDIRECTED_LOW,
+    BTM_BLE_ADVERT_NONCONN_HIGH,
+    BTM_BLE_ADVERT_NONCONN_LOW,
+    BTM_BLE_ADVERT_DISCOVERABLE_HIGH,
+    BTM_BLE_ADVERT_DISCOVERABLE_LOW
+} wiced_bt_ble_advert_mode_t;
+
+typedef enum
+{
+    HCI_TRACE_EVENT,
+    HCI_TRACE_COMMAND,
+    HCI_TRACE_INCOMING_ACL_DATA,
+    HCI_TRACE_OUTGOING_ACL_DATA
+} wiced_bt_hci_trace_type_t;
+
+/******************************************************************************
+ *                                Structures
+ ******************************************************************************/
+typedef uint8_t wiced_bt_ble_host_phy_preferences_t;
+
+typedef struct
+{
+    wiced_result_t status;
+} wiced_bt_dev_enabled_t;
+
+typedef struct
+{
+    uint8_t                               status;
+    wiced_bt_device_address_t             bd_address;
+    wiced_bt_ble_host_phy_preferences_t   tx_phy;
+    wiced_bt_ble_host_phy_preferences_t   rx_phy;
+} wiced_bt_ble_phy_update_t;
+
+typedef struct
+{
+    uint8_t                               status;
+    wiced_bt_device_address_t             bd_addr;
+    uint16_t                              conn_interval;
+    uint16_t                              conn_latency;
+    uint16_t                              supervision_timeout;
+} wiced_bt_ble_connection_param_update_t;
+
+typedef struct
+{
+    wiced_bt_device_address_t             bd_address;
+    uint16_t                              max_tx_octets;
+    uint16_t                              max_tx_time;
+    uint16_t                              max_rx_octets;
+    uint16_t                              max_rx_time;
+} wiced_bt_ble_data_length_update_t;
+
+typedef union
+{
+    wiced_bt_dev_enabled_t                 enabled;
+    wiced_bt_ble_phy_update_t              ble_phy_update_event;
+    wiced_bt_ble_connection_param_update_t ble_connection_param_update;
+    wiced_bt_ble_advert_mode_t             ble_advert_state_changed;
+    wiced_bt_ble_data_length_update_t      ble_data_length_update_event;
+} wiced_bt_management_evt_data_t;
+
+typedef struct
+{
+    wiced_result_t                        status;
+    uint8_t                               hci_status;
+    int8_t                                rssi;
+    wiced_bt_device_address_t             rem_bda;
+} wiced_bt_dev_rssi_result_t;
+
+typedef void (wiced_bt_dev_cmpl_cback_t)(void *p_data);
+typedef wiced_result_t (wiced_bt_management_cback_t)(wiced_bt_management_evt_t event,
+                                                     wiced_bt_management_evt_data_t *p_event_data);
+typedef void (wiced_bt_hci_trace_cback_t)(wiced_bt_hci_trace_type_t type, uint16_t length, uint8_t *p_data);
+
+/****************************************************************************
+ *                              FUNCTION DECLARATIONS
+ ***************************************************************************/
+void                  wiced_bt_set_local_bdaddr(wiced_bt_device_address_t bda, wiced_bt_ble_address_type_t addr_type);
+void                  wiced_bt_dev_read_local_addr(wiced_bt_device_address_t bd_addr);
+void                  wiced_bt_set_pairable_mode(uint8_t allow_pairing, uint8_t connect_only_paired);
+wiced_bt_dev_status_t wiced_bt_dev_read_rssi(wiced_bt_device_address_t remote_bda, wiced_bt_transport_t transport,
+                                             wiced_bt_dev_cmpl_cback_t *p_cback);
+void                  wiced_bt_dev_register_hci_trace(wiced_bt_hci_trace_cback_t *p_cback);
+
+#endif      /* __WICED_BT_DEV_H__ */
+
+
+/* [] END OF FILE */
@@ -0,0 +1,359 @@
+/******************************************************************************
+* File Name:   wiced_bt_gatt.h
+*
+* Description: Host build stand-in for the AIROC Bluetooth stack GATT server
+*              interface. The GATT database macros build the attribute layout
+*              that host/host_bt_stack.c walks for read-by-type requests.
+*
+* Related Document: See README.md
+*
+********************************************************************************
+* Copyright 2021-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef __WICED_BT_GATT_H__
+#define __WICED_BT_GATT_H__
+
+/******************************************************************************
+ *                                INCLUDES
+ ******************************************************************************/
+#include "wiced_bt_dev.h"
+#include "wiced_bt_uuid.h"
+
+/******************************************************************************
+ *                                Constants
+ ******************************************************************************/
+/* GATT status, ATT error codes followed by the stack specific ones */
+typedef enum
+{
+    WICED_BT_GATT_SUCCESS                   = 0x00,
+    WICED_BT_GATT_INVALID_HANDLE            = 0x01,
+    WICED_BT_GATT_READ_NOT_PERMIT           = 0x02,
+    WICED_BT_GATT_WRITE_NOT_PERMIT          = 0x03,
+    WICED_BT_GATT_INVALID_PDU               = 0x04,
+    WICED_BT_GATT_INSUF_AUTHENTICATION      = 0x05,
+    WICED_BT_GATT_REQ_NOT_SUPPORTED         = 0x06,
+    WICED_BT_GATT_INVALID_OFFSET            = 0x07,
+    WICED_BT_GATT_INSUF_AUTHORIZATION       = 0x08,
+    WICED_BT_GATT_PREPARE_Q_FULL            = 0x09,
+    WICED_BT_GATT_ATTRIBUTE_NOT_FOUND       = 0x0A,
+    WICED_BT_GATT_NOT_LONG                  = 0x0B,
+    WICED_BT_GATT_INSUF_KEY_SIZE            = 0x0C,
+    WICED_BT_GATT_INVALID_ATTR_LEN          = 0x0D,
+    WICED_BT_GATT_ERR_UNLIKELY              = 0x0E,
+    WICED_BT_GATT_INSUF_ENCRYPTION          = 0x0F,
+    WICED_BT_GATT_UNSUPPORT_GRP_TYPE        = 0x10,
+    WICED_BT_GATT_INSUF_RESOURCE            = 0x11,
+    WICED_BT_GATT_DATABASE_OUT_OF_SYNC      = 0x12,
+    WICED_BT_GATT_VALUE_NOT_ALLOWED         = 0x13,
+    WICED_BT_GATT_ILLEGAL_PARAMETER         = 0x87,
+    WICED_BT_GATT_NO_RESOURCES              = 0x80,
+    WICED_BT_GATT_INTERNAL_ERROR            = 0x81,
+    WICED_BT_GATT_WRONG_STATE               = 0x82,
+    WICED_BT_GATT_DB_FULL                   = 0x83,
+    WICED_BT_GATT_BUSY                      = 0x84,
+    WICED_BT_GATT_ERROR                     = 0x85,
+    WICED_BT_GATT_CMD_STARTED               = 0x86,
+    WICED_BT_GATT_PENDING                   = 0x88,
+    WICED_BT_GATT_AUTH_FAIL                 = 0x89,
+    WICED_BT_GATT_MORE                      = 0x8A,
+    WICED_BT_GATT_INVALID_CFG               = 0x8B,
+    WICED_BT_GATT_SERVICE_STARTED           = 0x8C,
+    WICED_BT_GATT_ENCRYPTED_NO_MITM         = 0x8D,
+    WICED_BT_GATT_NOT_ENCRYPTED             = 0x8E,
+    WICED_BT_GATT_CONGESTED                 = 0x8F,
+    WICED_BT_GATT_BAD_OPCODE                = 0x90,
+    WICED_BT_GATT_WRITE_REQ_REJECTED        = 0xFC,
+    WICED_BT_GATT_CCC_CFG_ERR               = 0xFD,
+    WICED_BT_GATT_PRC_IN_PROGRESS           = 0xFE,
+    WICED_BT_GATT_OUT_OF_RANGE              = 0xFF
+} wiced_bt_gatt_status_e;
+typedef uint16_t wiced_bt_gatt_status_t;
+
+/* ATT opcodes */
+typedef enum
+{
+    GATT_RSP_ERROR                          = 0x01,
+    GATT_REQ_MTU                            = 0x02,
+    GATT_RSP_MTU                            = 0x03,
+    GATT_REQ_READ_BY_TYPE                   = 0x08,
+    GATT_RSP_READ_BY_TYPE                   = 0x09,
+    GATT_REQ_READ                           = 0x0A,
+    GATT_RSP_READ                           = 0x0B,
+    GATT_REQ_READ_BLOB                      = 0x0C,
+    GATT_RSP_READ_BLOB                      = 0x0D,
+    GATT_REQ_WRITE                          = 0x12,
+    GATT_RSP_WRITE                          = 0x13,
+    GATT_REQ_PREPARE_WRITE                  = 0x16,
+    GATT_RSP_PREPARE_WRITE                  = 0x17,
+    GATT_REQ_EXECUTE_WRITE                  = 0x18,
+    GATT_RSP_EXECUTE_WRITE                  = 0x19,
+    GATT_HANDLE_VALUE_NOTIF                 = 0x1B,
+    GATT_HANDLE_VALUE_IND                   = 0x1D,
+    GATT_HANDLE_VALUE_CONF                  = 0x1E,
+    GATT_CMD_WRITE                          = 0x52,
+    GATT_CMD_SIGNED_WRITE                   = 0xD2
+} wiced_bt_gatt_opcode_e;
+typedef uint8_t wiced_bt_gatt_opcode_t;
+
+/* GATT events */
+typedef enum
+{
+    GATT_CONNECTION_STATUS_EVT,
+    GATT_OPERATION_CPLT_EVT,
+    GATT_DISCOVERY_RESULT_EVT,
+    GATT_DISCOVERY_CPLT_EVT,
+    GATT_ATTRIBUTE_REQUEST_EVT,
+    GATT_CONGESTION_EVT,
+    GATT_GET_RESPONSE_BUFFER_EVT,
+    GATT_APP_BUFFER_TRANSMITTED_EVT
+} wiced_bt_gatt_evt_t;
+
+/* Disconnection reasons */
+typedef enum
+{
+    GATT_CONN_UNKNOWN                       = 0x0000,
+    GATT_CONN_L2C_FAILURE                   = 0x0001,
+    GATT_CONN_TIMEOUT                       = 0x0008,
+    GATT_CONN_TERMINATE_PEER_USER           = 0x0013,
+    GATT_CONN_TERMINATE_LOCAL_HOST          = 0x0016,
+    GATT_CONN_LMP_TIMEOUT                   = 0x0022,
+    GATT_CONN_FAIL_ESTABLISH                = 0x003E,
+    GATT_CONN_CANCEL                        = 0x0100
+} wiced_bt_gatt_disconn_reason_t;
+
+/* Client characteristic configuration bits */
+#define GATT_CLIENT_CONFIG_NONE                 (0x0000)
+#define GATT_CLIENT_CONFIG_NOTIFICATION         (0x0001)
+#define GATT_CLIENT_CONFIG_INDICATION           (0x0002)
+
+/* Execute write flags */
+#define GATT_PREPARE_WRITE_CANCEL               (0x00)
+#define GATT_PREPARE_WRITE_EXEC                 (0x01)
+
+/* Characteristic properties */
+#define GATTDB_CHAR_PROP_READ                   (0x02)
+#define GATTDB_CHAR_PROP_WRITE_NO_RESPONSE      (0x04)
+#define GATTDB_CHAR_PROP_WRITE                  (0x08)
+#define GATTDB_CHAR_PROP_NOTIFY                 (0x10)
+#define GATTDB_CHAR_PROP_INDICATE               (0x20)
+#define GATTDB_CHAR_PROP_EXTENDED               (0x80)
+
+/* Characteristic extended properties */
+#define GATTDB_CHAR_EXTENDED_PROP_RELIABLE      (0x0001)
+
+/* Attribute permissions, GATTDB_PERM_SERVICE_UUID_128 marks a 128 bit
+ * attribute type */
+#define GATTDB_PERM_NONE                        (0x00)
+#define GATTDB_PERM_READABLE                    (0x01)
+#define GATTDB_PERM_WRITE_CMD                   (0x02)
+#define GATTDB_PERM_WRITE_REQ                   (0x04)
+#define GATTDB_PERM_WRITABLE                    (GATTDB_PERM_WRITE_CMD | GATTDB_PERM_WRITE_REQ)
+#define GATTDB_PERM_RELIABLE_WRITE              (0x40)
+#define GATTDB_PERM_SERVICE_UUID_128            (0x80)
+
+/* GATT database records: handle, permission, length of what follows, the
+ * attribute type and, for declarations, the value */
+#define GATT_DB_LO(x)                           ((uint8_t)((x) & 0xFF))
+#define GATT_DB_HI(x)                           ((uint8_t)(((x) >> 8) & 0xFF))
+
+#define PRIMARY_SERVICE_UUID16(handle, service)                                       \
+    GATT_DB_LO(handle), GATT_DB_HI(handle), GATTDB_PERM_READABLE, 4,                  \
+    GATT_DB_LO(GATT_UUID_PRI_SERVICE), GATT_DB_HI(GATT_UUID_PRI_SERVICE),             \
+    GATT_DB_LO(service), GATT_DB_HI(service)
+
+#define PRIMARY_SERVICE_UUID128(handle, service)                                      \
+    GATT_DB_LO(handle), GATT_DB_HI(handle), GATTDB_PERM_READABLE, 18,                 \
+    GATT_DB_LO(GATT_UUID_PRI_SERVICE), GATT_DB_HI(GATT_UUID_PRI_SERVICE), service
+
+#define CHARACTERISTIC_UUID16(handle, handle_value, uuid, properties, permission)     \
+    GATT_DB_LO(handle), GATT_DB_HI(handle), GATTDB_PERM_READABLE, 7,                  \
+    GATT_DB_LO(GATT_UUID_CHAR_DECLARE), GATT_DB_HI(GATT_UUID_CHAR_DECLARE),           \
+    (properties), GATT_DB_LO(handle_value), GATT_DB_HI(handle_value),                 \
+    GATT_DB_LO(uuid), GATT_DB_HI(uuid),                                               \
+    GATT_DB_LO(handle_value), GATT_DB_HI(handle_value), (uint8_t)(permission), 2,     \
+    GATT_DB_LO(uuid), GATT_DB_HI(uuid)
+
+#define CHARACTERISTIC_UUID128_WRITABLE(handle, handle_value, uuid, properties, permission) \
+    GATT_DB_LO(handle), GATT_DB_HI(handle), GATTDB_PERM_READABLE, 21,                 \
+    GATT_DB_LO(GATT_UUID_CHAR_DECLARE), GATT_DB_HI(GATT_UUID_CHAR_DECLARE),           \
+    (properties), GATT_DB_LO(handle_value), GATT_DB_HI(handle_value), uuid,           \
+    GATT_DB_LO(handle_value), GATT_DB_HI(handle_value),                               \
+    (uint8_t)((permission) | GATTDB_PERM_SERVICE_UUID_128), 16, uuid
+
+#define CHAR_DESCRIPTOR_UUID16(handle, uuid, permission)                              \
+    GATT_DB_LO(handle), GATT_DB_HI(handle), (uint8_t)(permission), 2,                 \
+    GATT_DB_LO(uuid), GATT_DB_HI(uuid)
+
+#define CHAR_DESCRIPTOR_UUID16_WRITABLE(handle, uuid, permission)                     \
+    GATT_DB_LO(handle), GATT_DB_HI(handle), (uint8_t)(permission), 2,                 \
+    GATT_DB_LO(uuid), GATT_DB_HI(uuid)
+
+/******************************************************************************
+ *                                Structures
+ ******************************************************************************/
+typedef struct
+{
+    uint16_t len;
+    union
+    {
+        uint16_t uuid16;
+        uint32_t uuid32;
+        uint8_t  uuid128[16];
+    } uu;
+} wiced_bt_uuid_t;
+
+typedef uint8_t wiced_bt_gatt_exec_flag_t;
+
+typedef struct
+{
+    uint16_t handle;
+    uint16_t offset;
+} wiced_bt_gatt_read_t;
+
+typedef struct
+{
+    uint16_t        s_handle;
+    uint16_t        e_handle;
+    wiced_bt_uuid_t uuid;
+} wiced_bt_gatt_read_by_type_t;
+
+typedef struct
+{
+    uint16_t handle;
+    uint16_t offset;
+    uint16_t val_len;
+    uint8_t *p_val;
+} wiced_bt_gatt_write_req_t;
+
+typedef struct
+{
+    uint16_t               conn_id;
+    wiced_bt_gatt_opcode_t opcode;
+    uint16_t               len_requested;
+    union
+    {
+        wiced_bt_gatt_read_t          read_req;
+        wiced_bt_gatt_read_by_type_t  read_by_type;
+        wiced_bt_gatt_write_req_t     write_req;
+        wiced_bt_gatt_exec_flag_t     exec_write_req;
+        uint16_t                      remote_mtu;
+        uint16_t                      confirm;
+        uint16_t                      handle;
+    } data;
+} wiced_bt_gatt_attribute_request_t;
+
+typedef struct
+{
+    uint8_t                        *bd_addr;
+    wiced_bt_ble_address_type_t     addr_type;
+    uint16_t                        conn_id;
+    wiced_bool_t                    connected;
+    wiced_bt_gatt_disconn_reason_t  reason;
+    wiced_bt_transport_t            transport;
+    uint8_t                         link_role;
+} wiced_bt_gatt_connection_status_t;
+
+typedef struct
+{
+    uint16_t     conn_id;
+    wiced_bool_t congested;
+} wiced_bt_gatt_congestion_event_t;
+
+typedef struct
+{
+    uint8_t *p_app_rsp_buffer;
+    void    *p_app_ctxt;
+} wiced_bt_gatt_buffer_t;
+
+typedef struct
+{
+    wiced_bt_gatt_opcode_t opcode;
+    uint16_t               len_requested;
+    wiced_bt_gatt_buffer_t buffer;
+} wiced_bt_gatt_buffer_request_t;
+
+typedef struct
+{
+    uint8_t *p_app_data;
+    void    *p_app_ctxt;
+} wiced_bt_gatt_buffer_transmitted_t;
+
+typedef union
+{
+    wiced_bt_gatt_connection_status_t   connection_status;
+    wiced_bt_gatt_attribute_request_t   attribute_request;
+    wiced_bt_gatt_congestion_event_t    congestion;
+    wiced_bt_gatt_buffer_request_t      buffer_request;
+    wiced_bt_gatt_buffer_transmitted_t  buffer_xmitted;
+} wiced_bt_gatt_event_data_t;
+
+typedef wiced_bt_gatt_status_t (wiced_bt_gatt_cback_t)(wiced_bt_gatt_evt_t event,
+                                                       wiced_bt_gatt_event_data_t *p_event_data);
+
+/****************************************************************************
+ *                              FUNCTION DECLARATIONS
+ ***************************************************************************/
+wiced_bt_gatt_status_t wiced_bt_gatt_register(wiced_bt_gatt_cback_t *p_gatt_cback);
+wiced_bt_gatt_status_t wiced_bt_gatt_db_init(const uint8_t *p_gatt_db, uint32_t gatt_db_size, void *hash);
+wiced_bt_gatt_status_t wiced_bt_gatt_disconnect(uint16_t conn_id);
+wiced_bt_gatt_status_t wiced_bt_gatt_server_send_notification(uint16_t conn_id, uint16_t attr_handle,
+                                                               uint16_t attr_len, uint8_t *p_attr_val,
+                                                               void *p_app_ctx);
+wiced_bt_gatt_status_t wiced_bt_gatt_server_send_indication(uint16_t conn_id, uint16_t attr_handle,
+                                                             uint16_t attr_len, uint8_t *p_attr_val,
+                                                             void *p_app_ctx);
+wiced_bt_gatt_status_t wiced_bt_gatt_server_send_mtu_rsp(uint16_t conn_id, uint16_t remote_mtu,
+                                                          uint16_t my_mtu);
+wiced_bt_gatt_status_t wiced_bt_gatt_server_send_write_rsp(uint16_t conn_id, wiced_bt_gatt_opcode_t opcode,
+                                                            uint16_t handle);
+wiced_bt_gatt_status_t wiced_bt_gatt_server_send_error_rsp(uint16_t conn_id, wiced_bt_gatt_opcode_t opcode,
+                                                            uint16_t handle, wiced_bt_gatt_status_t status);
+wiced_bt_gatt_status_t wiced_bt_gatt_server_send_read_handle_rsp(uint16_t conn_id, wiced_bt_gatt_opcode_t opcode,
+                                                                  uint16_t len, uint8_t *p_attr, void *p_app_ctx);
+wiced_bt_gatt_status_t wiced_bt_gatt_server_send_read_by_type_rsp(uint16_t conn_id, wiced_bt_gatt_opcode_t opcode,
+                                                                   uint8_t type_len, uint16_t data_len,
+                                                                   uint8_t *p_data, void *p_app_ctx);
+wiced_bt_gatt_status_t wiced_bt_gatt_server_send_prepare_write_rsp(uint16_t conn_id, wiced_bt_gatt_opcode_t opcode,
+                                                                    uint16_t handle, uint16_t offset, uint16_t len,
+                                                                    uint8_t *p_data, void *p_app_ctx);
+wiced_bt_gatt_status_t wiced_bt_gatt_server_send_execute_write_rsp(uint16_t conn_id, wiced_bt_gatt_opcode_t opcode);
+uint16_t               wiced_bt_gatt_find_handle_by_type(uint16_t s_handle, uint16_t e_handle,
+                                                         wiced_bt_uuid_t *p_uuid);
+int                    wiced_bt_gatt_put_read_by_type_rsp_in_stream(uint8_t *p_stream, int stream_len,
+                                                                    uint8_t *p_pair_len, uint16_t attr_handle,
+                                                                    uint16_t attr_len, uint8_t *p_attr);
+
+#endif      /* __WICED_BT_GATT_H__ */
+
+
+/* [] END OF FILE */
@@ -0,0 +1,102 @@
+/******************************************************************************
+* File Name:   wiced_bt_l2c.h
+*
+* Description: Host build stand-in for the AIROC Bluetooth stack L2CAP LE
+*              credit based channel interface.
+*
+* Related Document: See README.md
+*
+********************************************************************************
+* Copyright 2021-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef __WICED_BT_L2C_H__
+#define __WICED_BT_L2C_H__
+
+/******************************************************************************
+ *                                INCLUDES
+ ******************************************************************************/
+#include "wiced_bt_ble.h"
+
+/******************************************************************************
+ *                                Constants
+ ******************************************************************************/
+#define L2CAP_CONN_OK                           (0)
+#define L2CAP_LE_RESULT_NO_RESOURCES            (4)
+
+#define L2CAP_DATAWRITE_FAILED                  (0)
+#define L2CAP_DATAWRITE_SUCCESS                 (1)
+#define L2CAP_DATAWRITE_CONGESTED               (2)
+
+#define L2CAP_FLUSHABLE_CH_BASED                (0x0000)
+
+/******************************************************************************
+ *                                Structures
+ ******************************************************************************/
+typedef void (wiced_bt_l2cap_le_connect_indication_cback_t)(void *context, wiced_bt_device_address_t bd_addr,
+                                                            uint16_t local_cid, uint16_t psm, uint8_t id,
+                                                            uint16_t mtu_peer);
+typedef void (wiced_bt_l2cap_le_connect_confirm_cback_t)(void *context, uint16_t local_cid, uint16_t result,
+                                                         uint16_t mtu_peer);
+typedef void (wiced_bt_l2cap_disconnect_indication_cback_t)(void *context, uint16_t local_cid, wiced_bool_t ack);
+typedef void (wiced_bt_l2cap_disconnect_confirm_cback_t)(void *context, uint16_t local_cid, uint16_t result);
+typedef void (wiced_bt_l2cap_data_indication_cback_t)(void *context, uint16_t local_cid, uint8_t *p_data,
+                                                      uint16_t len);
+typedef void (wiced_bt_l2cap_congestion_status_cback_t)(void *context, uint16_t local_cid, wiced_bool_t congested);
+typedef void (wiced_bt_l2cap_tx_complete_cback_t)(void *context, uint16_t local_cid, uint16_t buf_count);
+
+typedef struct
+{
+    wiced_bt_l2cap_le_connect_indication_cback_t  *le_connect_ind_cb;
+    wiced_bt_l2cap_le_connect_confirm_cback_t     *le_connect_cfm_cb;
+    wiced_bt_l2cap_disconnect_indication_cback_t  *disconnect_ind_cb;
+    wiced_bt_l2cap_disconnect_confirm_cback_t     *disconnect_cfm_cb;
+    wiced_bt_l2cap_data_indication_cback_t        *data_ind_cb;
+    wiced_bt_l2cap_congestion_status_cback_t      *congestion_status_cb;
+    wiced_bt_l2cap_tx_complete_cback_t            *tx_complete_cb;
+    uint16_t                                       le_mps;
+} wiced_bt_l2cap_le_appl_information_t;
+
+/****************************************************************************
+ *                              FUNCTION DECLARATIONS
+ ***************************************************************************/
+uint16_t     wiced_bt_l2cap_le_register(uint16_t le_psm, wiced_bt_l2cap_le_appl_information_t *p_cb_info,
+                                        void *context);
+wiced_bool_t wiced_bt_l2cap_le_connect_rsp(wiced_bt_device_address_t p_bd_addr, uint8_t id, uint16_t lcid,
+                                           uint16_t result, uint16_t mtu_size);
+wiced_bool_t wiced_bt_l2cap_le_disconnect_rsp(uint16_t lcid);
+uint8_t      wiced_bt_l2cap_le_data_write(uint16_t cid, uint8_t *p_data, uint16_t buf_len, uint16_t flags);
+
+#endif      /* __WICED_BT_L2C_H__ */
+
+
+/* [] END OF FILE */
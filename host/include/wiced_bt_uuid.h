@@ -0,0 +1,61 @@
+/******************************************************************************
+* File Name:   wiced_bt_uuid.h
+*
+* Description: Host build stand-in for the AIROC Bluetooth stack UUID
+*              definitions used by the GATT database.
+*
+* Related Document: See README.md
+*
+********************************************************************************
+* Copyright 2021-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef __WICED_BT_UUID_H__
+#define __WICED_BT_UUID_H__
+
+/******************************************************************************
+ *                                Constants
+ ******************************************************************************/
+#define GATT_UUID_PRI_SERVICE                   (0x2800)
+#define GATT_UUID_CHAR_DECLARE                  (0x2803)
+#define GATT_UUID_CHAR_EXT_PROP                 (0x2900)
+#define GATT_UUID_CHAR_CLIENT_CONFIG            (0x2902)
+#define UUID_SERVICE_GAP                        (0x1800)
+#define UUID_CHARACTERISTIC_DEVICE_NAME         (0x2A00)
+#define UUID_CHARACTERISTIC_APPEARANCE          (0x2A01)
+#define UUID_DESCRIPTOR_CLIENT_CHARACTERISTIC_CONFIGURATION GATT_UUID_CHAR_CLIENT_CONFIG
+#define UUID_DESCRIPTOR_CHARACTERISTIC_EXTENDED_PROPERTIES GATT_UUID_CHAR_EXT_PROP
+
+#endif      /* __WICED_BT_UUID_H__ */
+
+
+/* [] END OF FILE */
@@ -51,6 +51,22 @@
 #include "GeneratedSource/cycfg_gatt_db.h"
 #include "GeneratedSource/cycfg_bt_settings.h"
 #include "app_bt_utils.h"
+#include "app_tput_config.h"
+#include "app_bt_conn.h"
+#include "app_bt_buffer_pool.h"
+#include "app_bt_read_cache.h"
+#include "app_bt_attr_table.h"
+#include "app_bt_sink.h"
+#include "app_log.h"
+#include "app_tput_stats.h"
+#include "app_tput_frame.h"
+#include "app_tput_payload.h"
+#include "app_tput_ctrl.h"
+#include "app_tput_telemetry.h"
+#include "app_tput_ping.h"
+#include "app_tput_read.h"
+#include "app_tput_cycles.h"
+#include "app_tput_trace.h"
 #include "wiced_bt_ble.h"
 #include "wiced_bt_uuid.h"
 #include "wiced_memory.h"
@@ -83,15 +99,38 @@ typedef void (*pfn_free_buffer_t)(uint8_t *);
 #define TASK_STACK_SIZE              (8192)
 #define TASK_PRIORITY        (CY_RTOS_PRIORITY_NORMAL)
 
-#define NOTIFICATION_DATA_SIZE           (244)
-
-/* Connection update parameters */
-#define CONNECTION_INTERVAL               		(28)		/* (1.25 * CONNECTION_INTERVAL)ms */
-#define SUPERVISION_TIMEOUT             		(1000)
-#define CONN_INTERVAL_MULTIPLIER				(1.25f)
-#define TPUT_TIMER_UPDATE   					(5*3000000)
-#define TPUT_FREQUENCY 							(3000000)
-#define PACKET_PER_EVENT						(10)
+/* Payload size, burst size, connection parameters and report period are
+ * defined in app_tput_config.h */
+
+/* Bytes a client may send per scheduler round of notify_task */
+#define NOTIFY_QUANTUM(p_conn)          ((uint32_t)(p_conn)->pacer.burst * (p_conn)->payload_size)
+/* Maximum time notify_task waits for a congested client before retrying */
+#define NOTIFY_CONGESTION_TIMEOUT_MS    (100)
+
+/* Events that wake up notify_task */
+#define NOTIFY_EVT_CCCD_ENABLED         (1u << 0)
+#define NOTIFY_EVT_CCCD_DISABLED        (1u << 1)
+#define NOTIFY_EVT_CONGESTION_CLEARED   (1u << 2)
+#define NOTIFY_EVT_CONN_UP              (1u << 3)
+#define NOTIFY_EVT_CONN_DOWN            (1u << 4)
+#define NOTIFY_EVT_SHUTDOWN             (1u << 5)
+#define NOTIFY_EVT_CONTROL              (1u << 6)
+#define NOTIFY_EVT_CONFIRMED            (1u << 7)
+#define NOTIFY_EVT_ALL                  (NOTIFY_EVT_CCCD_ENABLED | NOTIFY_EVT_CCCD_DISABLED | \
+                                         NOTIFY_EVT_CONGESTION_CLEARED | NOTIFY_EVT_CONN_UP | \
+                                         NOTIFY_EVT_CONN_DOWN | NOTIFY_EVT_SHUTDOWN | \
+                                         NOTIFY_EVT_CONTROL | NOTIFY_EVT_CONFIRMED)
+
+/* A client receives notifications or indications once it enabled them and
+ * its test run is started in the TX direction */
+#define NOTIFY_STREAMING(p_conn)        (((p_conn)->cccd & (GATT_CLIENT_CONFIG_NOTIFICATION | \
+                                                            GATT_CLIENT_CONFIG_INDICATION)) && \
+                                         ((p_conn)->ctrl.running) && \
+                                         ((p_conn)->ctrl.direction & APP_TPUT_CTRL_DIR_TX))
+/* Indications are sent when the client enabled them and not notifications */
+#define NOTIFY_INDICATING(p_conn)       (GATT_CLIENT_CONFIG_INDICATION == \
+                                         ((p_conn)->cccd & (GATT_CLIENT_CONFIG_NOTIFICATION | \
+                                                            GATT_CLIENT_CONFIG_INDICATION)))
 /**
  * @brief This enumeration combines the advertising, connection states from two
  *        different callbacks to maintain the status in a single state variable
@@ -100,29 +139,14 @@ typedef enum
 {
     APP_BT_ADV_OFF_CONN_OFF,
     APP_BT_ADV_ON_CONN_OFF,
-    APP_BT_ADV_OFF_CONN_ON
+    APP_BT_ADV_OFF_CONN_ON,
+    APP_BT_ADV_ON_CONN_ON
 } app_bt_adv_conn_mode_t;
 
-typedef struct
-{
-    wiced_bt_device_address_t             remote_addr;   /* remote peer device address */
-    uint16_t                              conn_id;       /* connection ID referenced by the stack */
-    uint16_t                              mtu;           /* MTU exchanged after connection */
-    double                                conn_interval; /* connection interval negotiated */
-    wiced_bt_ble_host_phy_preferences_t   rx_phy;        /* RX PHY selected */
-    wiced_bt_ble_host_phy_preferences_t   tx_phy;        /* TX PHY selected */
-
-} conn_state_info_t;
-
 /*******************************************************************************
 *        Variable Definitions
 *******************************************************************************/
 
-/* Variables to hold GATT notification bytes sent and GATT Write bytes received
- * successfully */
-static unsigned long gatt_notif_tx_bytes = 0u;
-static unsigned long gatt_write_rx_bytes = 0u;
-
 /**
  * @brief Variable to store handle of tasks created to update the throughput and send
           notifications
@@ -136,27 +160,23 @@ static app_bt_adv_conn_mode_t app_bt_adv_conn_state = APP_BT_ADV_OFF_CONN_OFF;
 
 static uint64_t notify_task_stack[TASK_STACK_SIZE], tput_task_stack[TASK_STACK_SIZE];
 
-uint8_t notification_data_seq[NOTIFICATION_DATA_SIZE];
-
-cy_semaphore_t semaphore, congestion;
-
-uint8_t tput_fun = 1;
-
-/* Variable to store connection state information*/
-static conn_state_info_t conn_state_info;
+/**
+ * @brief Events that wake up notify_task, see NOTIFY_EVT_*
+ */
+static cy_event_t notify_events;
 
 /**
- * @brief Variable for 5 sec timer object
+ * @brief Variable for the throughput statistics timer object
  */
 static cyhal_timer_t tput_timer_obj;
 
 /**
- * @brief Configure timer for 5 sec
+ * @brief Configure timer for one statistics bucket period
  */
 const cyhal_timer_cfg_t tput_timer_cfg =
     {
         .compare_value = 0,                    /* Timer compare value, not used */
-        .period = TPUT_TIMER_UPDATE,            /* Defines the timer period */
+        .period = (TPUT_FREQUENCY / 1000) * APP_TPUT_STATS_BUCKET_MS, /* One statistics bucket */
         .direction = CYHAL_TIMER_DIR_UP,       /* Timer counts up */
         .is_compare = false,                   /* Don't use compare mode */
         .is_continuous = true,                 /* Run timer indefinitely */
@@ -183,7 +203,23 @@ static wiced_bt_gatt_status_t app_bt_server_event_handler           (wiced_bt_ga
 static wiced_bt_gatt_status_t app_bt_gatt_event_callback            (wiced_bt_gatt_evt_t event,
                                                                      wiced_bt_gatt_event_data_t *p_event_data);
 static wiced_bt_gatt_status_t app_bt_write_handler                  (wiced_bt_gatt_event_data_t *p_data);
-static wiced_bt_gatt_status_t app_bt_set_value                      (uint16_t attr_handle, uint8_t *p_val, uint16_t len);
+static wiced_bt_gatt_status_t app_bt_prepare_write_handler          (uint16_t conn_id,
+                                                                     wiced_bt_gatt_opcode_t opcode,
+                                                                     wiced_bt_gatt_write_req_t *p_write_req);
+static wiced_bt_gatt_status_t app_bt_execute_write_handler          (uint16_t conn_id,
+                                                                     wiced_bt_gatt_opcode_t opcode,
+                                                                     wiced_bt_gatt_exec_flag_t exec_flag);
+static wiced_bt_gatt_status_t app_bt_set_value                      (uint16_t conn_id, uint16_t attr_handle,
+                                                                     uint8_t *p_val, uint16_t len);
+static wiced_bt_gatt_status_t app_bt_notify_cccd_write_handler      (uint16_t conn_id,
+                                                                     gatt_db_lookup_table_t *p_attr,
+                                                                     uint8_t *p_val, uint16_t len);
+static wiced_bt_gatt_status_t app_bt_writeme_write_handler          (uint16_t conn_id,
+                                                                     gatt_db_lookup_table_t *p_attr,
+                                                                     uint8_t *p_val, uint16_t len);
+static wiced_bt_gatt_status_t app_bt_control_write_handler          (uint16_t conn_id,
+                                                                     gatt_db_lookup_table_t *p_attr,
+                                                                     uint8_t *p_val, uint16_t len);
 
 /* Callback function for Bluetooth stack management type events */
 static wiced_bt_dev_status_t  app_bt_management_callback            (wiced_bt_management_evt_t event,
@@ -193,9 +229,15 @@ static void                   app_bt_init                           (void);
 /* Task to send notifications */
 void notify_task(cy_thread_arg_t arg);
 
-/* Task to calculate throughput every 5 seconds */
+/* Task to sample the counters every bucket period and report the throughput */
 void tput_task(cy_thread_arg_t arg);
 
+/* Send one notification of payload_size bytes */
+static wiced_bt_gatt_status_t notify_task_send(conn_state_info_t *p_conn);
+
+/* Wait for the events that drive notify_task */
+static uint32_t notify_task_wait(cy_time_t timeout);
+
 /* HAL timer callback registered when timer reaches terminal count */
 void tput_timer_callb(void *callback_arg, cyhal_timer_event_t event);
 
@@ -230,7 +272,8 @@ void hci_trace_cback(wiced_bt_hci_trace_type_t type,
  * app_bt_alloc_buffer
  *
  * Function Description:
- * @brief  This Function allocates the buffer of requested length
+ * @brief  This Function allocates the buffer of requested length from the
+ *         GATT response buffer pool
  *
  * @param len            Length of the buffer
  *
@@ -238,9 +281,7 @@ void hci_trace_cback(wiced_bt_hci_trace_type_t type,
  */
 static uint8_t *app_bt_alloc_buffer(uint16_t len)
 {
-    uint8_t *p = (uint8_t *)malloc(len);
-    printf( "%s() len %d alloc %p \n", __FUNCTION__,len, p);
-    return p;
+    return app_bt_buffer_pool_alloc(len);
 }
 
 /**
@@ -248,7 +289,8 @@ static uint8_t *app_bt_alloc_buffer(uint16_t len)
  * app_bt_free_buffer
  *
  * Function Description:
- * @brief  This Function frees the buffer requested
+ * @brief  This Function returns the buffer requested to the GATT response
+ *         buffer pool
  *
  * @param p_data         pointer to the buffer to be freed
  *
@@ -256,11 +298,7 @@ static uint8_t *app_bt_alloc_buffer(uint16_t len)
  */
 static void app_bt_free_buffer(uint8_t *p_data)
 {
-    if (p_data != NULL)
-    {
-        printf( "%s()        free:%p \n",__FUNCTION__, p_data);
-        free(p_data);
-    }
+    app_bt_buffer_pool_free(p_data);
 }
 
 /**
@@ -288,6 +326,9 @@ int main()
     /* Enable global interrupts */
     __enable_irq();
 
+    /* Start the cycle counter timing the Bluetooth callback paths */
+    app_tput_cycles_init();
+
 #ifdef ENABLE_BT_SPY_LOG
 {
     cybt_debug_uart_config_t config = {
@@ -316,6 +357,16 @@ int main()
          CY_ASSERT(0);
     }
 
+    /* Start the deferred logger used on the Bluetooth callback and ISR paths */
+    app_log_init();
+
+    /* Start generating the notification payloads ahead of notify_task */
+    app_tput_payload_init();
+    app_tput_read_init();
+
+    /* Start the L2CAP credit based channel sender */
+    app_tput_coc_init();
+
     /* Register call back and configuration with stack */
     result = wiced_bt_stack_init(app_bt_management_callback, &wiced_bt_cfg_settings);
 
@@ -326,6 +377,15 @@ int main()
         CY_ASSERT(0);
     }
 
+    result = cy_rtos_event_init(&notify_events);
+    if (result != CY_RSLT_SUCCESS)
+    {
+        printf("Notify event group initialization failed 0x%X\n", result);
+    }
+
+    /* Control commands are applied by notify_task */
+    app_tput_ctrl_queue_init(&notify_events, NOTIFY_EVT_CONTROL);
+
     /*Create Notify task*/
     result = cy_rtos_thread_create(&notify_task_pointer,
                                    &notify_task,
@@ -350,19 +410,6 @@ int main()
     {
         printf("Tput task creation failed 0x%X\n", result);
     }
-
-    result = cy_rtos_semaphore_init(&semaphore, 1, 0);
-    if (result != CY_RSLT_SUCCESS)
-    {
-        printf("Semaphore initialization failed 0x%X\n", result);
-    }
-
-
-    result = cy_rtos_semaphore_init(&congestion, 1, 0);
-    if (result != CY_RSLT_SUCCESS)
-    {
-        printf("Congestion semaphore initialization failed 0x%X\n", result);
-    }
 }
 
 /**
@@ -387,6 +434,7 @@ wiced_result_t app_bt_management_callback(wiced_bt_management_evt_t event,
     wiced_bt_device_address_t bda = {0};
     wiced_bt_ble_advert_mode_t *p_adv_mode = NULL;
     wiced_bool_t conn_param_status = 0;
+    conn_state_info_t *p_conn = NULL;
 
 
     switch (event)
@@ -412,18 +460,32 @@ wiced_result_t app_bt_management_callback(wiced_bt_management_evt_t event,
 
         break;
 
+    case BTM_DISABLED_EVT:
+        /* Bluetooth stack disabled, stop streaming */
+        cy_rtos_event_setbits(&notify_events, NOTIFY_EVT_SHUTDOWN);
+        result = WICED_BT_SUCCESS;
+        break;
+
     case BTM_LOCAL_IDENTITY_KEYS_UPDATE_EVT:        /* Local identity Keys Update */
         result = WICED_BT_SUCCESS;
         break;
 
     case BTM_BLE_PHY_UPDATE_EVT:
     {
-    	conn_state_info.rx_phy = p_event_data->ble_phy_update_event.rx_phy;
-    	conn_state_info.tx_phy = p_event_data->ble_phy_update_event.tx_phy;
-    	printf("Selected RX PHY - %dM\nSelected TX PHY - %dM\n", conn_state_info.rx_phy,conn_state_info.tx_phy);
-        print_bd_address(conn_state_info.remote_addr);
-        conn_param_status = wiced_bt_l2cap_update_ble_conn_params(conn_state_info.remote_addr,
-                    		CONNECTION_INTERVAL,CONNECTION_INTERVAL + 1,
+        p_conn = app_bt_conn_find_by_bda(p_event_data->ble_phy_update_event.bd_address);
+        if (NULL == p_conn)
+        {
+            result = WICED_BT_SUCCESS;
+            break;
+        }
+        p_conn->rx_phy = p_event_data->ble_phy_update_event.rx_phy;
+        p_conn->tx_phy = p_event_data->ble_phy_update_event.tx_phy;
+        printf("Selected RX PHY - %s\nSelected TX PHY - %s\n",
+               app_tput_link_phy_name(p_conn->rx_phy), app_tput_link_phy_name(p_conn->tx_phy));
+        print_bd_address(p_conn->remote_addr);
+        conn_param_status = wiced_bt_l2cap_update_ble_conn_params(p_conn->remote_addr,
+                    		p_conn->ctrl.conn_interval,
+                    		APP_TPUT_CTRL_CONN_INTERVAL_MAX(p_conn->ctrl.conn_interval),
         					CY_BT_CONN_LATENCY,SUPERVISION_TIMEOUT);
         /* Send connection parameter update request to peripheral */
         if(!conn_param_status)
@@ -443,6 +505,25 @@ wiced_result_t app_bt_management_callback(wiced_bt_management_evt_t event,
         printf( "ble_connection_param_update.conn_latency        : %d\r\n",p_event_data->ble_connection_param_update.conn_latency);
         printf( "ble_connection_param_update.supervision_timeout : %d\r\n",p_event_data->ble_connection_param_update.supervision_timeout);
         printf( "ble_connection_param_update.status              : 0x%x\r\n\n",p_event_data->ble_connection_param_update.status);
+        p_conn = app_bt_conn_find_by_bda(p_event_data->ble_connection_param_update.bd_addr);
+        if (NULL != p_conn)
+        {
+            p_conn->conn_interval = p_event_data->ble_connection_param_update.conn_interval * CONN_INTERVAL_MULTIPLIER;
+        }
+        result = WICED_BT_SUCCESS;
+        break;
+
+    case BTM_BLE_DATA_LENGTH_UPDATE_EVENT:
+        /* LE data length changed, resize the notifications of the link */
+        p_conn = app_bt_conn_find_by_bda(p_event_data->ble_data_length_update_event.bd_address);
+        if (NULL != p_conn)
+        {
+            p_conn->tx_octets = p_event_data->ble_data_length_update_event.max_tx_octets;
+            app_bt_conn_update_payload_size(p_conn);
+            printf("Data length TX %d octets, MTU %d, notification payload %d bytes [conn_id %d]\n",
+                   p_conn->tx_octets, p_conn->mtu, p_conn->payload_size, p_conn->conn_id);
+        }
+        result = WICED_BT_SUCCESS;
         break;
 
     case BTM_BLE_ADVERT_STATE_CHANGED_EVT:
@@ -456,7 +537,7 @@ wiced_result_t app_bt_management_callback(wiced_bt_management_evt_t event,
             printf("Advertisement Stopped\n");
 
             /* Check connection status after advertisement stops */
-            if (0 == conn_state_info.conn_id)
+            if (0 == app_bt_conn_count())
             {
                 app_bt_adv_conn_state = APP_BT_ADV_OFF_CONN_OFF;
             }
@@ -469,7 +550,8 @@ wiced_result_t app_bt_management_callback(wiced_bt_management_evt_t event,
         {
             /* Advertisement Started */
             printf("Advertisement Started\n");
-            app_bt_adv_conn_state = APP_BT_ADV_ON_CONN_OFF;
+            app_bt_adv_conn_state = (0 == app_bt_conn_count()) ? APP_BT_ADV_ON_CONN_OFF :
+                                                                 APP_BT_ADV_ON_CONN_ON;
         }
 
         result = WICED_BT_SUCCESS;
@@ -510,11 +592,7 @@ static void app_bt_init(void)
 
     printf("**Discover device with \"TPUT\" name*\n");
 
-    /* Initialize the data packet to be sent as GATT notification to the peer device */
-    for(uint8_t iterator = 0; iterator < NOTIFICATION_DATA_SIZE; iterator++)
-    {
-        notification_data_seq[iterator] = iterator;
-    }
+    app_tput_frame_init();
 
     /* Initialize the HAL timer used to count seconds */
     cy_result = cyhal_timer_init(&tput_timer_obj, NC, NULL);
@@ -522,7 +600,7 @@ static void app_bt_init(void)
     {
         printf("Throughput timer init failed !\n");
     }
-    /* Configure the timer for 5 seconds */
+    /* Configure the timer for one statistics bucket period */
     cyhal_timer_configure(&tput_timer_obj, &tput_timer_cfg);
     cy_result = cyhal_timer_set_frequency(&tput_timer_obj, TPUT_FREQUENCY);
     if (CY_RSLT_SUCCESS != cy_result)
@@ -556,6 +634,32 @@ static void app_bt_init(void)
         CY_ASSERT(0);
     }
 
+    /* Index the application attributes and register the side effects of writes */
+    app_bt_attr_table_init();
+    app_bt_attr_register_write(HDLD_THROUGHPUT_MEASUREMENT_NOTIFY_CLIENT_CHAR_CONFIG,
+                               app_bt_notify_cccd_write_handler, 0);
+    app_bt_attr_register_write(HDLC_THROUGHPUT_MEASUREMENT_WRITEME_VALUE,
+                               app_bt_writeme_write_handler,
+                               APP_TPUT_WRITEME_SINK ? APP_BT_ATTR_WRITE_SINK : 0);
+    app_bt_attr_register_write(HDLC_THROUGHPUT_MEASUREMENT_CONTROL_VALUE,
+                               app_bt_control_write_handler, 0);
+    app_bt_attr_register_write(HDLD_THROUGHPUT_MEASUREMENT_TELEMETRY_CLIENT_CHAR_CONFIG,
+                               app_tput_telemetry_cccd_write, 0);
+    app_bt_attr_register_write(HDLC_THROUGHPUT_MEASUREMENT_PING_VALUE,
+                               app_tput_ping_write, APP_BT_ATTR_WRITE_SINK);
+    app_bt_attr_register_write(HDLD_THROUGHPUT_MEASUREMENT_PING_CLIENT_CHAR_CONFIG,
+                               app_tput_ping_cccd_write, 0);
+
+    /* Values kept per client, not served from another client's response */
+    app_bt_read_cache_exclude(HDLD_THROUGHPUT_MEASUREMENT_NOTIFY_CLIENT_CHAR_CONFIG);
+    app_bt_read_cache_exclude(HDLC_THROUGHPUT_MEASUREMENT_TELEMETRY_VALUE);
+    app_bt_read_cache_exclude(HDLD_THROUGHPUT_MEASUREMENT_TELEMETRY_CLIENT_CHAR_CONFIG);
+    app_bt_read_cache_exclude(HDLD_THROUGHPUT_MEASUREMENT_PING_CLIENT_CHAR_CONFIG);
+    app_bt_sink_init();
+
+    /* Accept L2CAP credit based channels next to GATT */
+    app_tput_coc_register();
+
     /* Start Undirected Bluetooth LE Advertisements on device startup.
      * The corresponding parameters are contained in 'app_bt_cfg.c' */
     result = wiced_bt_start_advertisements(BTM_BLE_ADVERT_UNDIRECTED_HIGH, 0, NULL);
@@ -580,7 +684,7 @@ static void app_bt_init(void)
  tput_timer_callb
 
  Function Description:
- @brief  This callback function is invoked on timeout of 5 second timer.
+ @brief  This callback function is invoked on timeout of the statistics bucket timer.
 
  @param  void*: unused
  @param cyhal_timer_event_t: unused
@@ -590,61 +694,305 @@ static void app_bt_init(void)
 void tput_timer_callb(void *callback_arg, cyhal_timer_event_t event)
 {
     cy_rslt_t result;
-    tput_fun = 1;
 
     result = cy_rtos_thread_set_notification(&tput_task_pointer);
     if (result != CY_RSLT_SUCCESS)
     {
-        if (result == CY_RTOS_GENERAL_ERROR)
-        {
-            printf("CY_RTOS_GENERAL_ERROR thread notification failed !\n");
-        }
-        else if (result == CY_RTOS_BAD_PARAM)
-        {
-            printf("CY_RTOS_BAD_PARAM thread notification failed !\n");
-        }
-        else
-        {
-            printf("others thread notification failed !\n");
-        }
+        /* Interrupt context, defer the report to the log task */
+        app_log_write(APP_LOG_TPUT_NOTIFY_FAILED, result, 0, 0);
     }
 }
 
+/*
+ Function name:
+ tput_task_print
+
+ Function Description:
+ @brief  Prints the throughput statistics of one stream
+
+ @param  p_name: stream name, fixed width
+ @param  p_report: statistics of the stream
+ @param  conn_id: connection ID of the stream
+
+ @return void
+ */
+static void tput_task_print(const char *p_name, app_tput_stats_report_t *p_report, uint16_t conn_id)
+{
+    printf("%s: Server Throughput = %lu kbps [conn_id %d]\n", p_name,
+           (unsigned long)p_report->mean_kbps, conn_id);
+    printf("%s: min %lu p50 %lu p95 %lu p99 %lu max %lu kbps, %lu pkt/s, %lu stalls\n", p_name,
+           (unsigned long)p_report->min_kbps, (unsigned long)p_report->p50_kbps,
+           (unsigned long)p_report->p95_kbps, (unsigned long)p_report->p99_kbps,
+           (unsigned long)p_report->max_kbps, (unsigned long)p_report->packets_per_s,
+           (unsigned long)p_report->stalls);
+}
+
+/*
+ Function name:
+ tput_task_goodput
+
+ Function Description:
+ @brief  Computes the goodput of a framed stream since the previous report
+
+ @param  p_ctr: data byte counter of the stream
+ @param  p_reported: counter value at the previous report, updated
+ @param  period_ms: time since the previous report
+
+ @return unsigned long: goodput in kbps
+ */
+static unsigned long tput_task_goodput(const app_tput_counter_t *p_ctr, uint64_t *p_reported,
+                                       uint32_t period_ms)
+{
+    app_tput_counter_snapshot_t snap;
+    uint64_t bytes;
+
+    app_tput_counter_snapshot(p_ctr, &snap);
+    bytes = snap.bytes - *p_reported;
+    *p_reported = snap.bytes;
+
+    /* bytes * 8 bits / period in ms = kbps */
+    return (unsigned long)((bytes * 8u) / period_ms);
+}
+
 /*
  Function name:
  tput_task
 
  Function Description:
- @brief  This task calculates throughput every 5 seconds
+ @brief  This task samples the byte and packet counters of every connection
+         into the statistics buckets each bucket period, and prints the
+         throughput statistics every report period
 
  @param  cy_thread_arg_t: unused
 
  @return void
  */
 void tput_task(cy_thread_arg_t arg){
-
+    conn_state_info_t *p_conn;
+    app_tput_stats_report_t tx_report, rx_report, rd_report;
+    app_tput_counter_snapshot_t tx_snap, rx_snap, rd_snap;
+    unsigned long total_tx_kbps, total_rx_kbps, total_rd_kbps;
+    unsigned long tx_good_kbps, rx_good_kbps, acked_kbps;
+    unsigned long coc_tx_kbps, coc_rx_kbps;
+    unsigned long long_write_kbps;
+    app_tput_counter_snapshot_t long_write_snap;
+    app_tput_indication_report_t ind_report;
+    app_tput_congestion_report_t cong_report;
+    app_tput_congestion_buffers_t cong_buffers;
+    app_bt_buffer_pool_stats_t pool_stats;
+    app_bt_read_cache_stats_t cache_stats;
+    app_bt_sink_stats_t sink_stats;
+    uint32_t sampled_ms = 0;
+    uint32_t report_ms;
+    cy_time_t report_start, report_end;
+    uint16_t buckets;
+
+    cy_rtos_get_time(&report_start);
     while(true){
         cy_rtos_thread_wait_notification(CY_RTOS_NEVER_TIMEOUT);
-        /* Display GATT TX throughput result */
-        if ((conn_state_info.conn_id) &&(app_throughput_measurement_notify_client_char_config[0]) && (gatt_notif_tx_bytes))
+
+        /* Close the statistics bucket of every stream */
+        for (uint8_t index = 0; index < APP_BT_MAX_CONNECTIONS; index++)
         {
+            p_conn = app_bt_conn_get(index);
+            if (NULL == p_conn)
+            {
+                continue;
+            }
+            if (app_tput_ctrl_expired(&p_conn->ctrl))
+            {
+                printf("Test run complete [conn_id %d]\n", p_conn->conn_id);
+            }
+            app_tput_counter_snapshot(&p_conn->tx_ctr, &tx_snap);
+            app_tput_counter_snapshot(&p_conn->rx_ctr, &rx_snap);
+            app_tput_stats_sample(&p_conn->tx_stats, tx_snap.bytes, tx_snap.packets,
+                                  NOTIFY_STREAMING(p_conn) ? WICED_TRUE : WICED_FALSE);
+            app_tput_stats_sample(&p_conn->rx_stats, rx_snap.bytes, rx_snap.packets,
+                                  (0 != rx_snap.packets) ? WICED_TRUE : WICED_FALSE);
+            app_tput_counter_snapshot(&p_conn->rd_ctr, &rd_snap);
+            app_tput_stats_sample(&p_conn->rd_stats, rd_snap.bytes, rd_snap.packets,
+                                  (0 != rd_snap.packets) ? WICED_TRUE : WICED_FALSE);
+        }
+
+        /* Sample the controller TX buffer headroom */
+        app_tput_congestion_sample_buffers();
+
+        /* Send the telemetry records that are due, when the links have room */
+        app_tput_telemetry_poll();
+
+        /* Advance the auto-tune sweeps */
+        app_tput_autotune_poll();
+
+        /* Move degraded links to a more robust PHY and recovered ones back */
+        app_tput_link_poll();
+
+        /* Print the callback trace when requested */
+        app_tput_trace_poll();
+
+        /* Release the WriteMe values queued by the sink forwarder */
+        app_bt_sink_drain();
+
+        sampled_ms += APP_TPUT_STATS_BUCKET_MS;
+        if (sampled_ms < app_tput_stats_get_report_period())
+        {
+            continue;
+        }
+        sampled_ms = 0;
+        /* The bucket timer can drift from the RTOS tick, rates use the
+         * measured time since the previous report */
+        cy_rtos_get_time(&report_end);
+        report_ms = MAX((uint32_t)(report_end - report_start), 1u);
+        report_start = report_end;
+        buckets = app_tput_stats_get_report_buckets();
+
+        total_tx_kbps = 0;
+        total_rx_kbps = 0;
+        total_rd_kbps = 0;
+        app_tput_congestion_get_buffers(&cong_buffers);
+        for (uint8_t index = 0; index < APP_BT_MAX_CONNECTIONS; index++)
+        {
+            p_conn = app_bt_conn_get(index);
+            if (NULL == p_conn)
+            {
+                continue;
+            }
             /*GATT Throughput=(number of bytes sent/received in 1 second*8 bits) bps*/
-            gatt_notif_tx_bytes = (gatt_notif_tx_bytes * 8) / (5*1000);
-            printf("GATT NOTIFICATION : Server Throughput (TX)= %lu kbps\n", gatt_notif_tx_bytes);
-            /* Reset the GATT notification byte counter */
-            gatt_notif_tx_bytes = 0;
+            app_tput_stats_report(&p_conn->tx_stats, buckets, &tx_report);
+            app_tput_stats_report(&p_conn->rx_stats, buckets, &rx_report);
+            app_tput_stats_report(&p_conn->rd_stats, buckets, &rd_report);
+
+            /* Display GATT TX throughput result */
+            if ((p_conn->ctrl.direction & APP_TPUT_CTRL_DIR_TX) && (tx_report.bytes) &&
+                (!NOTIFY_INDICATING(p_conn)))
+            {
+                tput_task_print("GATT NOTIFICATION (TX)", &tx_report, p_conn->conn_id);
+                printf("GATT NOTIFICATION (TX): Burst %d x %d bytes, congestion %lu%% of rounds\n",
+                       p_conn->pacer.burst, p_conn->payload_size,
+                       (unsigned long)app_tput_pacer_report(&p_conn->pacer));
+            }
+            /* Display congestion episodes and what limits the TX throughput */
+            app_tput_congestion_report(&p_conn->congestion, report_ms, &cong_report);
+            if ((p_conn->ctrl.direction & APP_TPUT_CTRL_DIR_TX) && (tx_report.bytes))
+            {
+                printf("Congestion        : %lu%% of time, %lu episodes, mean %lu ms, longest %lu ms, %lu packets between\n",
+                       (unsigned long)cong_report.congested_percent, (unsigned long)cong_report.episodes,
+                       (unsigned long)cong_report.mean_ms, (unsigned long)cong_report.longest_ms,
+                       (unsigned long)cong_report.mean_packets);
+                if (0 != p_conn->congestion.episodes)
+                {
+                    app_tput_congestion_print_hist(&p_conn->congestion);
+                }
+                printf("TX limited by     : %s\n", app_tput_congestion_limit(&cong_report, &cong_buffers));
+            }
+            /* Display GATT indication throughput, confirmed bytes and the
+             * confirmation round trip time */
+            acked_kbps = tput_task_goodput(&p_conn->ind.acked, &p_conn->ind.reported_acked, report_ms);
+            app_tput_indication_report(&p_conn->ind, &ind_report);
+            if ((p_conn->ctrl.direction & APP_TPUT_CTRL_DIR_TX) && (tx_report.bytes) &&
+                (NOTIFY_INDICATING(p_conn)))
+            {
+                tput_task_print("GATT INDICATION   (TX)", &tx_report, p_conn->conn_id);
+                printf("GATT INDICATION   (TX): Acked %lu kbps, %lu confirmed, RTT mean %lu min %lu max %lu ms\n",
+                       acked_kbps, (unsigned long)ind_report.count, (unsigned long)ind_report.mean_ms,
+                       (unsigned long)ind_report.min_ms, (unsigned long)ind_report.max_ms);
+            }
+            /* Display GATT RX throughput result */
+            if ((p_conn->ctrl.direction & APP_TPUT_CTRL_DIR_RX) && (rx_report.bytes))
+            {
+                tput_task_print("GATT WRITE        (RX)", &rx_report, p_conn->conn_id);
+            }
+            /* Display GATT read throughput result */
+            if ((p_conn->ctrl.direction & APP_TPUT_CTRL_DIR_READ) && (rd_report.bytes))
+            {
+                tput_task_print("GATT READ         (RD)", &rd_report, p_conn->conn_id);
+            }
+            /* Display goodput of framed payloads, data bytes without the frame
+             * headers and, for RX, without corrupted or duplicated frames */
+            tx_good_kbps = tput_task_goodput(&p_conn->tx_frame.good, &p_conn->tx_frame.reported_good, report_ms);
+            rx_good_kbps = tput_task_goodput(&p_conn->rx_frame.good, &p_conn->rx_frame.reported_good, report_ms);
+            if (app_tput_frame_is_enabled())
+            {
+                if (tx_report.bytes)
+                {
+                    printf("GATT NOTIFICATION (TX): Goodput %lu kbps, next seq %lu\n",
+                           tx_good_kbps, (unsigned long)p_conn->tx_frame.seq);
+                }
+                if (rx_report.bytes)
+                {
+                    printf("GATT WRITE        (RX): Goodput %lu kbps, gaps %lu dup %lu reorder %lu crc %lu\n",
+                           rx_good_kbps, (unsigned long)p_conn->rx_frame.gaps,
+                           (unsigned long)p_conn->rx_frame.duplicates,
+                           (unsigned long)p_conn->rx_frame.reorders,
+                           (unsigned long)p_conn->rx_frame.crc_errors);
+                }
+            }
+            /* Display L2CAP credit based channel throughput */
+            coc_tx_kbps = tput_task_goodput(&p_conn->coc.tx_ctr, &p_conn->coc.reported_tx, report_ms);
+            coc_rx_kbps = tput_task_goodput(&p_conn->coc.rx_ctr, &p_conn->coc.reported_rx, report_ms);
+            if (0 != p_conn->coc.cid)
+            {
+                printf("L2CAP CoC    (TX/RX): %lu / %lu kbps, SDU %d bytes, congestion %lu, failures %lu [conn_id %d]\n",
+                       coc_tx_kbps, coc_rx_kbps, app_tput_coc_sdu_size(&p_conn->coc),
+                       (unsigned long)p_conn->coc.congestion_events,
+                       (unsigned long)p_conn->coc.send_failures, p_conn->conn_id);
+            }
+            /* Display prepared (long) write throughput and segment counts */
+            long_write_kbps = tput_task_goodput(&p_conn->prep_write.value_ctr,
+                                                &p_conn->prep_write.reported_bytes, report_ms);
+            if ((0 != p_conn->prep_write.segments) || (0 != p_conn->prep_write.rejected))
+            {
+                app_tput_counter_snapshot(&p_conn->prep_write.value_ctr, &long_write_snap);
+                printf("GATT LONG WRITE   (RX): %lu kbps, %lu values, %lu segments, %lu rejected, %lu cancelled [conn_id %d]\n",
+                       long_write_kbps, (unsigned long)long_write_snap.packets,
+                       (unsigned long)p_conn->prep_write.segments, (unsigned long)p_conn->prep_write.rejected,
+                       (unsigned long)p_conn->prep_write.cancelled, p_conn->conn_id);
+            }
+            /* Display the link monitor state */
+            if (p_conn->link.enabled)
+            {
+                printf("Link              : PHY %s, RSSI %d dBm, fallbacks %lu recoveries %lu\n",
+                       app_tput_link_level_name(p_conn->link.level), p_conn->link.rssi,
+                       (unsigned long)p_conn->link.fallbacks, (unsigned long)p_conn->link.recoveries);
+            }
+            total_tx_kbps += tx_report.mean_kbps;
+            total_rx_kbps += rx_report.mean_kbps;
+            total_rd_kbps += rd_report.mean_kbps;
+        }
+        /* Display GATT response buffer pool and payload ring usage */
+        if (app_bt_conn_count() > 0)
+        {
+            app_bt_buffer_pool_get_stats(&pool_stats);
+            printf("Buffer pool       : hits %lu misses %lu heap %lu in use %lu max %lu\n",
+                   (unsigned long)pool_stats.hits, (unsigned long)pool_stats.misses,
+                   (unsigned long)pool_stats.fallbacks, (unsigned long)pool_stats.in_use,
+                   (unsigned long)pool_stats.high_water);
+            app_bt_read_cache_get_stats(&cache_stats);
+            printf("Read-by-type cache: hits %lu misses %lu uncached %lu invalidated %lu\n",
+                   (unsigned long)cache_stats.hits, (unsigned long)cache_stats.misses,
+                   (unsigned long)cache_stats.uncached, (unsigned long)cache_stats.invalidations);
+            if (APP_TPUT_SINK_VALIDATOR || APP_TPUT_SINK_FORWARDER)
+            {
+                app_bt_sink_get_stats(&sink_stats);
+                printf("WriteMe sink      : checked %lu mismatches %lu, forwarded %lu dropped %lu drained %lu\n",
+                       (unsigned long)sink_stats.checked, (unsigned long)sink_stats.mismatches,
+                       (unsigned long)sink_stats.forwarded, (unsigned long)sink_stats.dropped,
+                       (unsigned long)sink_stats.drained);
+            }
+            printf("Payload ring      : pattern %d, underruns %lu\n",
+                   app_tput_payload_get_pattern(), (unsigned long)app_tput_payload_get_underruns());
+            printf("TX buffers        : free min %lu mean %lu, notify task blocked %lu ms\n",
+                   (unsigned long)cong_buffers.min_free, (unsigned long)cong_buffers.mean_free,
+                   (unsigned long)cong_buffers.blocked_ms);
         }
-        /* Display GATT RX throughput result */
-        if (conn_state_info.conn_id && gatt_write_rx_bytes)
+        /* Display the server latency of the Ping probes */
+        app_tput_ping_report();
+        /* Display aggregate throughput when more than one client is connected */
+        if (app_bt_conn_count() > 1)
         {
-            /*GATT Throughput=(number of bytes sent/received in 1 second*8 bits ) bps*/
-            gatt_write_rx_bytes = (gatt_write_rx_bytes * 8) / (5*1000);
-            printf("GATT WRITE        : Server Throughput (RX)= %lu kbps\n", gatt_write_rx_bytes);
-            /* Reset the GATT write byte counter */
-            gatt_write_rx_bytes = 0;
+            printf("GATT NOTIFICATION (TX): Aggregate Throughput = %lu kbps\n", total_tx_kbps);
+            printf("GATT WRITE        (RX): Aggregate Throughput = %lu kbps\n", total_rx_kbps);
+            printf("GATT READ         (RD): Aggregate Throughput = %lu kbps\n", total_rd_kbps);
         }
-        cy_rtos_semaphore_set(&semaphore);
-        tput_fun = 0;
     }
 }
 
@@ -653,7 +1001,19 @@ void tput_task(cy_thread_arg_t arg){
  Notify_task
 
  Function Description:
- @brief  This task send notifications when the semaphore is set by sema_set_task
+ @brief  This task sends notifications to every client that enabled them and
+         is otherwise driven by the NOTIFY_EVT_* events: it sleeps without a
+         timeout while no client has notifications enabled and wakes up as soon
+         as a CCCD write, a connection change, a congestion clear or a
+         shutdown is signalled. Notification bursts are shared between the connected clients with a
+         deficit round robin scheduler: every client with notifications enabled
+         earns its current burst worth of bytes per round and spends them while
+         the stack accepts notifications. A congested client is skipped, so it
+         does not hold back the others; the task only blocks on the congestion
+         semaphore when every streaming client is congested. The burst of each
+         client is paced by app_tput_pacer, and the delay between rounds is
+         skipped while a round went through cleanly and the controller still
+         has free TX buffers.
 
  @param  cy_thread_arg_t: unused
 
@@ -662,35 +1022,206 @@ void tput_task(cy_thread_arg_t arg){
 void notify_task(cy_thread_arg_t arg)
 {
     wiced_bt_gatt_status_t status = WICED_BT_GATT_SUCCESS;
+    conn_state_info_t *p_conn;
+    uint8_t streaming, blocked;
+    wiced_bool_t clean_round, starved, link_starved;
+    cy_time_t blocked_start = 0, blocked_end = 0;
+    uint32_t events = 0;
 
-    while(true)
+    while(!(events & NOTIFY_EVT_SHUTDOWN))
     {
-        if(tput_fun == 1){
-            cy_rtos_semaphore_get(&semaphore, CY_RTOS_NEVER_TIMEOUT);
-        }
-        if (app_throughput_measurement_notify_client_char_config[0] & GATT_CLIENT_CONFIG_NOTIFICATION)
+        /* Apply the Control commands queued since the last round */
+        app_tput_ctrl_process();
+
+        streaming = 0;
+        blocked = 0;
+        clean_round = WICED_FALSE;
+        starved = WICED_FALSE;
+        for (uint8_t index = 0; index < APP_BT_MAX_CONNECTIONS; index++)
         {
-            for(int i=0; i<PACKET_PER_EVENT; i++)
+            p_conn = app_bt_conn_get(index);
+            if ((NULL == p_conn) || !NOTIFY_STREAMING(p_conn))
+            {
+                continue;
+            }
+            streaming++;
+            if ((p_conn->congested) || (p_conn->ind.in_flight))
             {
-                status = wiced_bt_gatt_server_send_notification(conn_state_info.conn_id,
-                                                            HDLC_THROUGHPUT_MEASUREMENT_NOTIFY_VALUE,
-                                                            NOTIFICATION_DATA_SIZE,
-                                                            notification_data_seq, NULL);
+                blocked++;
+                continue;
+            }
+            link_starved = WICED_FALSE;
+            /* Credit left over from a congested round is capped to one quantum */
+            p_conn->deficit = MIN(p_conn->deficit, NOTIFY_QUANTUM(p_conn)) + NOTIFY_QUANTUM(p_conn);
+            while (p_conn->deficit >= p_conn->payload_size)
+            {
+                status = notify_task_send(p_conn);
                 if(WICED_BT_GATT_SUCCESS == status)
                 {
-                    gatt_notif_tx_bytes += NOTIFICATION_DATA_SIZE;
+                    app_tput_counter_add(&p_conn->tx_ctr, p_conn->payload_size);
+                    __atomic_store_n(&p_conn->tx_packets, p_conn->tx_packets + 1u, __ATOMIC_RELAXED);
+                    p_conn->deficit -= p_conn->payload_size;
+                    if (NOTIFY_INDICATING(p_conn))
+                    {
+                        /* One indication outstanding, wait for its confirmation */
+                        break;
+                    }
+                }
+                else if (WICED_BT_GATT_NO_RESOURCES == status)
+                {
+                    /* Payload ring empty, let the generator task run. Not a
+                     * send failure and says nothing about the link. */
+                    starved = WICED_TRUE;
+                    link_starved = WICED_TRUE;
+                    break;
                 }
-                 if(WICED_BT_GATT_CONGESTED == status)
+                else
                 {
-                    cy_rtos_semaphore_get(&congestion, CY_RTOS_NEVER_TIMEOUT);
+                    p_conn->send_failures++;
+                    if(WICED_BT_GATT_CONGESTED == status)
+                    {
+                        p_conn->congested = WICED_TRUE;
+                    }
+                    break;
                 }
             }
-            cy_rtos_delay_milliseconds(10);
+            /* Indications are paced by their confirmations, not the burst */
+            if ((!link_starved) && (!NOTIFY_INDICATING(p_conn)))
+            {
+                app_tput_pacer_on_round(&p_conn->pacer, p_conn->congested);
+            }
+            if (!p_conn->congested)
+            {
+                clean_round = WICED_TRUE;
+            }
+        }
+
+        events = 0;
+        if (0 == streaming)
+        {
+            /* Nothing to send, sleep until a client enables notifications */
+            events = notify_task_wait(CY_RTOS_NEVER_TIMEOUT);
         }
-        else{
-            cy_rtos_delay_milliseconds(100);
+        else if (blocked == streaming)
+        {
+            /* Every client is congested, wait for one of them to recover. Time
+             * out and retry in case a congestion clear raced with the send. */
+            cy_rtos_get_time(&blocked_start);
+            events = notify_task_wait(NOTIFY_CONGESTION_TIMEOUT_MS);
+            cy_rtos_get_time(&blocked_end);
+            app_tput_congestion_add_blocked((uint32_t)(blocked_end - blocked_start));
+            if (0 == events)
+            {
+                for (uint8_t index = 0; index < APP_BT_MAX_CONNECTIONS; index++)
+                {
+                    if (NULL != (p_conn = app_bt_conn_get(index)))
+                    {
+                        p_conn->congested = WICED_FALSE;
+                    }
+                }
+            }
+        }
+        else if ((!clean_round) || (starved) ||
+                 (wiced_bt_ble_get_available_tx_buffers() < APP_TPUT_PACER_HEADROOM_BUFFERS))
+        {
+            events = notify_task_wait(NOTIFY_BURST_DELAY_MS);
+        }
+
+        if (events & NOTIFY_EVT_CONN_DOWN)
+        {
+            /* Second phase of app_bt_conn_free: no slot pointer is held here */
+            app_bt_conn_reclaim();
+        }
+    }
+
+    cy_rtos_exit_thread();
+}
+
+/*
+ Function name:
+ notify_task_send
+
+ Function Description:
+ @brief  Sends one notification, or indication when the client selected
+         indications, of payload_size bytes to a client from the next
+         pre-generated payload buffer, which the stack releases once
+         transmitted. Framed payloads get their header written here.
+
+ @param  p_conn: client to send to
+
+ @return wiced_bt_gatt_status_t: status of the send, WICED_BT_GATT_NO_RESOURCES
+         if no payload buffer is ready
+ */
+static wiced_bt_gatt_status_t notify_task_send(conn_state_info_t *p_conn)
+{
+    wiced_bt_gatt_status_t status;
+    uint16_t len = p_conn->payload_size;
+    wiced_bool_t framed = app_tput_frame_is_enabled() && (len >= APP_TPUT_FRAME_HDR_LEN);
+    cy_time_t now = 0;
+    uint8_t *p_payload;
+
+    p_payload = app_tput_payload_take();
+    if (NULL == p_payload)
+    {
+        return WICED_BT_GATT_NO_RESOURCES;
+    }
+    if (framed)
+    {
+        cy_rtos_get_time(&now);
+        app_tput_frame_encode(&p_conn->tx_frame, p_payload, len, (uint32_t)now);
+    }
+
+    if (NOTIFY_INDICATING(p_conn))
+    {
+        /* Marked in flight before the send, the confirmation may arrive
+         * before the send returns */
+        app_tput_indication_sent(&p_conn->ind, len);
+        status = wiced_bt_gatt_server_send_indication(p_conn->conn_id,
+                                                      HDLC_THROUGHPUT_MEASUREMENT_NOTIFY_VALUE,
+                                                      len, p_payload, (void *)app_tput_payload_release);
+        if (WICED_BT_GATT_SUCCESS != status)
+        {
+            p_conn->ind.in_flight = WICED_FALSE;
         }
     }
+    else
+    {
+        status = wiced_bt_gatt_server_send_notification(p_conn->conn_id,
+                                                        HDLC_THROUGHPUT_MEASUREMENT_NOTIFY_VALUE,
+                                                        len, p_payload, (void *)app_tput_payload_release);
+    }
+    if (WICED_BT_GATT_SUCCESS != status)
+    {
+        app_tput_payload_release(p_payload);
+    }
+    else if (framed)
+    {
+        app_tput_frame_sent(&p_conn->tx_frame, len);
+    }
+    return status;
+}
+
+/*
+ Function name:
+ notify_task_wait
+
+ Function Description:
+ @brief  Blocks notify_task until one of the NOTIFY_EVT_* events is signalled
+         or the timeout expires. The events are cleared on return.
+
+ @param  timeout: maximum wait time in milliseconds or CY_RTOS_NEVER_TIMEOUT
+
+ @return uint32_t: events signalled, 0 on timeout
+ */
+static uint32_t notify_task_wait(cy_time_t timeout)
+{
+    uint32_t events = NOTIFY_EVT_ALL;
+
+    if (CY_RSLT_SUCCESS != cy_rtos_event_waitbits(&notify_events, &events, true, false, timeout))
+    {
+        events = 0;
+    }
+    return events;
 }
 
 /**
@@ -709,6 +1240,11 @@ static wiced_bt_gatt_status_t app_bt_gatt_event_callback(wiced_bt_gatt_evt_t eve
                                                          wiced_bt_gatt_event_data_t *p_event_data)
 {
     wiced_bt_gatt_status_t status = WICED_BT_GATT_ERROR;
+    conn_state_info_t *p_conn = NULL;
+    APP_TPUT_TRACE_ENTER(trace_start);
+
+    /* Start of the latency of a Ping probe */
+    app_tput_ping_mark_entry();
 
     /* Call the appropriate callback function based on the GATT event type,
      * and pass the relevant event
@@ -743,9 +1279,27 @@ static wiced_bt_gatt_status_t app_bt_gatt_event_callback(wiced_bt_gatt_evt_t eve
         break;
 
     case GATT_CONGESTION_EVT:
+        p_conn = app_bt_conn_find(p_event_data->congestion.conn_id);
+        if (NULL != p_conn)
+        {
+            /* tx_packets is a single word, unlike the tx_ctr snapshot its
+             * read never waits for notify_task */
+            uint32_t tx_packets = __atomic_load_n(&p_conn->tx_packets, __ATOMIC_RELAXED);
+
+            p_conn->congested = p_event_data->congestion.congested;
+            if (p_conn->congested)
+            {
+                p_conn->congestion_events++;
+                app_tput_congestion_begin(&p_conn->congestion, tx_packets);
+            }
+            else
+            {
+                app_tput_congestion_end(&p_conn->congestion, tx_packets);
+            }
+        }
         if(!p_event_data->congestion.congested)
         {
-            cy_rtos_semaphore_set(&congestion);
+            cy_rtos_event_setbits(&notify_events, NOTIFY_EVT_CONGESTION_CLEARED);
         }
         status = WICED_BT_GATT_SUCCESS;
         break;
@@ -756,6 +1310,7 @@ static wiced_bt_gatt_status_t app_bt_gatt_event_callback(wiced_bt_gatt_evt_t eve
         break;
     }
 
+    APP_TPUT_TRACE_EXIT(APP_TPUT_TRACE_GATT_EVENT, event, trace_start);
     return status;
 }
 
@@ -776,6 +1331,8 @@ static wiced_bt_gatt_status_t app_bt_connect_event_handler (wiced_bt_gatt_connec
 {
     wiced_bt_gatt_status_t status = WICED_BT_GATT_ERROR;
     wiced_result_t result;
+    conn_state_info_t *p_conn;
+    wiced_bt_ble_conn_params_t conn_params;
 
     if (NULL != p_conn_status)
     {
@@ -785,23 +1342,33 @@ static wiced_bt_gatt_status_t app_bt_connect_event_handler (wiced_bt_gatt_connec
             printf("Connected : BDA ");
             print_bd_address(p_conn_status->bd_addr);
             printf("Packets %d\n",PACKET_PER_EVENT);
-            /* Store the connection ID and peer BD Address */
-            conn_state_info.conn_id = p_conn_status->conn_id;
+            printf("Connection ID:  %d\n",p_conn_status->conn_id);
 
-            printf("Connection ID:  %d\n",conn_state_info.conn_id);
-            memcpy(conn_state_info.remote_addr, p_conn_status->bd_addr, BD_ADDR_LEN);
+            /* Save BT connection ID and peer ADDRESS in application data structure */
+            p_conn = app_bt_conn_alloc(p_conn_status->conn_id, p_conn_status->bd_addr);
+            if (NULL == p_conn)
+            {
+                printf("No free connection slot, disconnecting\n");
+                wiced_bt_gatt_disconnect(p_conn_status->conn_id);
+                return WICED_BT_GATT_SUCCESS;
+            }
+
+            /* Interval chosen by the central, until a parameter update */
+            if (wiced_bt_ble_get_connection_parameters(p_conn->remote_addr, &conn_params))
+            {
+                p_conn->conn_interval = conn_params.conn_interval * CONN_INTERVAL_MULTIPLIER;
+            }
+
+            app_tput_pacer_init(&p_conn->pacer);
+            cy_rtos_event_setbits(&notify_events, NOTIFY_EVT_CONN_UP);
 
             /* Update the adv/conn state */
             app_bt_adv_conn_state = APP_BT_ADV_OFF_CONN_ON;
-            /* Save BT connection ID in application data structure */
-            conn_state_info.conn_id = p_conn_status->conn_id;
-            /* Save BT peer ADDRESS in application data structure */
-            memcpy(conn_state_info.remote_addr, p_conn_status->bd_addr, BD_ADDR_LEN);
             wiced_bt_ble_phy_preferences_t phy_preferences;
 
-            phy_preferences.rx_phys = BTM_BLE_PREFER_2M_PHY;
-            phy_preferences.tx_phys = BTM_BLE_PREFER_2M_PHY;
-            memcpy(phy_preferences.remote_bd_addr, conn_state_info.remote_addr, BD_ADDR_LEN);
+            phy_preferences.rx_phys = p_conn->ctrl.phy & APP_TPUT_CTRL_PHY_MASK;
+            phy_preferences.tx_phys = p_conn->ctrl.phy & APP_TPUT_CTRL_PHY_MASK;
+            memcpy(phy_preferences.remote_bd_addr, p_conn->remote_addr, BD_ADDR_LEN);
 
             result = wiced_bt_ble_set_phy(&phy_preferences);
 
@@ -810,11 +1377,31 @@ static wiced_bt_gatt_status_t app_bt_connect_event_handler (wiced_bt_gatt_connec
                 printf("Failed to send request to switch PHY %d\n",result);
             }
 
+            /* Request LE data length extension so that one LL PDU carries a
+             * full notification */
+            result = wiced_bt_ble_set_data_packet_length(p_conn->remote_addr,
+                                                         APP_TPUT_DLE_TX_OCTETS,
+                                                         APP_TPUT_DLE_TX_TIME);
+            if (result != WICED_BT_SUCCESS)
+            {
+                printf("Failed to send data length update request %d\n",result);
+            }
+
             if (CY_RSLT_SUCCESS != cyhal_timer_start(&tput_timer_obj))
             {
                 printf("Throughput timer start failed !");
                 CY_ASSERT(0);
             }
+
+            /* Keep advertising while more clients can connect */
+            if (app_bt_conn_count() < APP_BT_MAX_CONNECTIONS)
+            {
+                result = wiced_bt_start_advertisements(BTM_BLE_ADVERT_UNDIRECTED_HIGH, 0, NULL);
+                if (WICED_BT_SUCCESS != result)
+                {
+                    printf( "Advertisement cannot start because of error: %d \n", result);
+                }
+            }
         }
         else
         {
@@ -824,25 +1411,35 @@ static wiced_bt_gatt_status_t app_bt_connect_event_handler (wiced_bt_gatt_connec
             printf("Connection ID '%d', Reason '%s'\n",p_conn_status->conn_id,
                                     get_bt_gatt_disconn_reason_name(p_conn_status->reason));
 
-            /* Reset the connection information */
-            memset(&conn_state_info, 0u, sizeof(conn_state_info));
+            /* Release the connection information, notify_task resets it */
+            app_bt_conn_free(app_bt_conn_find(p_conn_status->conn_id));
+
+            /* Wake up notify_task to reset the slot, and in case it waits for
+             * this client to recover from congestion */
+            cy_rtos_event_setbits(&notify_events, NOTIFY_EVT_CONN_DOWN);
 
-            if (CY_RSLT_SUCCESS != cyhal_timer_stop(&tput_timer_obj))
+            if ((0 == app_bt_conn_count()) &&
+                (CY_RSLT_SUCCESS != cyhal_timer_stop(&tput_timer_obj)))
             {
                 printf("Throughput timer stop failed !");
                 CY_ASSERT(0);
             }
 
-            /* Restart the advertisements */
-            result = wiced_bt_start_advertisements(BTM_BLE_ADVERT_UNDIRECTED_HIGH, 0, NULL);
-            if (WICED_BT_SUCCESS != result)
+            /* Restart the advertisements if they were stopped */
+            if ((APP_BT_ADV_ON_CONN_OFF != app_bt_adv_conn_state) &&
+                (APP_BT_ADV_ON_CONN_ON != app_bt_adv_conn_state))
             {
-                printf( "Advertisement cannot start because of error: %d \n", result);
-                CY_ASSERT(0);
+                result = wiced_bt_start_advertisements(BTM_BLE_ADVERT_UNDIRECTED_HIGH, 0, NULL);
+                if (WICED_BT_SUCCESS != result)
+                {
+                    printf( "Advertisement cannot start because of error: %d \n", result);
+                    CY_ASSERT(0);
+                }
             }
 
             /* Update the adv/conn state */
-            app_bt_adv_conn_state = APP_BT_ADV_ON_CONN_OFF;
+            app_bt_adv_conn_state = (0 == app_bt_conn_count()) ? APP_BT_ADV_ON_CONN_OFF :
+                                                                 APP_BT_ADV_ON_CONN_ON;
         }
 
         status = WICED_BT_GATT_SUCCESS;
@@ -867,6 +1464,8 @@ static wiced_bt_gatt_status_t app_bt_server_event_handler (wiced_bt_gatt_event_d
 {
     wiced_bt_gatt_status_t status = WICED_BT_GATT_ERROR;
     wiced_bt_gatt_attribute_request_t   *p_att_req = &p_data->attribute_request;
+    conn_state_info_t *p_conn = NULL;
+    APP_TPUT_TRACE_ENTER(trace_start);
 
     switch (p_att_req->opcode)
     {
@@ -898,15 +1497,39 @@ static wiced_bt_gatt_status_t app_bt_server_event_handler (wiced_bt_gatt_event_d
         }
         break;
 
+    case GATT_REQ_PREPARE_WRITE:
+        status = app_bt_prepare_write_handler(p_att_req->conn_id, p_att_req->opcode,
+                                              &p_att_req->data.write_req);
+        break;
+
+    case GATT_REQ_EXECUTE_WRITE:
+        status = app_bt_execute_write_handler(p_att_req->conn_id, p_att_req->opcode,
+                                              p_att_req->data.exec_write_req);
+        break;
+
     case GATT_REQ_MTU:
-    	printf("\rClient MTU: %d\n", p_att_req->data.remote_mtu);
+        app_log_write(APP_LOG_CLIENT_MTU, p_att_req->data.remote_mtu, p_att_req->conn_id, 0);
         /* Application calls wiced_bt_gatt_server_send_mtu_rsp() with the desired mtu */
         status = wiced_bt_gatt_server_send_mtu_rsp(p_att_req->conn_id,
                                                    p_att_req->data.remote_mtu,
                                                    wiced_bt_cfg_settings.p_ble_cfg->ble_max_rx_pdu_size);
+        /* The negotiated MTU is the smaller of the two, size the notifications from it */
+        p_conn = app_bt_conn_find(p_att_req->conn_id);
+        if (NULL != p_conn)
+        {
+            p_conn->mtu = MIN(p_att_req->data.remote_mtu,
+                              wiced_bt_cfg_settings.p_ble_cfg->ble_max_rx_pdu_size);
+            app_bt_conn_update_payload_size(p_conn);
+        }
         break;
 
     case GATT_HANDLE_VALUE_CONF:
+        p_conn = app_bt_conn_find(p_att_req->conn_id);
+        if (NULL != p_conn)
+        {
+            app_tput_indication_confirmed(&p_conn->ind);
+            cy_rtos_event_setbits(&notify_events, NOTIFY_EVT_CONFIRMED);
+        }
         status = WICED_BT_GATT_SUCCESS;
         break;
 
@@ -918,6 +1541,7 @@ static wiced_bt_gatt_status_t app_bt_server_event_handler (wiced_bt_gatt_event_d
         status = WICED_BT_GATT_SUCCESS;
         break;
     }
+    APP_TPUT_TRACE_EXIT(APP_TPUT_TRACE_ATT_REQUEST, p_att_req->opcode, trace_start);
     return status;
 }
 
@@ -937,13 +1561,104 @@ static wiced_bt_gatt_status_t app_bt_server_event_handler (wiced_bt_gatt_event_d
 static wiced_bt_gatt_status_t app_bt_write_handler(wiced_bt_gatt_event_data_t *p_data)
 {
     wiced_bt_gatt_write_req_t *p_write_req = &p_data->attribute_request.data.write_req;
+    wiced_bt_gatt_status_t status;
+    APP_TPUT_TRACE_ENTER(trace_start);
 
     CY_ASSERT(( NULL != p_data ) && (NULL != p_write_req));
 
-    return app_bt_set_value(p_write_req->handle,
+    status = app_bt_set_value(p_data->attribute_request.conn_id,
+                                    p_write_req->handle,
                                     p_write_req->p_val,
                                     p_write_req->val_len);
 
+    APP_TPUT_TRACE_EXIT(APP_TPUT_TRACE_WRITE, p_write_req->handle, trace_start);
+    return status;
+}
+
+/**
+ * Function Name:
+ * app_bt_prepare_write_handler
+ *
+ * Function Description:
+ * @brief  Queues a prepared write segment in the reassembly arena of the
+ *         client and echoes it back from there
+ *
+ * @param conn_id      Connection ID of the client writing the segment
+ * @param opcode       Bluetooth LE GATT request type opcode
+ * @param p_write_req  prepared write request
+ *
+ * @return wiced_bt_gatt_status_t  Bluetooth LE GATT status
+ */
+static wiced_bt_gatt_status_t app_bt_prepare_write_handler(uint16_t conn_id,
+                                                           wiced_bt_gatt_opcode_t opcode,
+                                                           wiced_bt_gatt_write_req_t *p_write_req)
+{
+    conn_state_info_t *p_conn = app_bt_conn_find(conn_id);
+    gatt_db_lookup_table_t *p_attr = app_bt_attr_find(p_write_req->handle);
+    const app_bt_attr_write_t *p_write = app_bt_attr_get_write(p_write_req->handle);
+    wiced_bt_gatt_status_t status;
+    uint8_t *p_segment = NULL;
+
+    if ((NULL == p_conn) || (NULL == p_attr) || (NULL == p_write))
+    {
+        return WICED_BT_GATT_INVALID_HANDLE;
+    }
+
+    /* Streamed values are bounded by the attribute length like stored ones */
+    status = app_bt_prep_write_queue(&p_conn->prep_write, p_write_req->handle, p_write_req->offset,
+                                     p_write_req->p_val, p_write_req->val_len, p_attr->max_len, &p_segment);
+    if (WICED_BT_GATT_SUCCESS != status)
+    {
+        return status;
+    }
+
+    /* The arena is not written again before the client sends its next request */
+    return wiced_bt_gatt_server_send_prepare_write_rsp(conn_id, opcode, p_write_req->handle,
+                                                       p_write_req->offset, p_write_req->val_len,
+                                                       p_segment, NULL);
+}
+
+/**
+ * Function Name:
+ * app_bt_execute_write_handler
+ *
+ * Function Description:
+ * @brief  Writes the value assembled from the queued segments, in place from
+ *         the arena, or drops the queue when the client cancels it
+ *
+ * @param conn_id      Connection ID of the client
+ * @param opcode       Bluetooth LE GATT request type opcode
+ * @param exec_flag    GATT_PREPARE_WRITE_EXEC or GATT_PREPARE_WRITE_CANCEL
+ *
+ * @return wiced_bt_gatt_status_t  Bluetooth LE GATT status
+ */
+static wiced_bt_gatt_status_t app_bt_execute_write_handler(uint16_t conn_id,
+                                                           wiced_bt_gatt_opcode_t opcode,
+                                                           wiced_bt_gatt_exec_flag_t exec_flag)
+{
+    conn_state_info_t *p_conn = app_bt_conn_find(conn_id);
+    app_bt_prep_write_t *p_prep;
+    wiced_bt_gatt_status_t status = WICED_BT_GATT_SUCCESS;
+    wiced_bool_t written = WICED_FALSE;
+
+    if (NULL == p_conn)
+    {
+        return WICED_BT_GATT_ERROR;
+    }
+
+    p_prep = &p_conn->prep_write;
+    if ((GATT_PREPARE_WRITE_EXEC == exec_flag) && (0 != p_prep->handle))
+    {
+        status = app_bt_set_value(conn_id, p_prep->handle, app_bt_prep_write_value(p_prep), p_prep->len);
+        written = (WICED_BT_GATT_SUCCESS == status) ? WICED_TRUE : WICED_FALSE;
+    }
+    app_bt_prep_write_finish(p_prep, written);
+
+    if (WICED_BT_GATT_SUCCESS != status)
+    {
+        return status;
+    }
+    return wiced_bt_gatt_server_send_execute_write_rsp(conn_id, opcode);
 }
 
 /**
@@ -952,97 +1667,148 @@ static wiced_bt_gatt_status_t app_bt_write_handler(wiced_bt_gatt_event_data_t *p
  *
  * Function Description:
  * @brief  The function is invoked by app_bt_write_handler to set a value
- *         to GATT DB.
+ *         to GATT DB and run the write handler registered for the handle.
  *
+ * @param conn_id      Connection ID of the client writing the value
  * @param attr_handle  GATT attribute handle
  * @param p_val        Pointer to Bluetooth LE GATT write request value
  * @param len          length of GATT write request
  *
  * @return wiced_bt_gatt_status_t  Bluetooth LE GATT status
  */
-static wiced_bt_gatt_status_t app_bt_set_value(uint16_t attr_handle, uint8_t *p_val,
-                                               uint16_t len)
+static wiced_bt_gatt_status_t app_bt_set_value(uint16_t conn_id, uint16_t attr_handle,
+                                               uint8_t *p_val, uint16_t len)
 {
-    wiced_bt_gatt_status_t status = WICED_BT_GATT_INVALID_HANDLE;
+    wiced_bt_gatt_status_t status = WICED_BT_GATT_SUCCESS;
+    gatt_db_lookup_table_t *p_attr = app_bt_attr_find(attr_handle);
+    const app_bt_attr_write_t *p_write = app_bt_attr_get_write(attr_handle);
 
-    for (int i = 0; i < app_gatt_db_ext_attr_tbl_size; i++)
+    if ((NULL == p_attr) || (NULL == p_write))
     {
-        /* Check for a matching handle entry */
-        if (app_gatt_db_ext_attr_tbl[i].handle == attr_handle)
-        {
-            /* Detected a matching handle in the external lookup table */
-            if (app_gatt_db_ext_attr_tbl[i].max_len >= len)
-            {
-                /* Value fits within the supplied buffer; copy over the value */
-                app_gatt_db_ext_attr_tbl[i].cur_len = len;
-                memset(app_gatt_db_ext_attr_tbl[i].p_data, 0x00, app_gatt_db_ext_attr_tbl[i].max_len);
-                memcpy(app_gatt_db_ext_attr_tbl[i].p_data, p_val, app_gatt_db_ext_attr_tbl[i].cur_len);
-
-                if (memcmp(app_gatt_db_ext_attr_tbl[i].p_data, p_val, app_gatt_db_ext_attr_tbl[i].cur_len) == 0)
-                {
-                    status = WICED_BT_GATT_SUCCESS;
-                }
+        status = WICED_BT_GATT_INVALID_HANDLE;
+    }
+    else if (p_attr->max_len < len)
+    {
+        /* Value to write will not fit within the table */
+        status = WICED_BT_GATT_INVALID_ATTR_LEN;
+    }
+    else if (p_write->flags & APP_BT_ATTR_WRITE_SINK)
+    {
+        /* Streamed value, consumed from the stack buffer */
+        status = p_write->p_cb(conn_id, p_attr, p_val, len);
+    }
+    else
+    {
+        /* Value fits within the supplied buffer; copy over the value */
+        p_attr->cur_len = len;
+        memcpy(p_attr->p_data, p_val, len);
+        memset(&p_attr->p_data[len], 0x00, p_attr->max_len - len);
+        app_bt_read_cache_invalidate(attr_handle);
 
-                if(app_gatt_db_ext_attr_tbl[i].handle == HDLD_THROUGHPUT_MEASUREMENT_NOTIFY_CLIENT_CHAR_CONFIG)
-                {
-                    if (GATT_CLIENT_CONFIG_NOTIFICATION == app_throughput_measurement_notify_client_char_config[0])
-                    {
-                        printf("Notifications Enabled\n");
-                        gatt_write_rx_bytes = 0;
-                    }
-                    else
-                    {
-                        printf("Notifications Disabled\n");
-                        gatt_notif_tx_bytes = 0;
-                    }
-                }
-                if(app_gatt_db_ext_attr_tbl[i].handle == HDLC_THROUGHPUT_MEASUREMENT_WRITEME_VALUE)
-                {
-                    /* Receive GATT write commands from client
-                        * and update the counter with number of
-                        * bytes received.
-                        */
-                    gatt_write_rx_bytes += len;
-                    status = WICED_BT_GATT_SUCCESS;
-                }
-            }
-            else
-            {
-                /* Value to write will not fit within the table */
-                status = WICED_BT_GATT_INVALID_ATTR_LEN;
-            }
-            break;
+        if (NULL != p_write->p_cb)
+        {
+            status = p_write->p_cb(conn_id, p_attr, p_val, len);
         }
     }
+
     if (WICED_BT_GATT_SUCCESS != status)
     {
-        printf( "%s() FAILED %d \n", __func__, status);
+        app_log_write(APP_LOG_SET_VALUE_FAILED, status, attr_handle, 0);
     }
     return status;
 }
 
 /**
  * Function Name:
- * app_bt_find_by_handle
+ * app_bt_notify_cccd_write_handler
  *
  * Function Description:
- * @brief  Find attribute description by handle
+ * @brief  Write handler of the Notify characteristic CCCD. The CCCD is kept
+ *         per client, the GATT DB only holds the value last written by any
+ *         client.
  *
- * @param handle    handle to look up
+ * @param conn_id      Connection ID of the client writing the value
+ * @param p_attr       attribute written
+ * @param p_val        written value
+ * @param len          length of the written value
  *
- * @return gatt_db_lookup_table_t   pointer containing handle data
+ * @return wiced_bt_gatt_status_t  Bluetooth LE GATT status
  */
-static gatt_db_lookup_table_t *app_bt_find_by_handle(uint16_t handle)
+static wiced_bt_gatt_status_t app_bt_notify_cccd_write_handler(uint16_t conn_id,
+                                                               gatt_db_lookup_table_t *p_attr,
+                                                               uint8_t *p_val, uint16_t len)
 {
-    int i;
-    for (i = 0; i < app_gatt_db_ext_attr_tbl_size; i++)
+    conn_state_info_t *p_conn = app_bt_conn_find(conn_id);
+
+    if (NULL == p_conn)
     {
-        if (app_gatt_db_ext_attr_tbl[i].handle == handle)
+        return WICED_BT_GATT_SUCCESS;
+    }
+
+    p_conn->cccd = p_attr->p_data[0];
+    if (p_conn->cccd & (GATT_CLIENT_CONFIG_NOTIFICATION | GATT_CLIENT_CONFIG_INDICATION))
+    {
+        app_log_write(NOTIFY_INDICATING(p_conn) ? APP_LOG_CCCD_INDICATIONS : APP_LOG_CCCD_ENABLED,
+                      conn_id, 0, 0);
+        cy_rtos_event_setbits(&notify_events, NOTIFY_EVT_CCCD_ENABLED);
+        if (APP_TPUT_AUTOTUNE_ON_CONNECT && (APP_TPUT_AUTOTUNE_IDLE == p_conn->autotune.state))
         {
-            return (&app_gatt_db_ext_attr_tbl[i]);
+            p_conn->autotune.request = APP_TPUT_AUTOTUNE_REQ_START;
         }
     }
-    return NULL;
+    else
+    {
+        app_log_write(APP_LOG_CCCD_DISABLED, conn_id, 0, 0);
+        cy_rtos_event_setbits(&notify_events, NOTIFY_EVT_CCCD_DISABLED);
+    }
+    return WICED_BT_GATT_SUCCESS;
+}
+
+/**
+ * Function Name:
+ * app_bt_writeme_write_handler
+ *
+ * Function Description:
+ * @brief  Write handler of the WriteMe characteristic. Passes the GATT
+ *         write commands received from the client to the sink consumers,
+ *         which count the bytes received.
+ *
+ * @param conn_id      Connection ID of the client writing the value
+ * @param p_attr       attribute written
+ * @param p_val        written value
+ * @param len          length of the written value
+ *
+ * @return wiced_bt_gatt_status_t  Bluetooth LE GATT status
+ */
+static wiced_bt_gatt_status_t app_bt_writeme_write_handler(uint16_t conn_id,
+                                                           gatt_db_lookup_table_t *p_attr,
+                                                           uint8_t *p_val, uint16_t len)
+{
+    app_bt_sink_consume(conn_id, p_val, len);
+    return WICED_BT_GATT_SUCCESS;
+}
+
+/**
+ * Function Name:
+ * app_bt_control_write_handler
+ *
+ * Function Description:
+ * @brief  Write handler of the Control characteristic. Checks the test run
+ *         commands of the client and queues them for notify_task, which
+ *         applies them.
+ *
+ * @param conn_id      Connection ID of the client writing the value
+ * @param p_attr       attribute written
+ * @param p_val        written value
+ * @param len          length of the written value
+ *
+ * @return wiced_bt_gatt_status_t  Bluetooth LE GATT status
+ */
+static wiced_bt_gatt_status_t app_bt_control_write_handler(uint16_t conn_id,
+                                                           gatt_db_lookup_table_t *p_attr,
+                                                           uint8_t *p_val, uint16_t len)
+{
+    return app_tput_ctrl_submit(conn_id, p_val, len);
 }
 
 /**
@@ -1065,28 +1831,76 @@ static wiced_bt_gatt_status_t app_bt_gatt_req_read_handler(uint16_t conn_id,
                                                            uint16_t len_requested)
 {
     gatt_db_lookup_table_t *puAttribute;
+    conn_state_info_t *p_conn;
     uint16_t attr_len_to_copy, to_send;
     uint8_t *from;
+    static uint8_t cccd[2];
 
-    if ((puAttribute = app_bt_find_by_handle(p_read_req->handle)) == NULL)
+    if ((puAttribute = app_bt_attr_find(p_read_req->handle)) == NULL)
     {
         wiced_bt_gatt_server_send_error_rsp(conn_id, opcode, p_read_req->handle,
                                             WICED_BT_GATT_INVALID_HANDLE);
         return WICED_BT_GATT_INVALID_HANDLE;
     }
 
+    /* In read mode the Notify value is generated from the offset and each
+     * response is counted as read throughput */
+    p_conn = app_bt_conn_find(conn_id);
+    if ((HDLC_THROUGHPUT_MEASUREMENT_NOTIFY_VALUE == p_read_req->handle) && (NULL != p_conn) &&
+        (p_conn->ctrl.direction & APP_TPUT_CTRL_DIR_READ))
+    {
+        if (p_read_req->offset >= puAttribute->max_len)
+        {
+            wiced_bt_gatt_server_send_error_rsp(conn_id, opcode, p_read_req->handle, WICED_BT_GATT_INVALID_OFFSET);
+            return WICED_BT_GATT_INVALID_OFFSET;
+        }
+        to_send = MIN(MIN(len_requested, puAttribute->max_len - p_read_req->offset), APP_TPUT_READ_WINDOW_LEN);
+        app_tput_counter_add(&p_conn->rd_ctr, to_send);
+        return wiced_bt_gatt_server_send_read_handle_rsp(conn_id, opcode, to_send,
+                                                         (uint8_t *)app_tput_read_window(p_read_req->offset),
+                                                         NULL); /* Constant table, nothing to free */
+    }
+
     attr_len_to_copy = puAttribute->cur_len;
-    printf("read_handler: conn_id:%d Handle:%x offset:%d len:%d\n",
-                conn_id, p_read_req->handle, p_read_req->offset, attr_len_to_copy);
+    from = puAttribute->p_data;
+
+    /* Report the CCCD values and telemetry of the requesting client rather
+     * than the last ones written by any client */
+    if ((HDLD_THROUGHPUT_MEASUREMENT_NOTIFY_CLIENT_CHAR_CONFIG == p_read_req->handle) && (NULL != p_conn))
+    {
+        cccd[0] = (uint8_t)(p_conn->cccd & 0xFF);
+        cccd[1] = FROM_BIT16_TO_8(p_conn->cccd);
+        attr_len_to_copy = sizeof(cccd);
+        from = cccd;
+    }
+    else if ((HDLD_THROUGHPUT_MEASUREMENT_TELEMETRY_CLIENT_CHAR_CONFIG == p_read_req->handle) && (NULL != p_conn))
+    {
+        cccd[0] = (uint8_t)(p_conn->telemetry.cccd & 0xFF);
+        cccd[1] = FROM_BIT16_TO_8(p_conn->telemetry.cccd);
+        attr_len_to_copy = sizeof(cccd);
+        from = cccd;
+    }
+    else if ((HDLD_THROUGHPUT_MEASUREMENT_PING_CLIENT_CHAR_CONFIG == p_read_req->handle) && (NULL != p_conn))
+    {
+        cccd[0] = (uint8_t)(p_conn->ping.cccd & 0xFF);
+        cccd[1] = FROM_BIT16_TO_8(p_conn->ping.cccd);
+        attr_len_to_copy = sizeof(cccd);
+        from = cccd;
+    }
+    else if ((HDLC_THROUGHPUT_MEASUREMENT_TELEMETRY_VALUE == p_read_req->handle) && (NULL != p_conn))
+    {
+        attr_len_to_copy = sizeof(app_tput_telemetry_record_t);
+        from = (uint8_t *)&p_conn->telemetry.record;
+    }
 
-    if (p_read_req->offset >= puAttribute->cur_len)
+    if (p_read_req->offset >= attr_len_to_copy)
     {
         wiced_bt_gatt_server_send_error_rsp(conn_id, opcode, p_read_req->handle, WICED_BT_GATT_INVALID_OFFSET);
         return WICED_BT_GATT_INVALID_OFFSET;
     }
 
     to_send = MIN(len_requested, attr_len_to_copy - p_read_req->offset);
-    from = puAttribute->p_data + p_read_req->offset;
+    from += p_read_req->offset;
     return wiced_bt_gatt_server_send_read_handle_rsp(conn_id, opcode, to_send, from, NULL); /* No need for context, as buff not allocated */
 }
 
@@ -1095,7 +1909,9 @@ static wiced_bt_gatt_status_t app_bt_gatt_req_read_handler(uint16_t conn_id,
  * app_bt_gatt_req_read_by_type_handler
  *
  * Function Description:
- * @brief  Process read-by-type request from peer device
+ * @brief  Process read-by-type request from peer device. Responses are built
+ *         once into the read-by-type cache and sent from there by every
+ *         following identical request until a value in their range changes.
  *
  * @param conn_id       Connection ID
  * @param opcode        LE GATT request type opcode
@@ -1110,15 +1926,37 @@ static wiced_bt_gatt_status_t app_bt_gatt_req_read_by_type_handler(uint16_t conn
                                                                    uint16_t len_requested)
 {
     gatt_db_lookup_table_t *puAttribute;
+    app_bt_read_cache_entry_t *p_entry;
     uint16_t last_handle = 0;
     uint16_t attr_handle = p_read_req->s_handle;
-    uint8_t *p_rsp = app_bt_alloc_buffer(len_requested);
+    uint8_t *p_rsp;
     uint8_t pair_len = 0;
     int used_len = 0;
+    wiced_bt_gatt_status_t status;
+
+    p_entry = app_bt_read_cache_lookup(p_read_req, len_requested);
+    if (NULL != p_entry)
+    {
+        if (WICED_BT_GATT_SUCCESS != p_entry->status)
+        {
+            return p_entry->status;
+        }
+        status = wiced_bt_gatt_server_send_read_by_type_rsp(conn_id, opcode, p_entry->pair_len, p_entry->len,
+                                                            (uint8_t *)p_entry->data,
+                                                            (void *)app_bt_read_cache_release);
+        if (WICED_BT_GATT_SUCCESS != status)
+        {
+            app_bt_read_cache_release((uint8_t *)p_entry->data);
+        }
+        return status;
+    }
 
+    /* Build into a cache slot, or into a pool buffer when every slot is busy */
+    p_entry = app_bt_read_cache_claim(p_read_req, len_requested);
+    p_rsp = (NULL != p_entry) ? (uint8_t *)p_entry->data : app_bt_alloc_buffer(len_requested);
     if (NULL == p_rsp)
     {
-        printf("No memory, len_requested: %d!!\r\n",len_requested);
+        app_log_write(APP_LOG_READ_BY_TYPE_NO_MEM, len_requested, 0, 0);
         return WICED_BT_GATT_INSUF_RESOURCE;
     }
 
@@ -1131,10 +1969,13 @@ static wiced_bt_gatt_status_t app_bt_gatt_req_read_by_type_handler(uint16_t conn
         if (0 == attr_handle )
             break;
 
-        if ( NULL == (puAttribute = app_bt_find_by_handle(attr_handle)))
+        if ( NULL == (puAttribute = app_bt_attr_find(attr_handle)))
         {
-            printf("found type but no attribute for %d \r\n",last_handle);
-            app_bt_free_buffer(p_rsp);
+            app_log_write(APP_LOG_READ_BY_TYPE_NO_ATTR, last_handle, 0, 0);
+            if (NULL == p_entry)
+            {
+                app_bt_free_buffer(p_rsp);
+            }
             return WICED_BT_GATT_INVALID_HANDLE;
         }
 
@@ -1154,15 +1995,34 @@ static wiced_bt_gatt_status_t app_bt_gatt_req_read_by_type_handler(uint16_t conn
 
     if (0 == used_len)
     {
-       printf("attr not found  start_handle: 0x%04x  end_handle: 0x%04x  Type: 0x%04x\r\n",
-               p_read_req->s_handle, p_read_req->e_handle, p_read_req->uuid.uu.uuid16);
-        app_bt_free_buffer(p_rsp);
+        app_log_write(APP_LOG_READ_BY_TYPE_NOT_FOUND, p_read_req->s_handle, p_read_req->e_handle,
+                      p_read_req->uuid.uu.uuid16);
+        if (NULL != p_entry)
+        {
+            /* Discovery ends on this error, keep it for the next client too */
+            app_bt_read_cache_commit(p_entry, WICED_BT_GATT_INVALID_HANDLE, 0, 0);
+        }
+        else
+        {
+            app_bt_free_buffer(p_rsp);
+        }
         return WICED_BT_GATT_INVALID_HANDLE;
     }
 
     /* Send the response */
+    if (NULL == p_entry)
+    {
+        return wiced_bt_gatt_server_send_read_by_type_rsp(conn_id, opcode, pair_len, used_len, p_rsp, (void *)app_bt_free_buffer);
+    }
 
-    return wiced_bt_gatt_server_send_read_by_type_rsp(conn_id, opcode, pair_len, used_len, p_rsp, (void *)app_bt_free_buffer);
+    app_bt_read_cache_commit(p_entry, WICED_BT_GATT_SUCCESS, pair_len, (uint16_t)used_len);
+    status = wiced_bt_gatt_server_send_read_by_type_rsp(conn_id, opcode, pair_len, used_len, p_rsp,
+                                                        (void *)app_bt_read_cache_release);
+    if (WICED_BT_GATT_SUCCESS != status)
+    {
+        app_bt_read_cache_release(p_rsp);
+    }
+    return status;
 }
 
 /* [] END OF FILE */